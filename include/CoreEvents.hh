@@ -7,6 +7,8 @@
 #define EVENT_SYSTEM_CORE_EVENTS_HH
 
 // C++ Standard Library
+#include <array>
+#include <cstdint>
 #include <string_view>
 
 // Third-Party Libraries
@@ -20,7 +22,7 @@ namespace Mikoto {
     class WindowResizedEvent : public Event {
     public:
         WindowResizedEvent(Int32_T newWidth, Int32_T newHeight)
-            :   Event{ GetStaticType(), GetCategoryFromType(GetStaticType()) }
+            :   Event{ GetStaticType() }
             ,   m_Width{ newWidth }
             ,   m_Height{ newHeight }
         {
@@ -47,7 +49,7 @@ namespace Mikoto {
     class WindowCloseEvent: public Event {
     public:
         explicit WindowCloseEvent()
-            :   Event{ GetStaticType(), GetCategoryFromType(GetStaticType()) }
+            :   Event{ GetStaticType() }
         {
 
         }
@@ -67,7 +69,7 @@ namespace Mikoto {
     class AppTick : public Event {
     public:
         explicit AppTick()
-            :   Event{ GetStaticType(), GetCategoryFromType(GetStaticType()) }
+            :   Event{ GetStaticType() }
         {
 
         }
@@ -87,7 +89,7 @@ namespace Mikoto {
     class AppUpdate : public Event {
     public:
         explicit AppUpdate()
-            :   Event{ GetStaticType(), GetCategoryFromType(GetStaticType()) }
+            :   Event{ GetStaticType() }
         {
 
         }
@@ -107,7 +109,7 @@ namespace Mikoto {
     class AppRender: public Event {
     public:
         explicit AppRender()
-            :   Event{ GetStaticType(), GetCategoryFromType(GetStaticType()) }
+            :   Event{ GetStaticType() }
         {
 
         }
@@ -131,7 +133,7 @@ namespace Mikoto {
 
     protected:
         KeyEvent(EventType type, Int32_T keyCode)
-            :   Event{ type, GetCategoryFromType(type) }
+            :   Event{ type }
             ,   m_KeyCode{ keyCode }
         {
 
@@ -144,26 +146,27 @@ namespace Mikoto {
     public:
         KeyPressedEvent(Int32_T keyCode, bool repeated, Int32_T modifiers = 0)
             :   KeyEvent{ GetStaticType(), keyCode }
-            ,   m_Repeated{ repeated }
             ,   m_Modifiers{ modifiers }
         {
-
+            SetFlag(REPEATED_FLAG, repeated);
         }
 
-        MKT_NODISCARD auto IsRepeated() const -> bool { return m_Repeated; }
-        MKT_NODISCARD auto GetModifiers() const -> bool { return m_Modifiers; }
+        MKT_NODISCARD auto IsRepeated() const -> bool { return GetFlag(REPEATED_FLAG); }
+        MKT_NODISCARD auto GetModifiers() const -> Int32_T { return m_Modifiers; }
         MKT_NODISCARD auto GetType() const -> EventType override { return GetStaticType(); }
 
         MKT_NODISCARD static auto GetStaticType() -> EventType { return EventType::KEY_PRESSED_EVENT; }
 
         MKT_NODISCARD auto DisplayData() const -> std::string override {
-            return fmt::format("{}! Key {}. Repeated? {}", GetEventFormattedStr(GetType()).data(), m_KeyCode, m_Repeated ? "Yes" : "No");
+            return fmt::format("{}! Key {}. Repeated? {}", GetEventFormattedStr(GetType()).data(), m_KeyCode, IsRepeated() ? "Yes" : "No");
         }
 
     private:
         MKT_NODISCARD auto ToString() const -> std::string_view override { return GetEventFormattedStr(GetType()); }
 
-        bool m_Repeated{};
+        // Kept in the event header flags instead of its own member
+        static constexpr UInt8_T REPEATED_FLAG{ USER_FLAG_0 };
+
         Int32_T m_Modifiers{};
     };
 
@@ -189,7 +192,7 @@ namespace Mikoto {
     class KeyCharEvent : public Event {
     public:
         explicit KeyCharEvent(UInt32_T charCode)
-            :   Event{ GetStaticType(), GetCategoryFromType(GetStaticType()) }
+            :   Event{ GetStaticType() }
             ,   m_KeyChar{ charCode }
         {
 
@@ -212,7 +215,7 @@ namespace Mikoto {
     class MouseMovedEvent : public Event {
     public:
         MouseMovedEvent(double x, double y)
-            :   Event{ GetStaticType(), GetCategoryFromType(GetStaticType()) }
+            :   Event{ GetStaticType() }
             ,   m_PositionX{ x }
             ,   m_PositionY{ y }
         {
@@ -238,14 +241,23 @@ namespace Mikoto {
 
     class MouseEvent : public Event {
     protected:
-        MouseEvent(EventType type, EventCategory categories)
-            :   Event{ type, GetCategoryFromType(type) } {}
+        explicit MouseEvent(EventType type)
+            :   Event{ type } {}
+
+        /**
+         * Returns the name of a mouse button. GLFW reports up to eight buttons,
+         * the ones past the usual three are named by their number
+         * */
+        MKT_NODISCARD static auto GetButtonName(Int32_T button) -> std::string {
+            constexpr static std::array<std::string_view, 3> NAME{ "LEFT_CLICK", "RIGHT_CLICK", "SCROLL_WHEEL_CLICK" };
+            return button >= 0 && static_cast<Size_T>(button) < NAME.size() ? std::string{ NAME[button] } : fmt::format("BUTTON_{}", button);
+        }
     };
 
     class MouseButtonPressedEvent : public MouseEvent {
     public:
         explicit MouseButtonPressedEvent(Int32_T button, Int32_T modifiers = 0)
-            :   MouseEvent{ GetStaticType(), GetCategoryFromType(GetStaticType()) }
+            :   MouseEvent{ GetStaticType() }
             ,   m_Button{ button }
             ,   m_Modifiers{ modifiers }
         {
@@ -259,9 +271,7 @@ namespace Mikoto {
         MKT_NODISCARD static auto GetStaticType() -> EventType { return EventType::MOUSE_BUTTON_PRESSED_EVENT; }
 
         MKT_NODISCARD auto DisplayData() const -> std::string override {
-            constexpr static std::array<std::string_view, 3> NAME{ "LEFT_CLICK", "RIGHT_CLICK", "SCROLL_WHEEL_CLICK" };
-            // we are just testing with a mouse with three buttons for now
-            return fmt::format("{}! Button {}", GetEventFormattedStr(GetType()).data(), NAME[m_Button]);
+            return fmt::format("{}! Button {}", GetEventFormattedStr(GetType()).data(), GetButtonName(m_Button));
         }
     protected:
         MKT_NODISCARD auto ToString() const -> std::string_view override { return GetEventFormattedStr(GetType()); }
@@ -273,7 +283,7 @@ namespace Mikoto {
     class MouseButtonReleasedEvent : public MouseEvent {
     public:
         explicit MouseButtonReleasedEvent(Int32_T button)
-            :   MouseEvent{ GetStaticType(), GetCategoryFromType(GetStaticType()) }
+            :   MouseEvent{ GetStaticType() }
             ,   m_Button{ button }
         {
 
@@ -284,8 +294,7 @@ namespace Mikoto {
 
         MKT_NODISCARD static auto GetStaticType() -> EventType { return EventType::MOUSE_BUTTON_RELEASED_EVENT; }
         MKT_NODISCARD auto DisplayData() const -> std::string override {
-            constexpr static std::array<std::string_view, 3> NAME{ "LEFT_CLICK", "RIGHT_CLICK", "SCROLL_WHEEL_CLICK" };
-            return fmt::format("{}! Button {}", GetEventFormattedStr(GetType()).data(), NAME[m_Button]);
+            return fmt::format("{}! Button {}", GetEventFormattedStr(GetType()).data(), GetButtonName(m_Button));
         }
 
     protected:
@@ -297,7 +306,7 @@ namespace Mikoto {
     class MouseScrollEvent : public MouseEvent {
     public:
         MouseScrollEvent(double xOffset, double yOffset)
-            :   MouseEvent{ GetStaticType(), GetCategoryFromType(GetStaticType()) }
+            :   MouseEvent{ GetStaticType() }
             ,   m_OffsetX{ xOffset }
             ,   m_OffsetY{ yOffset }
         {}
@@ -318,6 +327,42 @@ namespace Mikoto {
         double m_OffsetX{};
         double m_OffsetY{};
     };
+
+    /**
+     * Payload size of every event type, in bytes, indexed by type.
+     * This is the size of the event class minus the common Event header
+     * */
+    inline constexpr std::array<Size_T, static_cast<Size_T>(EventType::EVENT_TYPE_COUNT)> EVENT_PAYLOAD_SIZE_TABLE{
+        #define MKT_EVENT_PAYLOAD_SIZE_TABLE_ENTRY(TYPE, CATEGORIES, CLASS) sizeof(CLASS) - sizeof(Event),
+        MKT_CORE_EVENT_LIST(MKT_EVENT_PAYLOAD_SIZE_TABLE_ENTRY)
+        #undef MKT_EVENT_PAYLOAD_SIZE_TABLE_ENTRY
+    };
+
+    /**
+     * Returns the payload size of the given event type
+     * @returns payload size in bytes
+     * */
+    MKT_NODISCARD constexpr auto GetPayloadSizeFromType(EventType type) -> Size_T {
+        return static_cast<Size_T>(type) < EVENT_PAYLOAD_SIZE_TABLE.size() ? EVENT_PAYLOAD_SIZE_TABLE[static_cast<Size_T>(type)] : 0;
+    }
+
+#if UINTPTR_MAX == UINT64_MAX
+    // Sizes on 64 bit targets. The header is 16 bytes (vtable pointer, type, flags, time stamp),
+    // if any of these grows the events no longer pack two or more per cache line
+    static_assert(sizeof(Event) == 16, "Event header must stay compact");
+    static_assert(sizeof(WindowResizedEvent) == 24);
+    static_assert(sizeof(WindowCloseEvent) == 16);
+    static_assert(sizeof(AppTick) == 16);
+    static_assert(sizeof(AppUpdate) == 16);
+    static_assert(sizeof(AppRender) == 16);
+    static_assert(sizeof(KeyPressedEvent) == 24);
+    static_assert(sizeof(KeyReleasedEvent) == 24);
+    static_assert(sizeof(KeyCharEvent) == 24);
+    static_assert(sizeof(MouseMovedEvent) == 32);
+    static_assert(sizeof(MouseButtonPressedEvent) == 24);
+    static_assert(sizeof(MouseButtonReleasedEvent) == 24);
+    static_assert(sizeof(MouseScrollEvent) == 32);
+#endif
 }
 
 #endif // EVENT_SYSTEM_CORE_EVENTS_HH
@@ -7,6 +7,9 @@
 #define EVENT_SYSTEM_EVENT_HH
 
 // C++ Standard Library
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <string_view>
 #include <type_traits>
@@ -17,43 +20,6 @@
 #include <Common.hh>
 
 namespace Mikoto {
-    /**
-     * Simply specifies the type of an Event
-     * */
-    enum class EventType {
-        EMPTY_EVENT,
-
-        // Window events.
-        // Category [WINDOW_EVENT_CATEGORY]
-        WINDOW_RESIZE_EVENT,
-        WINDOW_CLOSE_EVENT,
-        WINDOW_MOVED_EVENT,
-
-        // Application events.
-        // Category [APPLICATION_EVENT_CATEGORY]
-        APP_RENDER_EVENT,
-        APP_UPDATE_EVENT,
-        APP_TICK_EVENT,
-
-        // Key Events.
-        // Category [KEYBOARD_EVENT_CATEGORY]
-        KEY_PRESSED_EVENT,
-        KEY_RELEASED_EVENT,
-        KEY_CHAR_EVENT,
-
-        // Mouse button events.
-        // Category [MOUSE_EVENT_CATEGORY]
-        MOUSE_BUTTON_PRESSED_EVENT,
-        MOUSE_BUTTON_RELEASED_EVENT,
-
-        // Mouse events.
-        // Category [MOUSE_BUTTON_EVENT_CATEGORY]
-        MOUSE_MOVED_EVENT,
-        MOUSE_SCROLLED_EVENT,
-
-        EVENT_TYPE_COUNT,
-    };
-
     /**
      * Specifies the group of an event. This is defined
      * if and event handler may need to filter certain events,
@@ -76,40 +42,230 @@ namespace Mikoto {
         EVENT_CATEGORY_COUNT            =  BIT_SET(7),
     };
 
+    /**
+     * Registry of the core event types. Every piece of per type metadata (the EventType
+     * enum, the category, name and payload size tables) is generated from this list,
+     * so adding an event type is a matter of adding one line here.
+     * Each entry is X(TYPE, CATEGORIES, CLASS), CLASS being the event class implementing
+     * the type or Event for types without one yet. Order defines the type values.
+     * */
+    #define MKT_CORE_EVENT_LIST(X)                                                                                             \
+        X(EMPTY_EVENT,                  EMPTY_EVENT_CATEGORY,                                                   Event)                      \
+        /* Window events */                                                                                                \
+        X(WINDOW_RESIZE_EVENT,          WINDOW_EVENT_CATEGORY,                                                  WindowResizedEvent)         \
+        X(WINDOW_CLOSE_EVENT,           WINDOW_EVENT_CATEGORY,                                                  WindowCloseEvent)           \
+        X(WINDOW_MOVED_EVENT,           WINDOW_EVENT_CATEGORY,                                                  Event)                      \
+        /* Application events */                                                                                           \
+        X(APP_RENDER_EVENT,             APP_EVENT_CATEGORY,                                                     AppRender)                  \
+        X(APP_UPDATE_EVENT,             APP_EVENT_CATEGORY,                                                     AppUpdate)                  \
+        X(APP_TICK_EVENT,               APP_EVENT_CATEGORY,                                                     AppTick)                    \
+        /* Key events */                                                                                                   \
+        X(KEY_PRESSED_EVENT,            KEY_EVENT_CATEGORY | INPUT_EVENT_CATEGORY,                              KeyPressedEvent)            \
+        X(KEY_RELEASED_EVENT,           KEY_EVENT_CATEGORY | INPUT_EVENT_CATEGORY,                              KeyReleasedEvent)           \
+        X(KEY_CHAR_EVENT,               KEY_EVENT_CATEGORY | INPUT_EVENT_CATEGORY,                              KeyCharEvent)               \
+        /* Mouse button events */                                                                                          \
+        X(MOUSE_BUTTON_PRESSED_EVENT,   INPUT_EVENT_CATEGORY | MOUSE_EVENT_CATEGORY | MOUSE_BUTTON_EVENT_CATEGORY, MouseButtonPressedEvent)  \
+        X(MOUSE_BUTTON_RELEASED_EVENT,  INPUT_EVENT_CATEGORY | MOUSE_EVENT_CATEGORY | MOUSE_BUTTON_EVENT_CATEGORY, MouseButtonReleasedEvent) \
+        /* Mouse events */                                                                                                 \
+        X(MOUSE_MOVED_EVENT,            INPUT_EVENT_CATEGORY | MOUSE_BUTTON_EVENT_CATEGORY,                     MouseMovedEvent)            \
+        X(MOUSE_SCROLLED_EVENT,         INPUT_EVENT_CATEGORY | MOUSE_BUTTON_EVENT_CATEGORY,                     MouseScrollEvent)
+
+    /**
+     * Simply specifies the type of an Event. Stored in a single byte
+     * so it fits the compact event header
+     * */
+    enum class EventType : UInt8_T {
+        #define MKT_EVENT_TYPE_ENUM_ENTRY(TYPE, CATEGORIES, CLASS) TYPE,
+        MKT_CORE_EVENT_LIST(MKT_EVENT_TYPE_ENUM_ENTRY)
+        #undef MKT_EVENT_TYPE_ENUM_ENTRY
+
+        EVENT_TYPE_COUNT,
+    };
+
+    /**
+     * Categories of every event type, indexed by type
+     * */
+    inline constexpr std::array<EventCategory, static_cast<Size_T>(EventType::EVENT_TYPE_COUNT)> EVENT_CATEGORY_TABLE{
+        #define MKT_EVENT_CATEGORY_TABLE_ENTRY(TYPE, CATEGORIES, CLASS) EventCategory(CATEGORIES),
+        MKT_CORE_EVENT_LIST(MKT_EVENT_CATEGORY_TABLE_ENTRY)
+        #undef MKT_EVENT_CATEGORY_TABLE_ENTRY
+    };
+
+    /**
+     * String representation of every event type, indexed by type
+     * */
+    inline constexpr std::array<std::string_view, static_cast<Size_T>(EventType::EVENT_TYPE_COUNT)> EVENT_NAME_TABLE{
+        #define MKT_EVENT_NAME_TABLE_ENTRY(TYPE, CATEGORIES, CLASS) #TYPE,
+        MKT_CORE_EVENT_LIST(MKT_EVENT_NAME_TABLE_ENTRY)
+        #undef MKT_EVENT_NAME_TABLE_ENTRY
+    };
+
+    /**
+     * Upper bound for the number of event types, core and registered at
+     * runtime together. Bound by the one byte type tag of the event header
+     * */
+    inline constexpr Size_T MAX_EVENT_TYPE_COUNT{ 256 };
+
+    /**
+     * Per type metadata used at runtime, indexed by type. The first EVENT_TYPE_COUNT entries
+     * come from the core registry, the following ones are handed out by RegisterEventType().
+     * Core and custom types are looked up the same way, a single indexed load
+     * */
+    struct EventTypeTable {
+        std::array<EventCategory, MAX_EVENT_TYPE_COUNT> Categories{};
+        std::array<std::string_view, MAX_EVENT_TYPE_COUNT> Names{};
+        Size_T Count{};
+    };
+
+    MKT_NODISCARD constexpr auto MakeCoreEventTypeTable() -> EventTypeTable {
+        EventTypeTable result{};
+
+        result.Categories.fill(EMPTY_EVENT_CATEGORY);
+        result.Names.fill("UNREGISTERED_EVENT");
+
+        for (Size_T index{}; index < static_cast<Size_T>(EventType::EVENT_TYPE_COUNT); ++index) {
+            result.Categories[index] = EVENT_CATEGORY_TABLE[index];
+            result.Names[index] = EVENT_NAME_TABLE[index];
+        }
+
+        result.Count = static_cast<Size_T>(EventType::EVENT_TYPE_COUNT);
+        return result;
+    }
+
+    /**
+     * Runtime event type table. Constant initialized, so it is ready before any
+     * static constructor runs. Only RegisterEventType() should modify it, lookups
+     * are not synchronized and rely on the table being frozen once events flow, see FreezeEventTypes()
+     * */
+    inline constinit EventTypeTable s_EventTypeTable{ MakeCoreEventTypeTable() };
+
+    /**
+     * Returns the categories of the given event type. Lookup into a table,
+     * events no longer store their categories
+     * @returns categories of the event type
+     * */
     MKT_NODISCARD inline auto GetCategoryFromType(EventType type) -> EventCategory {
-        switch (type) {
-            case EventType::EMPTY_EVENT: return EventCategory::EMPTY_EVENT_CATEGORY;
+        return s_EventTypeTable.Categories[static_cast<Size_T>(type)];
+    }
 
-            case EventType::WINDOW_RESIZE_EVENT:
-            case EventType::WINDOW_CLOSE_EVENT:
-            case EventType::WINDOW_MOVED_EVENT: return EventCategory(WINDOW_EVENT_CATEGORY);
+    /**
+     * Returns the number of event types currently known, core types included.
+     * Valid type values are in the range [0, GetEventTypeCount())
+     * @returns number of event types
+     * */
+    MKT_NODISCARD inline auto GetEventTypeCount() -> Size_T {
+        return s_EventTypeTable.Count;
+    }
 
-            case EventType::APP_RENDER_EVENT:
-            case EventType::APP_UPDATE_EVENT:
-            case EventType::APP_TICK_EVENT: return EventCategory::APP_EVENT_CATEGORY;
+    /**
+     * Hands out a new event type for events defined outside of the core registry
+     * (game specific events, network packets...). Types are dense and follow
+     * the core ones, so they index the same dispatch tables. Registration is startup only,
+     * it must happen before any event is triggered or processed.
+     * Throws if all MAX_EVENT_TYPE_COUNT types are in use or if the table is frozen.
+     * @param name name of the event type, returned by GetEventFormattedStr()
+     * @param categories categories of the events of this type
+     * @returns the new event type
+     * */
+    auto RegisterEventType(std::string_view name, EventCategory categories) -> EventType;
 
-            case EventType::KEY_PRESSED_EVENT:
-            case EventType::KEY_RELEASED_EVENT:
-            case EventType::KEY_CHAR_EVENT: return EventCategory(KEY_EVENT_CATEGORY | INPUT_EVENT_CATEGORY);
+    /**
+     * Closes event type registration, RegisterEventType() throws from then on. Called
+     * by the first ProcessEvents() of any bus, past that point the type table is only read
+     * */
+    auto FreezeEventTypes() -> void;
 
-            case EventType::MOUSE_BUTTON_PRESSED_EVENT:
-            case EventType::MOUSE_BUTTON_RELEASED_EVENT: return EventCategory(INPUT_EVENT_CATEGORY | MOUSE_EVENT_CATEGORY | MOUSE_BUTTON_EVENT_CATEGORY);
+    /**
+     * Hands out a category flag that is not used by any core category, to be
+     * used with RegisterEventType(). Throws if all 32 bits are in use.
+     * @returns the new category flag
+     * */
+    auto RegisterEventCategory() -> EventCategory;
 
-            case EventType::MOUSE_MOVED_EVENT:
-            case EventType::MOUSE_SCROLLED_EVENT: return EventCategory(INPUT_EVENT_CATEGORY | MOUSE_BUTTON_EVENT_CATEGORY);
+    /**
+     * Returns the instant event time stamps are measured from,
+     * fixed the first time an event time stamp is requested
+     * @returns event clock epoch
+     * */
+    MKT_NODISCARD inline auto GetEventClockEpoch() -> std::chrono::steady_clock::time_point {
+        static const auto epoch{ std::chrono::steady_clock::now() };
+        return epoch;
+    }
+
+    /**
+     * Clock the event clock follows instead of real time while Enabled is set. It only
+     * moves when Now is changed, which makes time stamps and timeouts reproducible, see ReplaySession.
+     * Every event constructor reads it, on whatever thread the event is made, so both fields are
+     * atomics. Relaxed accesses are enough: an event made on another thread while the clock changes
+     * gets either time, nothing else is ordered by it
+     * */
+    struct VirtualEventClock {
+        std::atomic<bool> Enabled{};
 
-            default: return EventCategory::EMPTY_EVENT_CATEGORY;
+        // Microseconds since GetEventClockEpoch()
+        std::atomic<UInt64_T> Now{};
+    };
+
+    /**
+     * Returns the virtual event clock, disabled by default
+     * @returns virtual event clock
+     * */
+    MKT_NODISCARD inline auto GetVirtualEventClock() -> VirtualEventClock& {
+        static VirtualEventClock clock{};
+        return clock;
+    }
+
+    /**
+     * Returns the current time of the event clock, real or virtual
+     * @returns current event clock time
+     * */
+    MKT_NODISCARD inline auto GetEventClockNow() -> std::chrono::steady_clock::time_point {
+        if (const auto& clock{ GetVirtualEventClock() }; clock.Enabled.load(std::memory_order_relaxed)) {
+            return GetEventClockEpoch() + std::chrono::microseconds{ clock.Now.load(std::memory_order_relaxed) };
         }
+
+        return std::chrono::steady_clock::now();
+    }
+
+    /**
+     * Returns the time used to stamp events, in microseconds since GetEventClockEpoch().
+     * The value is 32 bits wide and wraps around every ~71 minutes, differences between
+     * two stamps taken less than that apart are still exact using unsigned arithmetic
+     * @returns current event time
+     * */
+    MKT_NODISCARD inline auto GetEventTimeStamp() -> UInt32_T {
+        const auto epoch{ GetEventClockEpoch() };
+        return static_cast<UInt32_T>(std::chrono::duration_cast<std::chrono::microseconds>(GetEventClockNow() - epoch).count());
     }
 
+    /**
+     * Identifies the window an event comes from, see Window::GetId(). Events
+     * not coming from a window, and subscriptions for every window, use ANY_WINDOW_ID
+     * */
+    using WindowId_T = UInt16_T;
+
+    inline constexpr WindowId_T ANY_WINDOW_ID{ 0 };
 
+    /**
+     * Maximum number of windows alive at the same time. Ids go from 1 to MAX_WINDOW_COUNT
+     * and are reused once their window is destroyed
+     * */
+    inline constexpr Size_T MAX_WINDOW_COUNT{ 16 };
+
+    /**
+     * Base class for all events. The header is kept compact: besides the vtable
+     * pointer it only holds a one byte type tag, a byte of flags, the 16 bit id of
+     * the window it comes from and a 32 bit time stamp, 16 bytes on 64 bit targets. Categories are not stored,
+     * they are looked up from the type, see GetCategoryFromType()
+     * */
     class Event {
     public:
         /**
-         * Creates a new event. The event is not handled on creation.
+         * Creates a new event. The event is not handled on creation
+         * and is stamped with the time it was created at.
          * */
-        Event(EventType type, EventCategory categories)
-            :   m_Type{ type }, m_Categories{ categories }, m_Handled{ false } {}
+        explicit Event(EventType type)
+            :   m_Type{ type }, m_Flags{}, m_WindowId{ ANY_WINDOW_ID }, m_TimeStamp{ GetEventTimeStamp() } {}
 
 
         Event(const Event& other) = default;
@@ -119,7 +275,7 @@ namespace Mikoto {
          * this event in scenarios where polymorphism is used
          * */
         MKT_NODISCARD virtual auto GetType() const -> EventType = 0;
-        MKT_NODISCARD virtual auto GetCategoryFlags() const -> EventCategory { return m_Categories; };
+        MKT_NODISCARD auto GetCategoryFlags() const -> EventCategory { return GetCategoryFromType(m_Type); };
 
         /**
          * Returns the string representation of this Event.
@@ -131,16 +287,41 @@ namespace Mikoto {
          * Tells whether this event has been handled or not
          * @returns true if the event has been handled, false otherwise
          * */
-        MKT_NODISCARD auto IsHandled() const -> bool { return m_Handled; }
+        MKT_NODISCARD auto IsHandled() const -> bool { return GetFlag(HANDLED_FLAG); }
         MKT_NODISCARD auto IsInCategory(EventCategory cat) const -> bool { return GetCategoryFlags() & cat; }
 
+        /**
+         * Returns the time this event was created at, see GetEventTimeStamp()
+         * @returns creation time of this event
+         * */
+        MKT_NODISCARD auto GetTimeStamp() const -> UInt32_T { return m_TimeStamp; }
+
+        /**
+         * Returns the window this event comes from
+         * @returns id of the window, ANY_WINDOW_ID if it does not come from one
+         * */
+        MKT_NODISCARD auto GetWindowId() const -> WindowId_T { return m_WindowId; }
+
         /**
          * Returns a formatted string representing the data, if any,
          * that this event holds. Used for debugging purposes
          * */
         MKT_NODISCARD virtual auto DisplayData() const -> std::string = 0;
 
-        auto SetHandled(bool value) -> void { m_Handled = value; }
+        auto SetHandled(bool value) -> void { SetFlag(HANDLED_FLAG, value); }
+
+        /**
+         * Overrides the creation time, for events rebuilt from a recording or another process
+         * @param timeStamp time stamp, see GetEventTimeStamp()
+         * */
+        auto SetTimeStamp(UInt32_T timeStamp) -> void { m_TimeStamp = timeStamp; }
+
+        /**
+         * Sets the window this event comes from, only dispatched to the handlers of every
+         * window and the ones bound to that window
+         * @param windowId id of the window
+         * */
+        auto SetWindowId(WindowId_T windowId) -> void { m_WindowId = windowId; }
 
         virtual ~Event() = default;
     private:
@@ -149,9 +330,19 @@ namespace Mikoto {
          * */
         friend class EventDispatcher;
 
-        EventType m_Type;
-        EventCategory m_Categories;
     protected:
+        /**
+         * Bits of the flags byte. Bit 0 tells whether the event has been handled,
+         * the rest is free for the specializations of this interface to store
+         * small payload (e.g. booleans) without growing the event
+         * */
+        static constexpr UInt8_T HANDLED_FLAG{ BIT_SET(0) };
+        static constexpr UInt8_T USER_FLAG_0{ BIT_SET(1) };
+        static constexpr UInt8_T USER_FLAG_1{ BIT_SET(2) };
+
+        MKT_NODISCARD auto GetFlag(UInt8_T flag) const -> bool { return (m_Flags & flag) != 0; }
+        auto SetFlag(UInt8_T flag, bool value) -> void { m_Flags = value ? (m_Flags | flag) : (m_Flags & ~flag); }
+
         /**
          * This function should not be called directly by the user.
          * It is to be defined by the type of event that specializes this
@@ -159,58 +350,64 @@ namespace Mikoto {
          * */
         MKT_NODISCARD virtual auto ToString() const -> std::string_view = 0;
 
-        /**
-         * In case we want to avoid propagating an Event we mark it as handled.
-         * It is under protected because we want the specializations of this
-         * interface to be able to directly access it, otherwise we may need
-         * a sort of public interface to control this member.
-         *
-         * If this event has been handled this variables holds true,
-         * false if this Event has not been handled yet
-         * */
-         bool m_Handled{};
+    private:
+        EventType m_Type;
+        UInt8_T m_Flags;
+        WindowId_T m_WindowId;
+        UInt32_T m_TimeStamp;
     };
 
     /**
      * Returns the exact string representation of the given EventType enum
      * @returns EventType string representation
      * */
-    MKT_NODISCARD constexpr auto GetEventFormattedStr(EventType type) -> std::string_view {
-        switch(type) {
-            case EventType::EMPTY_EVENT: return "EMPTY_EVENT";
-
-            // Window events.
-            // Category [WINDOW_EVENT_CATEGORY]
-            case EventType::WINDOW_RESIZE_EVENT: return "WINDOW_RESIZE_EVENT";
-            case EventType::WINDOW_CLOSE_EVENT: return "WINDOW_CLOSE_EVENT";
-            case EventType::WINDOW_MOVED_EVENT: return "WINDOW_MOVED_EVENT";
-
-            // Application events.
-            // Category [APPLICATION_EVENT_CATEGORY]
-            case EventType::APP_RENDER_EVENT: return "APP_RENDER_EVENT";
-            case EventType::APP_UPDATE_EVENT: return "APP_UPDATE_EVENT";
-            case EventType::APP_TICK_EVENT: return "APP_TICK_EVENT";
-
-            // Key Events.
-            // Category [KEY_EVENT_CATEGORY]
-            case EventType::KEY_PRESSED_EVENT: return "KEY_PRESSED_EVENT";
-            case EventType::KEY_RELEASED_EVENT: return "KEY_RELEASED_EVENT";
-            case EventType::KEY_CHAR_EVENT: return "KEY_CHAR_EVENT";
-
-            // Mouse button events.
-            // Category [MOUSE_EVENT_CATEGORY]
-            case EventType::MOUSE_BUTTON_PRESSED_EVENT: return "MOUSE_BUTTON_PRESSED_EVENT";
-            case EventType::MOUSE_BUTTON_RELEASED_EVENT: return "MOUSE_BUTTON_RELEASED_EVENT";
-
-            // Mouse events.
-            // Category [MOUSE_BUTTON_EVENT_CATEGORY]
-            case EventType::MOUSE_MOVED_EVENT: return "MOUSE_MOVED_EVENT";
-            case EventType::MOUSE_SCROLLED_EVENT: return "MOUSE_SCROLLED_EVENT";
-
-            default: return "EVENT_TYPE_COUNT";
-        }
+    MKT_NODISCARD inline auto GetEventFormattedStr(EventType type) -> std::string_view {
+        return s_EventTypeTable.Names[static_cast<Size_T>(type)];
     }
 
+    /**
+     * Convenience base for event types registered at runtime. Derived classes call
+     * Register() once at startup and then behave like any core event, e.g.
+     *
+     *   class DamageEvent : public CustomEvent<DamageEvent> { ... };
+     *   DamageEvent::Register("DAMAGE_EVENT", GAMEPLAY_CATEGORY);
+     *   EventManager::Trigger<DamageEvent>(...);
+     * */
+    template<typename Derived>
+    class CustomEvent : public Event {
+    public:
+        CustomEvent() : Event{ GetStaticType() } {}
+
+        static auto Register(std::string_view name, EventCategory categories) -> EventType {
+            s_Type = RegisterEventType(name, categories);
+            return s_Type;
+        }
+
+        MKT_NODISCARD auto GetType() const -> EventType override { return GetStaticType(); }
+        /**
+         * Returns the type handed out by Register(). Throws if
+         * the event type has not been registered yet
+         * @returns type of the event
+         * */
+        MKT_NODISCARD static auto GetStaticType() -> EventType {
+            if (s_Type == EventType::EMPTY_EVENT) {
+                MKT_THROW_RUNTIME_ERROR("Custom event used before its type was registered, call Register() at startup");
+            }
+
+            return s_Type;
+        }
+
+        MKT_NODISCARD auto DisplayData() const -> std::string override {
+            return fmt::format("{}!", GetEventFormattedStr(GetType()).data());
+        }
+
+    protected:
+        MKT_NODISCARD auto ToString() const -> std::string_view override { return GetEventFormattedStr(GetType()); }
+
+    private:
+        static inline EventType s_Type{ EventType::EMPTY_EVENT };
+    };
+
     /**
      * Helper to print an Event to console
      * */
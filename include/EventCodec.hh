@@ -0,0 +1,340 @@
+/**
+ * EventCodec.hh
+ * Created by kate on 10/19/26.
+ * */
+
+#ifndef EVENT_SYSTEM_EVENT_CODEC_HH
+#define EVENT_SYSTEM_EVENT_CODEC_HH
+
+// C++ Standard Library
+#include <bit>
+#include <span>
+#include <array>
+#include <memory>
+#include <cstddef>
+#include <algorithm>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+#include <CoreEvents.hh>
+
+namespace Mikoto::EventCodec {
+    /**
+     * Binary encoding of the core events. Every event type has a fixed layout record:
+     * a WireHeader followed by the event fields, little-endian, each field aligned to its
+     * size and the whole record padded to a multiple of 8 bytes. A record stored at an
+     * 8 byte aligned address is read in place through View(), without copying or parsing.
+     * Bump FORMAT_VERSION whenever a layout changes.
+     *
+     * Version 2 carries the window id of the event in the header flags. Version 1 records
+     * are still read, they have the same layout and decode as coming from no window.
+     * */
+    inline constexpr UInt8_T FORMAT_VERSION{ 2 };
+    inline constexpr UInt8_T OLDEST_FORMAT_VERSION{ 1 };
+    inline constexpr Size_T RECORD_ALIGNMENT{ 8 };
+
+    /**
+     * Value stored little-endian whatever the host byte order. On little-endian
+     * hosts Get() and Set() are plain loads and stores
+     * */
+    template<typename ValueType>
+        requires std::is_arithmetic_v<ValueType>
+    class LittleEndian {
+    public:
+        MKT_NODISCARD auto Get() const -> ValueType { return Convert(m_Value); }
+        auto Set(ValueType value) -> void { m_Value = Convert(value); }
+
+    private:
+        static auto Convert(ValueType value) -> ValueType {
+            if constexpr (std::endian::native == std::endian::little || sizeof(ValueType) == 1) {
+                return value;
+            }
+            else {
+                auto bytes{ std::bit_cast<std::array<std::byte, sizeof(ValueType)>>(value) };
+                std::reverse(bytes.begin(), bytes.end());
+                return std::bit_cast<ValueType>(bytes);
+            }
+        }
+
+    private:
+        ValueType m_Value{};
+    };
+
+    /**
+     * Flags of the wire header
+     * */
+    inline constexpr UInt8_T WIRE_HANDLED_FLAG{ BIT_SET(0) };
+    inline constexpr UInt8_T WIRE_REPEATED_FLAG{ BIT_SET(1) };
+
+    /**
+     * The window id takes the bits of the flags above the ones in use. Ids past
+     * WIRE_MAX_WINDOW_ID, which Window never hands out, are encoded as ANY_WINDOW_ID
+     * */
+    inline constexpr UInt8_T WIRE_WINDOW_SHIFT{ 2 };
+    inline constexpr WindowId_T WIRE_MAX_WINDOW_ID{ 0xFF >> WIRE_WINDOW_SHIFT };
+
+    /**
+     * Common start of every record. Size counts the whole record in 8 byte words
+     * so a reader can skip records of types it does not know
+     * */
+    struct WireHeader {
+        UInt8_T Version{ FORMAT_VERSION };
+        UInt8_T Type{};
+        UInt8_T Flags{};
+        UInt8_T Words{};
+        LittleEndian<UInt32_T> TimeStamp{};
+
+        MKT_NODISCARD auto GetSize() const -> Size_T { return static_cast<Size_T>(Words) * RECORD_ALIGNMENT; }
+        MKT_NODISCARD auto GetWindowId() const -> WindowId_T { return static_cast<WindowId_T>(Flags >> WIRE_WINDOW_SHIFT); }
+    };
+
+    struct WireEmpty {
+        WireHeader Header{};
+    };
+
+    struct WireWindowResized {
+        WireHeader Header{};
+        LittleEndian<Int32_T> Width{};
+        LittleEndian<Int32_T> Height{};
+    };
+
+    struct WireKeyPressed {
+        WireHeader Header{};
+        LittleEndian<Int32_T> KeyCode{};
+        LittleEndian<Int32_T> Modifiers{};
+    };
+
+    struct WireKeyReleased {
+        WireHeader Header{};
+        LittleEndian<Int32_T> KeyCode{};
+        UInt32_T Padding{};
+    };
+
+    struct WireKeyChar {
+        WireHeader Header{};
+        LittleEndian<UInt32_T> KeyChar{};
+        UInt32_T Padding{};
+    };
+
+    struct WireMouseMoved {
+        WireHeader Header{};
+        LittleEndian<double> PositionX{};
+        LittleEndian<double> PositionY{};
+    };
+
+    struct WireMouseButtonPressed {
+        WireHeader Header{};
+        LittleEndian<Int32_T> Button{};
+        LittleEndian<Int32_T> Modifiers{};
+    };
+
+    struct WireMouseButtonReleased {
+        WireHeader Header{};
+        LittleEndian<Int32_T> Button{};
+        UInt32_T Padding{};
+    };
+
+    struct WireMouseScroll {
+        WireHeader Header{};
+        LittleEndian<double> OffsetX{};
+        LittleEndian<double> OffsetY{};
+    };
+
+    /**
+     * Maps an event class to its record and converts between both. Only defined
+     * for the event types that have a specialization below
+     * */
+    template<typename EventClassType>
+    struct WireFormat;
+
+    /**
+     * True if the event type has a binary encoding
+     * */
+    template<typename EventClassType>
+    concept HasWireFormat = requires (const EventClassType& event, typename WireFormat<EventClassType>::Record_T& record) {
+        WireFormat<EventClassType>::Encode(event, record);
+        { WireFormat<EventClassType>::Decode(std::as_const(record)) } -> std::same_as<EventClassType>;
+    };
+
+    template<typename EventClassType>
+    using WireRecord_T = typename WireFormat<EventClassType>::Record_T;
+
+    template<typename EventClassType>
+        requires std::is_default_constructible_v<EventClassType>
+    struct WireFormatWithoutFields {
+        using Record_T = WireEmpty;
+
+        static auto Encode(const EventClassType&, Record_T&) -> void {}
+        static auto Decode(const Record_T&) -> EventClassType { return EventClassType{}; }
+    };
+
+    template<> struct WireFormat<WindowCloseEvent> : WireFormatWithoutFields<WindowCloseEvent> {};
+    template<> struct WireFormat<AppRender> : WireFormatWithoutFields<AppRender> {};
+    template<> struct WireFormat<AppUpdate> : WireFormatWithoutFields<AppUpdate> {};
+    template<> struct WireFormat<AppTick> : WireFormatWithoutFields<AppTick> {};
+
+    template<>
+    struct WireFormat<WindowResizedEvent> {
+        using Record_T = WireWindowResized;
+
+        static auto Encode(const WindowResizedEvent& event, Record_T& record) -> void { record.Width.Set(event.GetWidth()); record.Height.Set(event.GetHeight()); }
+        static auto Decode(const Record_T& record) -> WindowResizedEvent { return { record.Width.Get(), record.Height.Get() }; }
+    };
+
+    template<>
+    struct WireFormat<KeyPressedEvent> {
+        using Record_T = WireKeyPressed;
+
+        static auto Encode(const KeyPressedEvent& event, Record_T& record) -> void {
+            record.KeyCode.Set(event.GetKeyCode());
+            record.Modifiers.Set(event.GetModifiers());
+            record.Header.Flags |= event.IsRepeated() ? WIRE_REPEATED_FLAG : 0;
+        }
+
+        static auto Decode(const Record_T& record) -> KeyPressedEvent {
+            return { record.KeyCode.Get(), (record.Header.Flags & WIRE_REPEATED_FLAG) != 0, record.Modifiers.Get() };
+        }
+    };
+
+    template<>
+    struct WireFormat<KeyReleasedEvent> {
+        using Record_T = WireKeyReleased;
+
+        static auto Encode(const KeyReleasedEvent& event, Record_T& record) -> void { record.KeyCode.Set(event.GetKeyCode()); }
+        static auto Decode(const Record_T& record) -> KeyReleasedEvent { return KeyReleasedEvent{ record.KeyCode.Get() }; }
+    };
+
+    template<>
+    struct WireFormat<KeyCharEvent> {
+        using Record_T = WireKeyChar;
+
+        static auto Encode(const KeyCharEvent& event, Record_T& record) -> void { record.KeyChar.Set(event.GetChar()); }
+        static auto Decode(const Record_T& record) -> KeyCharEvent { return KeyCharEvent{ record.KeyChar.Get() }; }
+    };
+
+    template<>
+    struct WireFormat<MouseMovedEvent> {
+        using Record_T = WireMouseMoved;
+
+        static auto Encode(const MouseMovedEvent& event, Record_T& record) -> void { record.PositionX.Set(event.GetPositionX()); record.PositionY.Set(event.GetPositionY()); }
+        static auto Decode(const Record_T& record) -> MouseMovedEvent { return { record.PositionX.Get(), record.PositionY.Get() }; }
+    };
+
+    template<>
+    struct WireFormat<MouseButtonPressedEvent> {
+        using Record_T = WireMouseButtonPressed;
+
+        static auto Encode(const MouseButtonPressedEvent& event, Record_T& record) -> void { record.Button.Set(event.GetMouseButton()); record.Modifiers.Set(event.GetModifiers()); }
+        static auto Decode(const Record_T& record) -> MouseButtonPressedEvent { return MouseButtonPressedEvent{ record.Button.Get(), record.Modifiers.Get() }; }
+    };
+
+    template<>
+    struct WireFormat<MouseButtonReleasedEvent> {
+        using Record_T = WireMouseButtonReleased;
+
+        static auto Encode(const MouseButtonReleasedEvent& event, Record_T& record) -> void { record.Button.Set(event.GetMouseButton()); }
+        static auto Decode(const Record_T& record) -> MouseButtonReleasedEvent { return MouseButtonReleasedEvent{ record.Button.Get() }; }
+    };
+
+    template<>
+    struct WireFormat<MouseScrollEvent> {
+        using Record_T = WireMouseScroll;
+
+        static auto Encode(const MouseScrollEvent& event, Record_T& record) -> void { record.OffsetX.Set(event.GetOffsetX()); record.OffsetY.Set(event.GetOffsetY()); }
+        static auto Decode(const Record_T& record) -> MouseScrollEvent { return { record.OffsetX.Get(), record.OffsetY.Get() }; }
+    };
+
+    /**
+     * Returns the record size of the event class, zero if it has no encoding
+     * */
+    template<typename EventClassType>
+    MKT_NODISCARD consteval auto GetWireSizeOf() -> Size_T {
+        if constexpr (HasWireFormat<EventClassType>) {
+            return sizeof(WireRecord_T<EventClassType>);
+        }
+        else {
+            return 0;
+        }
+    }
+
+    /**
+     * Record sizes of every core event type, indexed by type. Zero for the types without encoding
+     * */
+    inline constexpr std::array<Size_T, static_cast<Size_T>(EventType::EVENT_TYPE_COUNT)> WIRE_SIZE_TABLE{
+        #define MKT_EVENT_WIRE_SIZE_TABLE_ENTRY(TYPE, CATEGORIES, CLASS) GetWireSizeOf<CLASS>(),
+        MKT_CORE_EVENT_LIST(MKT_EVENT_WIRE_SIZE_TABLE_ENTRY)
+        #undef MKT_EVENT_WIRE_SIZE_TABLE_ENTRY
+    };
+
+    /**
+     * Size of the largest record, buffers of this size hold any encoded event
+     * */
+    inline constexpr Size_T MAX_WIRE_SIZE{ *std::max_element(WIRE_SIZE_TABLE.begin(), WIRE_SIZE_TABLE.end()) };
+
+    /**
+     * Returns the size of the record of the given event type
+     * @returns record size in bytes, zero if the type has no binary encoding
+     * */
+    MKT_NODISCARD constexpr auto GetWireSize(EventType type) -> Size_T {
+        return static_cast<Size_T>(type) < WIRE_SIZE_TABLE.size() ? WIRE_SIZE_TABLE[static_cast<Size_T>(type)] : 0;
+    }
+
+    /**
+     * Writes the record of the event to the buffer. The buffer needs no particular alignment
+     * @param event event to be encoded
+     * @param buffer destination
+     * @returns number of bytes written, zero if the buffer is too small or the type has no encoding
+     * */
+    auto Encode(const Event& event, std::span<std::byte> buffer) -> Size_T;
+
+    /**
+     * Returns the header of the record at the start of the buffer, read in place
+     * @param buffer 8 byte aligned buffer holding a record
+     * @returns header, null if the buffer is misaligned, too small for the
+     * record or the record was written with a version of the format this one can not read
+     * */
+    MKT_NODISCARD auto PeekHeader(std::span<const std::byte> buffer) -> const WireHeader*;
+
+    /**
+     * Returns the record at the start of the buffer, read in place, no copy involved
+     * @param buffer 8 byte aligned buffer holding a record
+     * @returns record, null if the buffer does not hold a valid EventClassType record
+     * */
+    template<typename EventClassType>
+        requires HasWireFormat<EventClassType>
+    MKT_NODISCARD inline auto View(std::span<const std::byte> buffer) -> const WireRecord_T<EventClassType>* {
+        const WireHeader* header{ PeekHeader(buffer) };
+
+        if (header == nullptr || header->Type != static_cast<UInt8_T>(EventClassType::GetStaticType()) ||
+            header->GetSize() != sizeof(WireRecord_T<EventClassType>)) {
+            return nullptr;
+        }
+
+        return reinterpret_cast<const WireRecord_T<EventClassType>*>(buffer.data());
+    }
+
+    /**
+     * Rebuilds the event held by the record at the start of the buffer, time stamp, flags and window included.
+     * The buffer needs no particular alignment
+     * @param buffer buffer holding a record
+     * @returns new event, null if the buffer does not hold a valid record
+     * */
+    MKT_NODISCARD auto Decode(std::span<const std::byte> buffer) -> std::unique_ptr<Event>;
+
+    // Layouts are part of the format, changing any of these means a new FORMAT_VERSION
+    static_assert(sizeof(WireHeader) == 8);
+    static_assert(sizeof(WireEmpty) == 8);
+    static_assert(sizeof(WireWindowResized) == 16);
+    static_assert(sizeof(WireKeyPressed) == 16);
+    static_assert(sizeof(WireKeyReleased) == 16);
+    static_assert(sizeof(WireKeyChar) == 16);
+    static_assert(sizeof(WireMouseMoved) == 24);
+    static_assert(sizeof(WireMouseButtonPressed) == 16);
+    static_assert(sizeof(WireMouseButtonReleased) == 16);
+    static_assert(sizeof(WireMouseScroll) == 24);
+    static_assert(MAX_WIRE_SIZE == 24);
+    static_assert(MAX_WINDOW_COUNT <= WIRE_MAX_WINDOW_ID);
+}
+
+#endif // EVENT_SYSTEM_EVENT_CODEC_HH
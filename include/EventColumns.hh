@@ -0,0 +1,235 @@
+/**
+ * EventColumns.hh
+ * Created by kate on 10/19/26.
+ * */
+
+#ifndef EVENT_SYSTEM_EVENT_COLUMNS_HH
+#define EVENT_SYSTEM_EVENT_COLUMNS_HH
+
+// C++ Standard Library
+#include <span>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+// Project Headers
+#include <Common.hh>
+#include <CoreEvents.hh>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #define MKT_EVENT_COLUMNS_SSE2
+    #include <immintrin.h>
+#endif
+
+namespace Mikoto {
+    /**
+     * Structure of arrays storage for the events of one type. Each member of the event
+     * gets its own contiguous array, so consumers scanning a single field over thousands
+     * of events (positions, key codes) touch only the memory they need, and reductions
+     * such as ComputeBounds() can load several values at once. Only defined for the event
+     * types that have a specialization below.
+     * */
+    template<typename EventClassType>
+    struct EventColumns;
+
+    /**
+     * True if the event type has a columnar representation
+     * */
+    template<typename EventClassType>
+    concept HasEventColumns = requires (EventColumns<EventClassType> columns, const EventClassType& event) {
+        columns.Append(event);
+        columns.Clear();
+        columns.Size();
+    };
+
+    template<>
+    struct EventColumns<MouseMovedEvent> {
+        std::vector<double> PositionX{};
+        std::vector<double> PositionY{};
+        std::vector<UInt32_T> TimeStamp{};
+
+        auto Append(const MouseMovedEvent& event) -> void {
+            PositionX.push_back(event.GetPositionX());
+            PositionY.push_back(event.GetPositionY());
+            TimeStamp.push_back(event.GetTimeStamp());
+        }
+
+        auto Clear() -> void { PositionX.clear(); PositionY.clear(); TimeStamp.clear(); }
+        MKT_NODISCARD auto Size() const -> Size_T { return TimeStamp.size(); }
+    };
+
+    template<>
+    struct EventColumns<MouseScrollEvent> {
+        std::vector<double> OffsetX{};
+        std::vector<double> OffsetY{};
+        std::vector<UInt32_T> TimeStamp{};
+
+        auto Append(const MouseScrollEvent& event) -> void {
+            OffsetX.push_back(event.GetOffsetX());
+            OffsetY.push_back(event.GetOffsetY());
+            TimeStamp.push_back(event.GetTimeStamp());
+        }
+
+        auto Clear() -> void { OffsetX.clear(); OffsetY.clear(); TimeStamp.clear(); }
+        MKT_NODISCARD auto Size() const -> Size_T { return TimeStamp.size(); }
+    };
+
+    template<>
+    struct EventColumns<KeyPressedEvent> {
+        std::vector<Int32_T> KeyCode{};
+        std::vector<Int32_T> Modifiers{};
+        std::vector<UInt8_T> Repeated{};
+        std::vector<UInt32_T> TimeStamp{};
+
+        auto Append(const KeyPressedEvent& event) -> void {
+            KeyCode.push_back(event.GetKeyCode());
+            Modifiers.push_back(event.GetModifiers());
+            Repeated.push_back(event.IsRepeated());
+            TimeStamp.push_back(event.GetTimeStamp());
+        }
+
+        auto Clear() -> void { KeyCode.clear(); Modifiers.clear(); Repeated.clear(); TimeStamp.clear(); }
+        MKT_NODISCARD auto Size() const -> Size_T { return TimeStamp.size(); }
+    };
+
+    template<>
+    struct EventColumns<KeyReleasedEvent> {
+        std::vector<Int32_T> KeyCode{};
+        std::vector<UInt32_T> TimeStamp{};
+
+        auto Append(const KeyReleasedEvent& event) -> void {
+            KeyCode.push_back(event.GetKeyCode());
+            TimeStamp.push_back(event.GetTimeStamp());
+        }
+
+        auto Clear() -> void { KeyCode.clear(); TimeStamp.clear(); }
+        MKT_NODISCARD auto Size() const -> Size_T { return TimeStamp.size(); }
+    };
+
+    template<>
+    struct EventColumns<MouseButtonPressedEvent> {
+        std::vector<Int32_T> Button{};
+        std::vector<Int32_T> Modifiers{};
+        std::vector<UInt32_T> TimeStamp{};
+
+        auto Append(const MouseButtonPressedEvent& event) -> void {
+            Button.push_back(event.GetMouseButton());
+            Modifiers.push_back(event.GetModifiers());
+            TimeStamp.push_back(event.GetTimeStamp());
+        }
+
+        auto Clear() -> void { Button.clear(); Modifiers.clear(); TimeStamp.clear(); }
+        MKT_NODISCARD auto Size() const -> Size_T { return TimeStamp.size(); }
+    };
+
+    template<>
+    struct EventColumns<MouseButtonReleasedEvent> {
+        std::vector<Int32_T> Button{};
+        std::vector<UInt32_T> TimeStamp{};
+
+        auto Append(const MouseButtonReleasedEvent& event) -> void {
+            Button.push_back(event.GetMouseButton());
+            TimeStamp.push_back(event.GetTimeStamp());
+        }
+
+        auto Clear() -> void { Button.clear(); TimeStamp.clear(); }
+        MKT_NODISCARD auto Size() const -> Size_T { return TimeStamp.size(); }
+    };
+
+    /**
+     * Axis aligned bounding box of a set of 2D points
+     * */
+    struct Bounds2D {
+        double MinX{ std::numeric_limits<double>::max() };
+        double MinY{ std::numeric_limits<double>::max() };
+        double MaxX{ std::numeric_limits<double>::lowest() };
+        double MaxY{ std::numeric_limits<double>::lowest() };
+    };
+
+    /**
+     * Returns the smallest and largest of the values. On x86 two values are reduced at a time
+     * with packed SSE2 min/max, the compiler does not vectorize floating point min/max reductions
+     * on its own without relaxed math flags. NaNs are skipped either way
+     * @param values values to be reduced
+     * @returns smallest and largest value, (max, lowest) if there are none
+     * */
+    MKT_NODISCARD inline auto ComputeRange(std::span<const double> values) -> std::pair<double, double> {
+        double min{ std::numeric_limits<double>::max() };
+        double max{ std::numeric_limits<double>::lowest() };
+        Size_T index{};
+
+#if defined(MKT_EVENT_COLUMNS_SSE2)
+        __m128d minVec{ _mm_set1_pd(min) };
+        __m128d maxVec{ _mm_set1_pd(max) };
+
+        for (; index + 2 <= values.size(); index += 2) {
+            // The accumulator goes second, minpd and maxpd return it when the value is a NaN
+            const __m128d value{ _mm_loadu_pd(values.data() + index) };
+            minVec = _mm_min_pd(value, minVec);
+            maxVec = _mm_max_pd(value, maxVec);
+        }
+
+        min = std::min(_mm_cvtsd_f64(minVec), _mm_cvtsd_f64(_mm_unpackhi_pd(minVec, minVec)));
+        max = std::max(_mm_cvtsd_f64(maxVec), _mm_cvtsd_f64(_mm_unpackhi_pd(maxVec, maxVec)));
+#endif
+
+        for (; index < values.size(); ++index) {
+            min = std::min(min, values[index]);
+            max = std::max(max, values[index]);
+        }
+
+        return { min, max };
+    }
+
+    /**
+     * Returns the bounding box of the points given as two columns, each reduced with ComputeRange()
+     * @param xs x coordinates
+     * @param ys y coordinates, same size as xs
+     * @returns bounding box of the points, an empty (inverted) box if there are none
+     * */
+    MKT_NODISCARD inline auto ComputeBounds(std::span<const double> xs, std::span<const double> ys) -> Bounds2D {
+        const auto [minX, maxX]{ ComputeRange(xs) };
+        const auto [minY, maxY]{ ComputeRange(ys) };
+
+        return { minX, minY, maxX, maxY };
+    }
+
+    /**
+     * Returns the distance travelled along the path formed by the given points. Scalar, the
+     * sum is kept in order so the result does not depend on the instruction set
+     * @param xs x coordinates
+     * @param ys y coordinates, same size as xs
+     * @returns length of the path
+     * */
+    MKT_NODISCARD inline auto ComputePathLength(std::span<const double> xs, std::span<const double> ys) -> double {
+        double result{};
+
+        for (Size_T index{ 1 }; index < xs.size(); ++index) {
+            const double dx{ xs[index] - xs[index - 1] };
+            const double dy{ ys[index] - ys[index - 1] };
+            result += std::sqrt(dx * dx + dy * dy);
+        }
+
+        return result;
+    }
+
+    /**
+     * Returns the average velocity of the cursor over the batch, in pixels per second
+     * @param columns mouse moved events of the batch
+     * @returns average velocity, zero if the batch covers no time
+     * */
+    MKT_NODISCARD inline auto ComputeAverageVelocity(const EventColumns<MouseMovedEvent>& columns) -> double {
+        if (columns.Size() < 2 || columns.TimeStamp.back() == columns.TimeStamp.front()) {
+            return 0.0;
+        }
+
+        // Unsigned difference stays correct across a wrap of the 32 bit stamps
+        const UInt32_T elapsedMicros{ columns.TimeStamp.back() - columns.TimeStamp.front() };
+        const auto elapsed{ static_cast<double>(elapsedMicros) * 1e-6 };
+        return ComputePathLength(columns.PositionX, columns.PositionY) / elapsed;
+    }
+}
+
+#endif // EVENT_SYSTEM_EVENT_COLUMNS_HH
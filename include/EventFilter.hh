@@ -0,0 +1,65 @@
+/**
+ * EventFilter.hh
+ * Created by kate on 10/19/26.
+ * */
+
+#ifndef EVENT_SYSTEM_EVENT_FILTER_HH
+#define EVENT_SYSTEM_EVENT_FILTER_HH
+
+// C++ Standard Library
+#include <bit>
+#include <span>
+
+// Project Headers
+#include <Common.hh>
+
+namespace Mikoto::EventFilter {
+    /**
+     * Batch filters over the packed type tags and category flags of a whole frame.
+     * Results are written as match masks, one bit per event, bit i of the result
+     * being bit (i % 64) of word (i / 64). Uses AVX2 when the CPU supports it,
+     * SSE2 on any other x86-64 CPU and a scalar loop elsewhere.
+     * */
+
+    /**
+     * Returns how many mask words are needed to hold the result for the given amount of events
+     * @param count number of events
+     * @returns number of 64 bit words
+     * */
+    MKT_NODISCARD constexpr auto GetMaskWordCount(Size_T count) -> Size_T { return (count + 63) / 64; }
+
+    /**
+     * Sets the bit of every event whose category flags share at least one bit with wanted
+     * @param categories packed category flags, one per event
+     * @param wanted category flags to match against
+     * @param masks result, at least GetMaskWordCount(categories.size()) words
+     * */
+    auto MatchCategories(std::span<const UInt32_T> categories, UInt32_T wanted, std::span<UInt64_T> masks) -> void;
+
+    /**
+     * Sets the bit of every event whose type tag equals wanted
+     * @param types packed type tags, one per event
+     * @param wanted type tag to match against
+     * @param masks result, at least GetMaskWordCount(types.size()) words
+     * */
+    auto MatchTypes(std::span<const UInt8_T> types, UInt8_T wanted, std::span<UInt64_T> masks) -> void;
+
+    /**
+     * Calls func with the index of every bit set in the masks, in increasing order
+     * @param masks match masks as produced by the functions above
+     * @param func callable taking a Size_T index
+     * */
+    template<typename FuncType>
+    inline auto ForEachMatch(std::span<const UInt64_T> masks, FuncType&& func) -> void {
+        for (Size_T word{}; word < masks.size(); ++word) {
+            UInt64_T bits{ masks[word] };
+
+            while (bits != 0) {
+                func(word * 64 + static_cast<Size_T>(std::countr_zero(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+}
+
+#endif // EVENT_SYSTEM_EVENT_FILTER_HH
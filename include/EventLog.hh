@@ -0,0 +1,184 @@
+/**
+ * EventLog.hh
+ * Created by kate on 10/19/26.
+ * */
+
+#ifndef EVENT_SYSTEM_EVENT_LOG_HH
+#define EVENT_SYSTEM_EVENT_LOG_HH
+
+// C++ Standard Library
+#include <memory>
+#include <vector>
+#include <fstream>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+
+namespace Mikoto {
+    /**
+     * Compact log of recorded events, meant for long recording sessions.
+     *
+     * The file is a header, a sequence of chunks, a chunk index and a trailer pointing
+     * at the index. Every chunk starts from a clean state so it can be decoded on its own:
+     * a reader seeks by picking the chunk from the index and decoding from there, and a
+     * log whose index was never written (crashed recorder) is recovered by walking the
+     * chunk headers.
+     *
+     * Inside a chunk each event is a varint tag (type and encoding flags), the event flags
+     * and window id as a varint when any is set, its time as a varint delta of delta from
+     * the previous event (one byte at a steady rate) and its fields. Integer fields are
+     * zigzag varints. Mouse positions and scroll offsets are stored as deltas from the
+     * previous pair, in whole pixels when possible, else in 1/256 pixel units, falling
+     * back to raw doubles when neither is exact. Whole pixel deltas
+     * within [-8, 7] share a single byte, so a cursor move usually takes three bytes (tag,
+     * time, position) against 32 for the event in memory and 24 for an EventCodec record.
+     * On 1 kHz cursor motion moving a few pixels per event, with a key press every 100
+     * moves, that is about 3.05 bytes per event, 10.5x smaller than the events in memory
+     * (7.9x smaller than EventCodec records). Larger jumps fall back to varints.
+     *
+     * Event time stamps are 32 bits and wrap, the log keeps a 64 bit time
+     * (microseconds, same clock) so sessions longer than the wrap period stay ordered.
+     * */
+
+    /**
+     * Entry of the chunk index
+     * */
+    struct EventLogChunkInfo {
+        UInt64_T FileOffset{};
+        UInt64_T FirstTime{};
+        UInt32_T EventCount{};
+    };
+
+    class EventLogWriter {
+    public:
+        /**
+         * Creates the log file, replacing any existing one
+         * @param path path of the log file
+         * @param chunkSize encoded bytes after which a chunk is closed
+         * */
+        explicit EventLogWriter(const Path_T& path, Size_T chunkSize = 64 * 1024);
+
+        EventLogWriter(const EventLogWriter&) = delete;
+        auto operator=(const EventLogWriter&) -> EventLogWriter& = delete;
+
+        /**
+         * Adds an event to the log. Throws if the file can not be written
+         * @param event event to be recorded
+         * @returns false if the event type can not be recorded, the types without an
+         * EventCodec encoding (EMPTY_EVENT, types registered at runtime...)
+         * */
+        auto Append(const Event& event) -> bool;
+
+        /**
+         * Writes the current chunk to the file, the next event starts a new one.
+         * Throws if the file can not be written
+         * */
+        auto Flush() -> void;
+
+        /**
+         * Flushes and writes the chunk index. No event can be appended afterwards.
+         * Throws if the file can not be written, the destructor closes the log
+         * too but can not report errors
+         * */
+        auto Close() -> void;
+
+        MKT_NODISCARD auto GetEventCount() const -> UInt64_T { return m_EventCount; }
+        MKT_NODISCARD auto GetChunkCount() const -> Size_T { return m_Index.size(); }
+
+        ~EventLogWriter();
+
+    private:
+        auto Write(const std::vector<UInt8_T>& data) -> void;
+
+    private:
+        struct DeltaState {
+            UInt64_T Time{};
+            Int64_T TimeDelta{};
+            Int64_T PositionX{};
+            Int64_T PositionY{};
+            Int64_T OffsetX{};
+            Int64_T OffsetY{};
+        };
+
+    private:
+        std::ofstream m_Stream{};
+        Size_T m_ChunkSize{};
+
+        std::vector<UInt8_T> m_Chunk{};
+        EventLogChunkInfo m_ChunkInfo{};
+        DeltaState m_State{};
+
+        std::vector<EventLogChunkInfo> m_Index{};
+        UInt64_T m_FileOffset{};
+        UInt64_T m_EventCount{};
+
+        // 64 bit time of the last event and the 32 bit stamp it was extended from
+        UInt64_T m_Time{};
+        UInt32_T m_LastStamp{};
+        bool m_Closed{};
+    };
+
+    class EventLogReader {
+    public:
+        /**
+         * Opens a log. Throws if the file is not an event log
+         * @param path path of the log file
+         * */
+        explicit EventLogReader(const Path_T& path);
+
+        /**
+         * Decodes the next event
+         * @returns next event, null at the end of the log
+         * */
+        MKT_NODISCARD auto Next() -> std::unique_ptr<Event>;
+
+        /**
+         * Moves to the first event at or after the given time
+         * @param offset microseconds since the first event of the log
+         * */
+        auto Seek(UInt64_T offset) -> void;
+
+        /**
+         * Returns the time of the last event returned by Next()
+         * @returns microseconds since the first event of the log
+         * */
+        MKT_NODISCARD auto GetTime() const -> UInt64_T { return m_Time - GetStartTime(); }
+        MKT_NODISCARD auto GetStartTime() const -> UInt64_T { return m_Index.empty() ? 0 : m_Index.front().FirstTime; }
+
+        MKT_NODISCARD auto GetChunks() const -> const std::vector<EventLogChunkInfo>& { return m_Index; }
+        MKT_NODISCARD auto GetEventCount() const -> UInt64_T;
+
+        /**
+         * Tells whether the log had no index and the chunks were found by walking the file
+         * */
+        MKT_NODISCARD auto IsRecovered() const -> bool { return m_Recovered; }
+
+    private:
+        auto LoadChunk(Size_T chunk) -> bool;
+        auto DecodeNext() -> std::unique_ptr<Event>;
+
+    private:
+        std::ifstream m_Stream{};
+        std::vector<EventLogChunkInfo> m_Index{};
+        bool m_Recovered{};
+
+        // Chunk being decoded
+        std::vector<UInt8_T> m_Chunk{};
+        Size_T m_Cursor{};
+        Size_T m_NextChunk{};
+
+        UInt64_T m_Time{};
+        Int64_T m_TimeDelta{};
+        Int64_T m_PositionX{};
+        Int64_T m_PositionY{};
+        Int64_T m_OffsetX{};
+        Int64_T m_OffsetY{};
+
+        // Event found by Seek(), returned by the next call to Next()
+        std::unique_ptr<Event> m_Pending{};
+        UInt64_T m_PendingTime{};
+    };
+}
+
+#endif // EVENT_SYSTEM_EVENT_LOG_HH
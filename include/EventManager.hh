@@ -6,13 +6,29 @@
 #ifndef EVENT_SYSTEM_EVENT_MANAGER_HH
 #define EVENT_SYSTEM_EVENT_MANAGER_HH
 
+#include <bit>
 #include <vector>
+#include <iterator>
+#include <algorithm>
 #include <set>
+#include <span>
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <future>
+#include <optional>
+#include <string>
+#include <thread>
 #include <functional>
 #include <string_view>
-#include <unordered_map>
 
 #include <Event.hh>
+#include <EventColumns.hh>
+#include <FlatContainers.hh>
+#include <TopicRouter.hh>
+
 namespace Mikoto::EventManager {
     /**
      * This concept ensures type safety determining in for the dispatcher method.
@@ -42,10 +58,28 @@ namespace Mikoto::EventManager {
 
     class EventHandlerWrapper {
     public:
-        EventHandlerWrapper(EventType type, EventHandler_T&& func)
-            :   m_Handler{ std::move(func) }
-            ,   m_Type{ type }
+        /**
+         * Creates a handler for the events of the given type. A handler bound to a window
+         * only runs for the events of that window
+         * */
+        EventHandlerWrapper(EventType type, EventHandler_T&& func, WindowId_T window = ANY_WINDOW_ID)
+            :   m_Type{ type }
             ,   m_Category{ GetCategoryFromType(type) }
+            ,   m_Handler{ std::move(func) }
+            ,   m_Window{ window }
+        {
+
+        }
+
+        /**
+         * Creates a handler for every event of the given category, whatever its type.
+         * */
+        EventHandlerWrapper(EventCategory category, EventHandler_T&& func, WindowId_T window = ANY_WINDOW_ID)
+            :   m_Type{ EventType::EMPTY_EVENT }
+            ,   m_Category{ category }
+            ,   m_Handler{ std::move(func) }
+            ,   m_Window{ window }
+            ,   m_ByCategory{ true }
         {
 
         }
@@ -61,6 +95,42 @@ namespace Mikoto::EventManager {
         MKT_NODISCARD auto GetCategory() const -> EventCategory { return m_Category; }
         MKT_NODISCARD auto GetHandler() const -> EventHandler_T { return m_Handler; }
 
+        /**
+         * Returns the window this handler is bound to, ANY_WINDOW_ID if it runs for every window
+         * */
+        MKT_NODISCARD auto GetWindow() const -> WindowId_T { return m_Window; }
+
+        /**
+         * Returns true if this handler was subscribed to a category rather than to an event type
+         * */
+        MKT_NODISCARD auto IsCategoryHandler() const -> bool { return m_ByCategory; }
+
+        /**
+         * Returns true if this handler has to be run for the given event
+         * */
+        MKT_NODISCARD auto Matches(const Event& event) const -> bool {
+            if (m_Window != ANY_WINDOW_ID && m_Window != event.GetWindowId()) {
+                return false;
+            }
+
+            return m_ByCategory ? (GetCategoryFromType(event.GetType()) & m_Category) != 0 : event.GetType() == m_Type;
+        }
+
+        /**
+         * Watchdog bookkeeping. Strikes counts how many consecutive executions of this
+         * handler went over the budget, worst time is the longest execution seen so far.
+         * A demoted handler is no longer run from ProcessEvents() but from ProcessBackgroundEvents()
+         * */
+        MKT_NODISCARD auto GetStrikes() const -> UInt32_T { return m_Strikes; }
+        MKT_NODISCARD auto GetWorstTime() const -> std::chrono::nanoseconds { return m_WorstTime; }
+        MKT_NODISCARD auto IsReported() const -> bool { return m_Reported; }
+        MKT_NODISCARD auto IsDemoted() const -> bool { return m_Demoted; }
+
+        auto SetStrikes(UInt32_T value) -> void { m_Strikes = value; }
+        auto SetWorstTime(std::chrono::nanoseconds value) -> void { m_WorstTime = value; }
+        auto SetReported(bool value) -> void { m_Reported = value; }
+        auto SetDemoted(bool value) -> void { m_Demoted = value; }
+
         /**
          * Returns true if this EventHandlerWrapper and other are the same, meaning
          * they have same type of event and the event is from same categories.
@@ -75,102 +145,1807 @@ namespace Mikoto::EventManager {
         EventType m_Type{};
         EventCategory m_Category{};
         EventHandler_T m_Handler{};
+        WindowId_T m_Window{};
+        bool m_ByCategory{};
+
+        std::chrono::nanoseconds m_WorstTime{};
+        UInt32_T m_Strikes{};
+        bool m_Reported{};
+        bool m_Demoted{};
     };
 
-    // List of events handlers
-    using Handlers_T = std::vector<EventHandlerWrapper>;
+    // Handlers are owned by the subscribers, once unsubscribed they are kept alive
+    // until the dispatch table snapshots still showing them are released
+    using HandlerPtr_T = std::shared_ptr<EventHandlerWrapper>;
+
+    // List of events handlers. Most subscribers have one to three, kept inline
+    using Handlers_T = SmallVector<HandlerPtr_T, 3>;
 
     // Holds all the event subscribers with the corresponding event handler for each type of event.
     // Subscribers are differentiated by their universally unique identifier (uuid for short).
     // When a subscriber wants to receive some type of event, it is added to this map, and when that
-    // event has been triggered, the event handler will be run.
-    using Subscribers_T = std::unordered_map<UInt64_T, std::vector<EventHandlerWrapper>>;
+    // event has been triggered, the event handler will be run. Flat, so a subscriber and its
+    // handlers usually take a single slot of one array
+    using Subscribers_T = FlatHashMap<UInt64_T, Handlers_T>;
+
+    /**
+     * Handler as seen by the dispatcher, together with the subscriber that owns it.
+     * The handler is owned by the subscriber registry and outlives every snapshot showing it
+     * */
+    struct DispatchEntry {
+        UInt64_T SubscriberId{};
+        EventHandlerWrapper* Handler{};
+    };
+
+    /**
+     * List of the handlers of one event type, or of the category handlers. Never
+     * modified once published, a change publishes a modified copy in its place
+     * */
+    struct HandlerSnapshot {
+        std::vector<DispatchEntry> Entries{};
+    };
+
+    /**
+     * Maximum number of threads reading dispatch tables at the same time, see DispatchReadGuard
+     * */
+    inline constexpr Size_T MAX_DISPATCH_READER_COUNT{ 64 };
+
+    /**
+     * Marks the calling thread as reading dispatch tables while alive. The snapshots it
+     * loads, and the handlers they point to, are not released until it is destroyed. Entering
+     * and leaving are a few loads and stores, no lock and no retry. Guards may be nested
+     * */
+    class DispatchReadGuard {
+    public:
+        DispatchReadGuard();
+
+        DispatchReadGuard(const DispatchReadGuard&) = delete;
+        auto operator=(const DispatchReadGuard&) -> DispatchReadGuard& = delete;
+
+        ~DispatchReadGuard();
+    };
+
+    /**
+     * Handlers indexed by the event type they are subscribed to, core and runtime registered
+     * types alike, plus the list of category handlers. Handlers bound to a window have lists
+     * of their own, created the first time one subscribes, so the events of a window never
+     * walk the handlers of another one. Every list is an immutable snapshot
+     * behind an atomic pointer: the dispatcher reads it with a single acquire load while
+     * subscription changes copy the list, modify the copy and swap it in. Replaced snapshots
+     * are released by epoch based reclamation once no reader can still be walking them,
+     * so dispatching never waits on subscription changes, however many there are.
+     *
+     * A change costs a copy of the list it touches: cheap for the usual handful of
+     * handlers per type, linear in the handlers of that type otherwise.
+     * */
+    class DispatchTable {
+    public:
+        DispatchTable() = default;
+
+        DispatchTable(const DispatchTable&) = delete;
+        auto operator=(const DispatchTable&) -> DispatchTable& = delete;
+
+        /**
+         * Returns the handlers of the event type. The calling thread must hold a DispatchReadGuard
+         * for as long as it uses the result
+         * @param type event type
+         * @param window window the handlers are bound to, ANY_WINDOW_ID for the ones of every window
+         * @returns handlers subscribed to the type
+         * */
+        MKT_NODISCARD auto GetHandlers(EventType type, WindowId_T window = ANY_WINDOW_ID) const -> std::span<const DispatchEntry> {
+            return Read(window, static_cast<Size_T>(type));
+        }
+
+        /**
+         * Same as GetHandlers() for the category handlers
+         * @param window window the handlers are bound to, ANY_WINDOW_ID for the ones of every window
+         * @returns handlers subscribed to a category
+         * */
+        MKT_NODISCARD auto GetCategoryHandlers(WindowId_T window = ANY_WINDOW_ID) const -> std::span<const DispatchEntry> { return Read(window, CATEGORY_LIST); }
+
+        /**
+         * Tells whether handlers were ever bound to the window. Lists of a window are
+         * kept once created, they may be empty
+         * @param window window id
+         * @returns true if the window has lists of its own
+         * */
+        MKT_NODISCARD auto HasWindowLists(WindowId_T window) const -> bool {
+            return window != ANY_WINDOW_ID && window <= MAX_WINDOW_COUNT && m_WindowLists[window - 1].load(std::memory_order_acquire) != nullptr;
+        }
+
+        /**
+         * Publishes the list of the handler with the handler added
+         * @param subId subscriber owning the handler
+         * @param handler handler to be added
+         * */
+        auto Insert(UInt64_T subId, const HandlerPtr_T& handler) -> void;
+
+        /**
+         * Publishes the lists of the handlers with the handlers removed. The handlers
+         * are released once no reader can see them anymore
+         * @param handlers handlers to be removed
+         * */
+        auto Erase(Handlers_T&& handlers) -> void;
+
+        /**
+         * Publishes every list empty
+         * */
+        auto Clear() -> void;
+
+        ~DispatchTable();
+
+    private:
+        static constexpr Size_T CATEGORY_LIST{ MAX_EVENT_TYPE_COUNT };
+
+        // One list per event type plus the category list
+        using HandlerLists_T = std::array<std::atomic<const HandlerSnapshot*>, MAX_EVENT_TYPE_COUNT + 1>;
+
+        MKT_NODISCARD auto Read(WindowId_T window, Size_T list) const -> std::span<const DispatchEntry> {
+            const HandlerLists_T* lists{ window == ANY_WINDOW_ID ? std::addressof(m_Lists) : nullptr };
+
+            if (window != ANY_WINDOW_ID && window <= MAX_WINDOW_COUNT) {
+                lists = m_WindowLists[window - 1].load(std::memory_order_acquire);
+            }
+
+            const auto* snapshot{ lists ? (*lists)[list].load(std::memory_order_acquire) : nullptr };
+            return snapshot ? std::span<const DispatchEntry>{ snapshot->Entries } : std::span<const DispatchEntry>{};
+        }
+
+        MKT_NODISCARD static auto GetList(const EventHandlerWrapper& handler) -> Size_T {
+            return handler.IsCategoryHandler() ? CATEGORY_LIST : static_cast<Size_T>(handler.GetType());
+        }
+
+        /**
+         * Returns the lists of the window the handler is bound to, creating them if needed
+         * */
+        auto GetLists(const EventHandlerWrapper& handler) -> HandlerLists_T&;
+
+        /**
+         * Swaps the snapshot in and retires the one it replaces, along with the released handlers.
+         * Must be called with the lock of the list held
+         * */
+        auto Publish(std::atomic<const HandlerSnapshot*>& list, std::unique_ptr<HandlerSnapshot>&& snapshot, Handlers_T&& released) -> void;
+
+    private:
+        HandlerLists_T m_Lists{};
+
+        // Lists of the handlers bound to each window, indexed by window id minus one.
+        // Created by writers under the windows lock, never released before the table
+        std::array<std::atomic<HandlerLists_T*>, MAX_WINDOW_COUNT> m_WindowLists{};
+        std::mutex m_WindowListsMutex{};
+
+        // Serialize the writers of each list, for every window, readers never take them
+        std::array<std::mutex, MAX_EVENT_TYPE_COUNT + 1> m_WriteMutexes{};
+    };
+
+    /**
+     * Subscribers split in shards by subscriber id, each with its own lock, so
+     * subscription changes from different threads only contend when they land
+     * on the same shard. ProcessEvents() does not read the registry, it reads the
+     * dispatch table, which every change updates while the shard is still locked
+     * so the registry and the table always agree on a subscriber.
+     * */
+    class SubscriberRegistry {
+    public:
+        static constexpr Size_T SHARD_COUNT{ 16 };
+
+        /**
+         * @param table dispatch table kept up to date with the subscriptions
+         * */
+        explicit SubscriberRegistry(DispatchTable& table)
+            :   m_Table{ table } {}
+
+        /**
+         * Adds a handler to the subscriber, creating the subscriber if needed
+         * @param subId subscriber unique identifier
+         * @param handler handler to be added
+         * */
+        auto Add(UInt64_T subId, HandlerPtr_T handler) -> void {
+            auto& shard{ GetShard(subId) };
+
+            std::scoped_lock lock{ shard.Mutex };
+            m_Table.Insert(subId, handler);
+            shard.Subscribers[subId].push_back(std::move(handler));
+        }
+
+        /**
+         * Removes the handlers of the subscriber accepted by the filter,
+         * and the subscriber itself once it has no handler left
+         * @param subId subscriber unique identifier
+         * @param filter returns true for the handlers to be removed
+         * */
+        template<typename FilterFuncType>
+        auto Remove(UInt64_T subId, const FilterFuncType& filter) -> void {
+            auto& shard{ GetShard(subId) };
+
+            std::scoped_lock lock{ shard.Mutex };
+
+            auto it{ shard.Subscribers.find(subId) };
+            if (it == shard.Subscribers.end()) {
+                return;
+            }
+
+            auto& handlers{ it->second };
+            const auto removed{ std::stable_partition(handlers.begin(), handlers.end(), [&](const HandlerPtr_T& handler) -> bool { return !filter(handler); }) };
+
+            Handlers_T released{ std::make_move_iterator(removed), std::make_move_iterator(handlers.end()) };
+            handlers.erase(removed, handlers.end());
+
+            if (handlers.empty()) {
+                shard.Subscribers.erase(it);
+            }
+
+            if (!released.empty()) {
+                m_Table.Erase(std::move(released));
+            }
+        }
+
+        /**
+         * Calls the function with every subscriber id and its handlers. Shards are
+         * locked one at a time, the function must not change subscriptions
+         * @param function callable taking a UInt64_T and a const Handlers_T&
+         * */
+        template<typename FunctionType>
+        auto ForEach(FunctionType&& function) -> void {
+            for (auto& shard : m_Shards) {
+                std::scoped_lock lock{ shard.Mutex };
+
+                for (const auto& [subId, handlers] : shard.Subscribers) {
+                    function(subId, handlers);
+                }
+            }
+        }
+
+        /**
+         * Removes the handlers accepted by the filter from every subscriber, and the
+         * subscribers left without handlers. Shards are locked one at a time
+         * @param filter returns true for the handlers to be removed
+         * */
+        template<typename FilterFuncType>
+        auto RemoveIf(const FilterFuncType& filter) -> void {
+            Handlers_T released{};
+
+            for (auto& shard : m_Shards) {
+                std::scoped_lock lock{ shard.Mutex };
+
+                // Erasing shifts entries back, the emptied subscribers are erased after the walk
+                std::vector<UInt64_T> emptied{};
+
+                for (auto& [subId, handlers] : shard.Subscribers) {
+                    const auto removed{ std::stable_partition(handlers.begin(), handlers.end(), [&](const HandlerPtr_T& handler) -> bool { return !filter(handler); }) };
+
+                    std::move(removed, handlers.end(), std::back_inserter(released));
+                    handlers.erase(removed, handlers.end());
+
+                    if (handlers.empty()) {
+                        emptied.push_back(subId);
+                    }
+                }
+
+                for (const auto subId : emptied) {
+                    shard.Subscribers.erase(shard.Subscribers.find(subId));
+                }
+            }
+
+            if (!released.empty()) {
+                m_Table.Erase(std::move(released));
+            }
+        }
+
+        auto Clear() -> void {
+            Handlers_T released{};
+
+            for (auto& shard : m_Shards) {
+                std::scoped_lock lock{ shard.Mutex };
+
+                for (auto& [subId, handlers] : shard.Subscribers) {
+                    std::ranges::move(handlers, std::back_inserter(released));
+                }
+
+                shard.Subscribers.clear();
+            }
+
+            // Handlers are removed by identity, ones added meanwhile are kept
+            m_Table.Erase(std::move(released));
+        }
+
+    private:
+        // Own cache line each, writers on different shards do not share one
+        struct alignas(64) Shard {
+            std::mutex Mutex{};
+            Subscribers_T Subscribers{};
+        };
+
+        MKT_NODISCARD auto GetShard(UInt64_T subId) -> Shard& {
+            // Ids are often sequential, mixed so they spread over the shards
+            return m_Shards[(subId * 0x9E3779B97F4A7C15) >> (64 - std::countr_zero(SHARD_COUNT))];
+        }
+
+    private:
+        DispatchTable& m_Table;
+        std::array<Shard, SHARD_COUNT> m_Shards{};
+    };
 
     // Represents an event queue
     using EventQueue_T = std::vector<std::unique_ptr<Event>>;
 
+    // Identifies a named channel, see TopicRouter
+    using ChannelId_T = TopicRouter::ChannelId_T;
+
     /**
-     * Returns the queue of pending events
-     * @returns queue of pending events
+     * Event published on a named channel
      * */
-    inline auto GetEventQueue() -> EventQueue_T& {
-        static std::vector<std::unique_ptr<Event>> eventQueue{};
-        return eventQueue;
-    }
+    struct ChannelEvent {
+        ChannelId_T Channel{};
+        std::unique_ptr<Event> Payload{};
+    };
+
+    // Represents the queue of events published on named channels
+    using ChannelQueue_T = std::vector<ChannelEvent>;
 
     /**
-     * Returns the set of event subscribers
-     * @returns event subscribers
+     * Alias for batch event functions. A batch handler receives all the events of one
+     * type queued during the frame at once, stored contiguously and in queue order.
      * */
-    inline auto GetSubscribers() -> Subscribers_T& {
-        static Subscribers_T subscribers{};
-        return subscribers;
-    }
+    template<typename EventClassType>
+    using BatchHandler_T = std::function<void(std::span<const EventClassType>)>;
 
     /**
-     * Subscribes an object to be notified when a type of event has happened.
-     * @param subId identifier for the subscriber object
-     * @param handler event handler from the subscriber
+     * Alias for columnar event functions. Same as a batch handler but the events
+     * are handed over as one array per field, see EventColumns
      * */
-    inline auto Subscribe(UInt64_T subId, EventType type, EventHandler_T&& handler) -> void {
-        auto& subscribers{ GetSubscribers() };
+    template<typename EventClassType>
+    using ColumnsHandler_T = std::function<void(const EventColumns<EventClassType>&)>;
+
+    /**
+     * Type erased interface of the per event type storage used for batch dispatch.
+     * ProcessEvents() appends the events of the frame to the channel of their type
+     * and hands the whole batch to the batch handlers once the queue has been traversed.
+     * */
+    class BatchChannelBase {
+    public:
+        virtual auto Append(const Event& event) -> void = 0;
+        virtual auto Dispatch() -> void = 0;
+        virtual auto Clear() -> void = 0;
+        virtual auto Unsubscribe(UInt64_T subId) -> void = 0;
 
-        if (!subscribers.contains(subId)) {
-            // subscriber does not exists
-            auto result{ subscribers.emplace(subId, Handlers_T{}) };
-            result.first->second.emplace_back(type, std::move(handler));
+        virtual ~BatchChannelBase() = default;
+    };
+
+    /**
+     * Placeholder column storage for event types without an EventColumns specialization
+     * */
+    struct NoEventColumns {
+        auto Clear() -> void {}
+    };
+
+    template<typename EventClassType>
+    struct ColumnsOf { using Type = NoEventColumns; };
+
+    template<typename EventClassType>
+        requires HasEventColumns<EventClassType>
+    struct ColumnsOf<EventClassType> { using Type = EventColumns<EventClassType>; };
 
+    template<typename EventClassType>
+    class BatchChannel : public BatchChannelBase {
+    public:
+        auto Subscribe(UInt64_T subId, BatchHandler_T<EventClassType>&& handler) -> void {
+            m_Handlers.emplace_back(subId, std::move(handler));
         }
-        else {
-            // subscriber does exists
-            subscribers[subId].emplace_back(type, std::move(handler));
 
+        auto SubscribeColumns(UInt64_T subId, ColumnsHandler_T<EventClassType>&& handler) -> void
+            requires HasEventColumns<EventClassType>
+        {
+            m_ColumnsHandlers.emplace_back(subId, std::move(handler));
+        }
+
+        /**
+         * Adds the event to the storage the subscribers of this channel need,
+         * the contiguous array of events, the columns or both.
+         * */
+        auto Append(const Event& event) -> void override {
+            const auto& typedEvent{ static_cast<const EventClassType&>(event) };
+
+            if (!m_Handlers.empty()) {
+                m_Events.push_back(typedEvent);
+            }
+
+            if constexpr (HasEventColumns<EventClassType>) {
+                if (!m_ColumnsHandlers.empty()) {
+                    m_Columns.Append(typedEvent);
+                }
+            }
+        }
+
+        /**
+         * Hands the batch to the handlers. They are walked over a copy, handlers may subscribe
+         * or unsubscribe from the channel, changes are picked up from the next frame on
+         * */
+        auto Dispatch() -> void override {
+            if (!m_Events.empty()) {
+                m_DispatchingHandlers = m_Handlers;
+
+                for (auto& [subId, handler] : m_DispatchingHandlers) {
+                    handler(std::span<const EventClassType>{ m_Events });
+                }
+
+                m_DispatchingHandlers.clear();
+            }
+
+            if constexpr (HasEventColumns<EventClassType>) {
+                if (m_Columns.Size() != 0) {
+                    m_DispatchingColumnsHandlers = m_ColumnsHandlers;
+
+                    for (auto& [subId, handler] : m_DispatchingColumnsHandlers) {
+                        handler(m_Columns);
+                    }
+
+                    m_DispatchingColumnsHandlers.clear();
+                }
+            }
+        }
+
+        /**
+         * Drops the events of this frame. The storage is kept
+         * so the following frames do not have to allocate again
+         * */
+        auto Clear() -> void override {
+            m_Events.clear();
+            m_Columns.Clear();
         }
-    }
+
+        auto Unsubscribe(UInt64_T subId) -> void override {
+            std::erase_if(m_Handlers, [&](const auto& entry) -> bool { return entry.first == subId; });
+            std::erase_if(m_ColumnsHandlers, [&](const auto& entry) -> bool { return entry.first == subId; });
+        }
+
+    private:
+        using Columns_T = typename ColumnsOf<EventClassType>::Type;
+
+        std::vector<EventClassType> m_Events{};
+        std::vector<std::pair<UInt64_T, BatchHandler_T<EventClassType>>> m_Handlers{};
+
+        Columns_T m_Columns{};
+        std::vector<std::pair<UInt64_T, ColumnsHandler_T<EventClassType>>> m_ColumnsHandlers{};
+
+        // Copies walked by Dispatch(), kept to reuse their storage
+        std::vector<std::pair<UInt64_T, BatchHandler_T<EventClassType>>> m_DispatchingHandlers{};
+        std::vector<std::pair<UInt64_T, ColumnsHandler_T<EventClassType>>> m_DispatchingColumnsHandlers{};
+    };
+
+    // One batch channel per event type, null if the type has no batch subscribers
+    using BatchChannels_T = std::array<std::unique_ptr<BatchChannelBase>, MAX_EVENT_TYPE_COUNT>;
 
     /**
-     * Unsubscribes the object with the given id from the event type specified.
-     * When that type of event is triggered, the specified handler will no longer be run.
-     * @param subId subscriber unique identifier
-     * @param type type of event to unsubscribe from
+     * Type erased interface of the storage of the last events of a sticky type, one per window
      * */
-    auto Unsubscribe(UInt64_T subId, EventType type) -> void;
+    class StickySlotBase {
+    public:
+        virtual auto Store(const Event& event) -> void = 0;
+        MKT_NODISCARD virtual auto Get(WindowId_T window) -> Event* = 0;
+
+        /**
+         * Returns a copy of the event kept for the window, null if there is none yet
+         * */
+        MKT_NODISCARD virtual auto Copy(WindowId_T window) const -> std::unique_ptr<Event> = 0;
+
+        /**
+         * Drops the event kept for the window
+         * */
+        virtual auto Clear(WindowId_T window) -> void = 0;
+
+        /**
+         * Maps a window id to its entry, ids past MAX_WINDOW_COUNT share the
+         * entry of ANY_WINDOW_ID like they share its handlers when dispatched
+         * */
+        MKT_NODISCARD static constexpr auto GetIndex(WindowId_T window) -> Size_T { return window <= MAX_WINDOW_COUNT ? window : ANY_WINDOW_ID; }
+
+        virtual ~StickySlotBase() = default;
+    };
 
     /**
-     * Unsubscribes the object with the given id from the event category.
-     * When any type of event of the given category is triggered, the specified
-     * handler will no longer be run.
-     * @param subId subscriber unique identifier
-     * @param category event category to unsubscribe from
+     * Holds a copy of the last event of type EventClassType of every window, so the state
+     * of one window is not replaced by the one of another. The copies live inside
+     * the slot, storing a new event or reading the current one never allocates
      * */
-    auto Unsubscribe(UInt64_T subId, EventCategory category) -> void;
+    template<typename EventClassType>
+    class StickySlot : public StickySlotBase {
+    public:
+        auto Store(const Event& event) -> void override {
+            m_LastIndex = GetIndex(event.GetWindowId());
+            m_Values[m_LastIndex].emplace(static_cast<const EventClassType&>(event));
+        }
+
+        MKT_NODISCARD auto Get(WindowId_T window) -> Event* override {
+            auto& value{ m_Values[GetIndex(window)] };
+            return value ? std::addressof(*value) : nullptr;
+        }
+
+        MKT_NODISCARD auto Copy(WindowId_T window) const -> std::unique_ptr<Event> override {
+            const auto& value{ m_Values[GetIndex(window)] };
+            return value ? std::make_unique<EventClassType>(*value) : nullptr;
+        }
+
+        auto Clear(WindowId_T window) -> void override { m_Values[GetIndex(window)].reset(); }
+
+        MKT_NODISCARD auto GetTyped(WindowId_T window) const -> const EventClassType* {
+            const auto& value{ m_Values[GetIndex(window)] };
+            return value ? std::addressof(*value) : nullptr;
+        }
+
+        /**
+         * Returns the last event stored, whatever its window
+         * */
+        MKT_NODISCARD auto GetLastTyped() const -> const EventClassType* { return GetTyped(static_cast<WindowId_T>(m_LastIndex)); }
+
+    private:
+        std::array<std::optional<EventClassType>, MAX_WINDOW_COUNT + 1> m_Values{};
+        Size_T m_LastIndex{};
+    };
+
+    // One slot per sticky event type, null for the types that are not sticky
+    using StickySlots_T = std::array<std::unique_ptr<StickySlotBase>, MAX_EVENT_TYPE_COUNT>;
 
     /**
-     * Adds the given event to the queue of unhandled events
-     * @param event event to be added
+     * Configuration for the slow handler watchdog. Every handler run by ProcessEvents()
+     * is timed, each execution longer than Budget is a strike and a handler reaching
+     * StrikeLimit consecutive strikes is reported. If DemoteSlowHandlers is set, a reported
+     * handler is moved to the background lane from the next ProcessEvents() on, so it sees
+     * the rest of the current pass in the foreground and no event twice. Handlers are
+     * never demoted while the virtual event clock is enabled, as that depends on real time.
+     *
+     * The background lane is a separate queue, not a separate thread. Its events are handled
+     * when ProcessBackgroundEvents() is called, on the thread processing the events. Demotion
+     * takes slow handlers out of the ProcessEvents() pass so the frame is not held up by them,
+     * it does not run them concurrently with it.
      * */
-    inline auto QueueEvent(std::unique_ptr<Event>&& event) -> void {
-        GetEventQueue().push_back(std::move(event));
-    }
+    struct WatchdogSpec {
+        std::chrono::microseconds Budget{ 2000 };
+        UInt32_T StrikeLimit{ 3 };
+        bool DemoteSlowHandlers{ false };
+    };
 
     /**
-     * Can be executed by a publisher to notify a type of event has happened.
-     * @param event event to be triggered
+     * Describes a handler the watchdog has flagged as slow
      * */
-    template<typename EventType, typename... Args>
-    inline auto Trigger(Args&&... args) -> void {
-        QueueEvent(MakeEvent<EventType>(std::forward<Args>(args)...));
-    }
+    struct SlowHandlerReport {
+        UInt64_T SubscriberId{};
+        EventType Type{};
+        UInt32_T Strikes{};
+        std::chrono::nanoseconds WorstTime{};
+        bool Demoted{};
+    };
 
     /**
-     * Execute event handlers
+     * Observer of the event queue, kept by PersistentEventQueue to survive a crash.
+     * OnQueued() sees every event added with QueueEvent(), ProcessEvents() calls
+     * OnProcessingBegin() once it has taken the events of the pass and OnProcessingEnd()
+     * once they are all handled. With deferred set some events of this pass or of an
+     * earlier one wait in the background queue for demoted handlers, they are not handled yet
      * */
-    auto ProcessEvents() -> void;
+    class EventQueueJournal {
+    public:
+        virtual auto OnQueued(const Event& event) -> void = 0;
+        virtual auto OnProcessingBegin() -> void = 0;
+        virtual auto OnProcessingEnd(bool deferred) -> void = 0;
+
+        virtual ~EventQueueJournal() = default;
+    };
 
     /**
-     * Cleanup
+     * Observer of the handlers run by ProcessEvents() and ProcessBackgroundEvents().
+     * OnDispatch() is called right before a type or category handler runs, see DispatchTrace
      * */
-    auto Shutdown() -> void;
+    class DispatchObserver {
+    public:
+        virtual auto OnDispatch(UInt64_T subId, const Event& event) -> void = 0;
+
+        virtual ~DispatchObserver() = default;
+    };
+
+    /**
+     * A query is a request expecting an answer of type Result_T from the single
+     * subscriber registered as its responder, e.g.
+     *      struct WidgetUnderCursorQuery { using Result_T = UInt64_T; double X{}; double Y{}; };
+     * */
+    template<typename QueryType>
+    concept IsQuery = requires { typename QueryType::Result_T; };
+
+    template<typename QueryType>
+        requires IsQuery<QueryType>
+    using QueryHandler_T = std::function<typename QueryType::Result_T(const QueryType&)>;
+
+    /**
+     * Responder of one query type
+     * */
+    template<typename QueryType>
+        requires IsQuery<QueryType>
+    struct QueryResponder {
+        UInt64_T SubscriberId{};
+        QueryHandler_T<QueryType> Handler{};
+    };
+
+    /**
+     * Hands out consecutive indices to the query types, in order of first use
+     * */
+    inline auto NextQueryTypeIndex() -> Size_T {
+        static std::atomic<Size_T> next{};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Returns the index of the query type, the position of its responder in every bus
+     * @returns query type index
+     * */
+    template<typename QueryType>
+        requires IsQuery<QueryType>
+    inline auto GetQueryTypeIndex() -> Size_T {
+        static const Size_T index{ NextQueryTypeIndex() };
+        return index;
+    }
+
+    /**
+     * Number of events a producer thread gathers before publishing them, see QueueEventAsync()
+     * */
+    inline constexpr Size_T ASYNC_EVENT_BATCH_SIZE{ 256 };
+
+    // Defined with the event bus implementation
+    struct AsyncEventQueue;
+    struct FrameTags;
+
+    struct EventBusSpec {
+        // Shown in the messages about the bus
+        std::string Name{};
+
+        WatchdogSpec Watchdog{};
+    };
+
+    /**
+     * Event queue together with everything needed to deliver its events: subscribers,
+     * dispatch table, batch and named channels, sticky slots, query responders, watchdog
+     * policy, journal and dispatch observer. Buses share none of it, so each subsystem can
+     * have its own and process it at its own rate, on its own thread, without contending
+     * with the others. The EventManager free functions work on the default bus, see GetDefaultEventBus().
+     *
+     * A bus bound to a thread may only be processed on that thread, and events queued with
+     * QueueEvent() from any other thread take the QueueEventAsync() path and are published right
+     * away, so producers do not need to know where the bus runs.
+     *
+     * From any thread, on every bus: Subscribe(), SubscribeWindow(), Unsubscribe(), UnsubscribeWindow(),
+     * QueueEventAsync(), TriggerAsync(), FlushAsyncEvents(), QueueQuery(), QueryAsync() and ReleaseWindow().
+     * QueueEvent() and Trigger() too on a bound bus, and a bound bus hands the handlers subscribed from other
+     * threads to its own thread, see Subscribe(). Everything else belongs to the thread processing the bus:
+     * batch, columns and channel subscriptions, publishing on channels, responders and Query(), sticky types,
+     * SeedStickyWindow(), Latest() and LatestWindow(), and the watchdog. A bound bus throws when those are
+     * called from another thread, an unbound one, like the default bus, can not tell. The accessors to the
+     * internals (GetEventQueue(), GetDispatchTable(), ...) belong to that thread too but are not checked,
+     * the references they return outlive the call. Coroutines waiting with NextEvent() are resumed by the default bus only.
+     * */
+    class EventBus {
+    public:
+        /**
+         * Creates an empty bus, not bound to any thread
+         * @param spec bus configuration
+         * */
+        explicit EventBus(EventBusSpec spec = {});
+
+        EventBus(const EventBus&) = delete;
+        auto operator=(const EventBus&) -> EventBus& = delete;
+
+        /**
+         * Binds the bus to the thread, a default constructed id unbinds it
+         * @param thread thread processing the bus
+         * */
+        auto BindToThread(std::thread::id thread) -> void { m_Thread.store(thread, std::memory_order_relaxed); }
+
+        /**
+         * Binds the bus to the calling thread
+         * */
+        auto BindToCurrentThread() -> void { BindToThread(std::this_thread::get_id()); }
+
+        /**
+         * Returns true if the bus is not bound or is bound to the calling thread
+         * */
+        MKT_NODISCARD auto IsOnBoundThread() const -> bool {
+            const auto thread{ m_Thread.load(std::memory_order_relaxed) };
+            return thread == std::thread::id{} || thread == std::this_thread::get_id();
+        }
+
+        /**
+         * Returns the name of the bus, shown in the messages about it
+         * @returns bus name
+         * */
+        MKT_NODISCARD auto GetName() const -> const std::string& { return m_Spec.Name; }
+
+        /**
+         * Returns the queue of pending events
+         * @returns queue of pending events
+         * */
+        MKT_NODISCARD auto GetEventQueue() -> EventQueue_T& { return m_EventQueue; }
+
+        /**
+         * Returns the queue of events that still have to be delivered to demoted handlers
+         * @returns queue of events pending for demoted handlers
+         * */
+        MKT_NODISCARD auto GetBackgroundQueue() -> EventQueue_T& { return m_BackgroundQueue; }
+
+        /**
+         * Returns the queue of pending events published on named channels
+         * @returns queue of pending channel events
+         * */
+        MKT_NODISCARD auto GetChannelQueue() -> ChannelQueue_T& { return m_ChannelQueue; }
+
+        /**
+         * Returns the registry of event subscribers
+         * @returns event subscribers
+         * */
+        MKT_NODISCARD auto GetSubscribers() -> SubscriberRegistry& { return m_Subscribers; }
+
+        /**
+         * Returns the dispatch table
+         * @returns dispatch table
+         * */
+        MKT_NODISCARD auto GetDispatchTable() -> DispatchTable& { return m_DispatchTable; }
+
+        /**
+         * Returns the router holding the channel subscriptions
+         * @returns topic router
+         * */
+        MKT_NODISCARD auto GetTopicRouter() -> TopicRouter& { return m_TopicRouter; }
+
+        /**
+         * Returns the batch channels indexed by event type
+         * @returns batch channels
+         * */
+        MKT_NODISCARD auto GetBatchChannels() -> BatchChannels_T& { return m_BatchChannels; }
+
+        /**
+         * Returns the sticky slots indexed by event type
+         * @returns sticky slots
+         * */
+        MKT_NODISCARD auto GetStickySlots() -> StickySlots_T& { return m_StickySlots; }
+
+        /**
+         * Returns the journal of the event queue, null unless one is installed
+         * @returns event queue journal
+         * */
+        MKT_NODISCARD auto GetEventQueueJournal() -> std::unique_ptr<EventQueueJournal>& { return m_Journal; }
+
+        /**
+         * Returns the dispatch observer, null unless one is installed. Not owned by the bus
+         * @returns dispatch observer
+         * */
+        MKT_NODISCARD auto GetDispatchObserver() -> DispatchObserver*& { return m_DispatchObserver; }
+
+        /**
+         * Returns the current watchdog configuration
+         * @returns watchdog configuration
+         * */
+        MKT_NODISCARD auto GetWatchdogSpec() -> WatchdogSpec& {
+            CheckBoundThread("Watchdog used");
+            return m_Spec.Watchdog;
+        }
+
+        /**
+         * Replaces the watchdog configuration. Takes effect from the next handler execution
+         * @param spec new watchdog configuration
+         * */
+        auto SetWatchdogSpec(const WatchdogSpec& spec) -> void {
+            CheckBoundThread("Watchdog used");
+            m_Spec.Watchdog = spec;
+        }
+
+        /**
+         * Returns the responder of the query type on this bus, created on first use
+         * @returns query responder, its handler is empty if nobody responds to the query
+         * */
+        template<typename QueryType>
+            requires IsQuery<QueryType>
+        MKT_NODISCARD auto GetQueryResponder() -> QueryResponder<QueryType>& {
+            CheckBoundThread("Query responders used");
+
+            const Size_T index{ GetQueryTypeIndex<QueryType>() };
+
+            if (index >= m_QueryResponders.size()) {
+                m_QueryResponders.resize(index + 1);
+            }
+
+            auto& responder{ m_QueryResponders[index] };
+
+            if (!responder) {
+                responder = std::make_shared<QueryResponder<QueryType>>();
+            }
+
+            return *static_cast<QueryResponder<QueryType>*>(responder.get());
+        }
+
+        /**
+         * Subscribes an object to be notified when a type of event has happened. May be called
+         * from any thread. On the thread processing the bus the change is seen by the next event
+         * ProcessEvents() dispatches and the last sticky events are delivered right away. From another
+         * thread of a bound bus the handler is added, and given its sticky events, by the bus thread
+         * at the start of the next ProcessEvents(), so it never runs on two threads at once
+         * @param subId identifier for the subscriber object
+         * @param type type of event the subscriber is interested in
+         * @param handler event handler from the subscriber
+         * */
+        auto Subscribe(UInt64_T subId, EventType type, EventHandler_T&& handler) -> void {
+            SubscribeWindow(subId, ANY_WINDOW_ID, type, std::move(handler));
+        }
+
+        /**
+         * Subscribes an object to be notified when any event of the given category has happened.
+         * Category handlers are run once the type handlers have seen the whole queue
+         * @param subId identifier for the subscriber object
+         * @param category categories the subscriber is interested in
+         * @param handler event handler from the subscriber
+         * */
+        auto Subscribe(UInt64_T subId, EventCategory category, EventHandler_T&& handler) -> void {
+            SubscribeWindow(subId, ANY_WINDOW_ID, category, std::move(handler));
+        }
+
+        /**
+         * Same as Subscribe() for the events of a single window
+         * @param subId identifier for the subscriber object
+         * @param window window the subscriber is interested in
+         * @param type type of event the subscriber is interested in
+         * @param handler event handler from the subscriber
+         * */
+        auto SubscribeWindow(UInt64_T subId, WindowId_T window, EventType type, EventHandler_T&& handler) -> void {
+            AddSubscription(subId, std::make_shared<EventHandlerWrapper>(type, std::move(handler), window));
+        }
+
+        /**
+         * Same as Subscribe() for the events of the category coming from a single window
+         * @param subId identifier for the subscriber object
+         * @param window window the subscriber is interested in
+         * @param category categories the subscriber is interested in
+         * @param handler event handler from the subscriber
+         * */
+        auto SubscribeWindow(UInt64_T subId, WindowId_T window, EventCategory category, EventHandler_T&& handler) -> void {
+            AddSubscription(subId, std::make_shared<EventHandlerWrapper>(category, std::move(handler), window));
+        }
+
+        /**
+         * Removes the handlers the object has for the event type. May be called from any thread
+         * @param subId subscriber unique identifier
+         * @param type type of event to unsubscribe from
+         * */
+        auto Unsubscribe(UInt64_T subId, EventType type) -> void;
+
+        /**
+         * Removes the handlers the object has for the event category. May be called from any thread
+         * @param subId subscriber unique identifier
+         * @param category event category to unsubscribe from
+         * */
+        auto Unsubscribe(UInt64_T subId, EventCategory category) -> void;
+
+        /**
+         * Removes the handlers the object has for the events of the window. May be called from any thread
+         * @param subId subscriber unique identifier
+         * @param window window to unsubscribe from
+         * */
+        auto UnsubscribeWindow(UInt64_T subId, WindowId_T window) -> void;
+
+        /**
+         * Subscribes an object to receive, once per ProcessEvents(), all the events
+         * of type EventClassType queued during the frame as a single contiguous span
+         * @param subId identifier for the subscriber object
+         * @param handler batch handler from the subscriber
+         * */
+        template<typename EventClassType>
+            requires IsEventDerived<EventClassType> && HasStaticGetType<EventClassType>
+        auto SubscribeBatch(UInt64_T subId, BatchHandler_T<EventClassType>&& handler) -> void {
+            GetBatchChannel<EventClassType>().Subscribe(subId, std::move(handler));
+        }
+
+        /**
+         * Subscribes an object to receive, once per ProcessEvents(), the events of type
+         * EventClassType queued during the frame in structure of arrays form
+         * @param subId identifier for the subscriber object
+         * @param handler columns handler from the subscriber
+         * */
+        template<typename EventClassType>
+            requires HasStaticGetType<EventClassType> && HasEventColumns<EventClassType>
+        auto SubscribeColumns(UInt64_T subId, ColumnsHandler_T<EventClassType>&& handler) -> void {
+            GetBatchChannel<EventClassType>().SubscribeColumns(subId, std::move(handler));
+        }
+
+        /**
+         * Removes the batch and columns handlers the object has for the event type
+         * @param subId subscriber unique identifier
+         * @param type type of event to unsubscribe from
+         * */
+        auto UnsubscribeBatch(UInt64_T subId, EventType type) -> void;
+
+        /**
+         * Returns the identifier of a named channel, registering it on first use
+         * @param path channel name
+         * @returns channel identifier
+         * */
+        MKT_NODISCARD auto GetChannel(std::string_view path) -> ChannelId_T {
+            CheckBoundThread("Channel registered");
+            return m_TopicRouter.GetChannel(path);
+        }
+
+        /**
+         * Subscribes an object to the channels matching the given pattern
+         * @param subId identifier for the subscriber object
+         * @param pattern channel pattern, see TopicRouter
+         * @param handler event handler from the subscriber
+         * */
+        auto SubscribeChannel(UInt64_T subId, std::string_view pattern, EventHandler_T&& handler) -> void {
+            CheckBoundThread("Channel subscription changed");
+            m_TopicRouter.Subscribe(subId, pattern, std::move(handler));
+        }
+
+        /**
+         * Unsubscribes the object from the given channel pattern
+         * @param subId subscriber unique identifier
+         * @param pattern pattern used when subscribing
+         * */
+        auto UnsubscribeChannel(UInt64_T subId, std::string_view pattern) -> void {
+            CheckBoundThread("Channel subscription changed");
+            m_TopicRouter.Unsubscribe(subId, pattern);
+        }
+
+        /**
+         * Makes EventClassType sticky or not, see EventManager::SetSticky()
+         * @param sticky true to keep the last event of the type, false to stop and drop the kept events
+         * */
+        template<typename EventClassType>
+            requires IsEventDerived<EventClassType> && HasStaticGetType<EventClassType>
+        auto SetSticky(bool sticky = true) -> void {
+            CheckBoundThread("Sticky type changed");
+
+            auto& slot{ m_StickySlots[static_cast<Size_T>(EventClassType::GetStaticType())] };
+            std::scoped_lock lock{ m_StickyMutex };
+
+            if (sticky && !slot) {
+                slot = std::make_unique<StickySlot<EventClassType>>();
+            }
+            else if (!sticky) {
+                slot.reset();
+            }
+        }
+
+        /**
+         * Sets the last event of a sticky type without dispatching it, does nothing if the type is not sticky
+         * @param window window the event belongs to
+         * @param args arguments to construct the event
+         * */
+        template<typename EventClassType, typename... Args>
+            requires IsEventDerived<EventClassType> && HasStaticGetType<EventClassType>
+        auto SeedStickyWindow(WindowId_T window, Args&&... args) -> void {
+            CheckBoundThread("Sticky event seeded");
+
+            EventClassType event{ std::forward<Args>(args)... };
+            event.SetWindowId(window);
+
+            std::scoped_lock lock{ m_StickyMutex };
+
+            if (auto& slot{ m_StickySlots[static_cast<Size_T>(EventClassType::GetStaticType())] }) {
+                slot->Store(event);
+            }
+        }
+
+        /**
+         * Returns the last processed event of a sticky type of any window, valid until the next ProcessEvents()
+         * @returns last event of the type, null if the type is not sticky or no event was processed yet
+         * */
+        template<typename EventClassType>
+            requires IsEventDerived<EventClassType> && HasStaticGetType<EventClassType>
+        MKT_NODISCARD auto Latest() const -> const EventClassType* {
+            CheckBoundThread("Sticky event read");
+
+            // Only the bus thread writes the slots, see m_StickyMutex
+            const auto& slot{ m_StickySlots[static_cast<Size_T>(EventClassType::GetStaticType())] };
+            return slot ? static_cast<const StickySlot<EventClassType>&>(*slot).GetLastTyped() : nullptr;
+        }
+
+        /**
+         * Returns the last processed event of a sticky type for the window, valid until the next ProcessEvents()
+         * @param window window the event belongs to
+         * @returns last event of the type for the window, null if the type is not sticky or there is none yet
+         * */
+        template<typename EventClassType>
+            requires IsEventDerived<EventClassType> && HasStaticGetType<EventClassType>
+        MKT_NODISCARD auto LatestWindow(WindowId_T window) const -> const EventClassType* {
+            CheckBoundThread("Sticky event read");
+
+            const auto& slot{ m_StickySlots[static_cast<Size_T>(EventClassType::GetStaticType())] };
+            return slot ? static_cast<const StickySlot<EventClassType>&>(*slot).GetTyped(window) : nullptr;
+        }
+
+        /**
+         * Forgets a window whose id is given back, see EventManager::ReleaseWindow()
+         * @param window id of the released window
+         * */
+        auto ReleaseWindow(WindowId_T window) -> void;
+
+        /**
+         * Registers the subscriber as the responder of the query type. Throws if it already has one
+         * @param subId identifier for the subscriber object
+         * @param handler function computing the answer to a query
+         * */
+        template<typename QueryType>
+            requires IsQuery<QueryType>
+        auto Respond(UInt64_T subId, QueryHandler_T<QueryType>&& handler) -> void {
+            auto& responder{ GetQueryResponder<QueryType>() };
+
+            if (responder.Handler) {
+                MKT_THROW_RUNTIME_ERROR(fmt::format("Query already has a responder (subscriber {})", responder.SubscriberId));
+            }
+
+            responder = { subId, std::move(handler) };
+        }
+
+        /**
+         * Removes the subscriber as responder of the query type, does nothing if it is not the responder
+         * @param subId subscriber unique identifier
+         * */
+        template<typename QueryType>
+            requires IsQuery<QueryType>
+        auto StopResponding(UInt64_T subId) -> void {
+            auto& responder{ GetQueryResponder<QueryType>() };
+
+            if (responder.Handler && responder.SubscriberId == subId) {
+                responder = {};
+            }
+        }
+
+        /**
+         * Sends the query to its responder, which runs right away on the calling thread
+         * @param query query to be answered
+         * @returns answer of the responder, empty if the query has no responder
+         * */
+        template<typename QueryType>
+            requires IsQuery<QueryType>
+        MKT_NODISCARD auto Query(const QueryType& query) -> std::optional<typename QueryType::Result_T> {
+            auto& responder{ GetQueryResponder<QueryType>() };
+
+            if (!responder.Handler) {
+                return std::nullopt;
+            }
+
+            return responder.Handler(query);
+        }
+
+        /**
+         * Same as Query() from any thread, answered during the next ProcessEvents()
+         * @param query query to be answered
+         * @returns future holding the answer, empty if the query has no responder by then
+         * */
+        template<typename QueryType>
+            requires IsQuery<QueryType>
+        MKT_NODISCARD auto QueryAsync(QueryType query) -> std::future<std::optional<typename QueryType::Result_T>> {
+            auto promise{ std::make_shared<std::promise<std::optional<typename QueryType::Result_T>>>() };
+            auto result{ promise->get_future() };
+
+            QueueQuery([this, promise, query = std::move(query)]() -> void {
+                try {
+                    promise->set_value(Query(query));
+                }
+                catch (...) {
+                    promise->set_exception(std::current_exception());
+                }
+            });
+
+            return result;
+        }
+
+        /**
+         * Adds a query to the ones resolved by the next ProcessEvents(). Thread safe
+         * @param resolve function answering the query and fulfilling its promise
+         * */
+        auto QueueQuery(std::function<void()>&& resolve) -> void;
+
+        /**
+         * Adds the event to the queue. From a thread other than the one a bound bus is bound
+         * to, the event is published right away as a batch of its own; producers queuing many
+         * events at once should use QueueEventAsync() and FlushAsyncEvents() to batch them
+         * @param event event to be added
+         * */
+        auto QueueEvent(std::unique_ptr<Event>&& event) -> void {
+            // Producers on other threads do not touch the queue of a bound bus
+            if (!IsOnBoundThread()) {
+                QueueEventAsync(std::move(event));
+                FlushAsyncEvents();
+                return;
+            }
+
+            if (m_Journal) {
+                m_Journal->OnQueued(*event);
+            }
+
+            m_EventQueue.push_back(std::move(event));
+        }
+
+        /**
+         * Creates an event and queues it, see QueueEvent()
+         * */
+        template<typename EventType, typename... Args>
+        auto Trigger(Args&&... args) -> void {
+            QueueEvent(MakeEvent<EventType>(std::forward<Args>(args)...));
+        }
+
+        /**
+         * Same as Trigger() for an event coming from the given window
+         * @param window id of the window the event comes from
+         * */
+        template<typename EventType, typename... Args>
+        auto TriggerWindow(WindowId_T window, Args&&... args) -> void {
+            auto event{ MakeEvent<EventType>(std::forward<Args>(args)...) };
+            event->SetWindowId(window);
+            QueueEvent(std::move(event));
+        }
+
+        /**
+         * Adds the event to the buffer of the calling thread, published once it holds
+         * ASYNC_EVENT_BATCH_SIZE events, on FlushAsyncEvents() or when the thread exits
+         * @param event event to be added
+         * */
+        auto QueueEventAsync(std::unique_ptr<Event>&& event) -> void;
+
+        /**
+         * Creates an event and queues it, see QueueEventAsync()
+         * */
+        template<typename EventType, typename... Args>
+        auto TriggerAsync(Args&&... args) -> void {
+            QueueEventAsync(MakeEvent<EventType>(std::forward<Args>(args)...));
+        }
+
+        /**
+         * Publishes the events the calling thread queued with QueueEventAsync() so far
+         * */
+        auto FlushAsyncEvents() -> void;
+
+        /**
+         * Adds the event to the queue of events published on a named channel
+         * @param channel channel identifier, see GetChannel()
+         * @param event event to be added
+         * */
+        auto PublishEvent(ChannelId_T channel, std::unique_ptr<Event>&& event) -> void {
+            CheckBoundThread("Channel event published");
+            m_ChannelQueue.push_back({ channel, std::move(event) });
+        }
+
+        /**
+         * Creates an event and publishes it on a named channel, see PublishEvent()
+         * @param channel channel identifier, see GetChannel()
+         * */
+        template<typename EventType, typename... Args>
+        auto Publish(ChannelId_T channel, Args&&... args) -> void {
+            PublishEvent(channel, MakeEvent<EventType>(std::forward<Args>(args)...));
+        }
+
+        /**
+         * Runs the handlers over the queued events, the published batches and the channel events.
+         * Throws when called from a thread other than the one the bus is bound to
+         * */
+        auto ProcessEvents() -> void;
+
+        /**
+         * Runs demoted handlers on the events ProcessEvents() left in the background lane
+         * until the budget is used up, at least one event per call if any is pending
+         * @param budget maximum time to spend running demoted handlers
+         * */
+        auto ProcessBackgroundEvents(std::chrono::microseconds budget) -> void;
+
+        /**
+         * Returns every handler the watchdog has flagged as slow so far
+         * @returns list of slow handler reports
+         * */
+        MKT_NODISCARD auto GetSlowHandlerReports() -> std::vector<SlowHandlerReport>;
+
+        /**
+         * Clears the watchdog state of every handler, see EventManager::ResetWatchdog()
+         * */
+        auto ResetWatchdog() -> void;
+
+        /**
+         * Drops the events, subscribers, channels and responders of the bus, the journal is closed first
+         * */
+        auto Shutdown() -> void;
+
+        ~EventBus();
+
+    private:
+        struct PendingSubscription {
+            UInt64_T SubscriberId{};
+            HandlerPtr_T Handler{};
+        };
+
+        template<typename EventClassType>
+        MKT_NODISCARD auto GetBatchChannel() -> BatchChannel<EventClassType>& {
+            CheckBoundThread("Batch subscription changed");
+
+            auto& channel{ m_BatchChannels[static_cast<Size_T>(EventClassType::GetStaticType())] };
+
+            if (!channel) {
+                channel = std::make_unique<BatchChannel<EventClassType>>();
+            }
+
+            return static_cast<BatchChannel<EventClassType>&>(*channel);
+        }
+
+        auto CheckBoundThread(std::string_view operation) const -> void;
+        auto AddSubscription(UInt64_T subId, HandlerPtr_T&& wrapper) -> void;
+        auto PublishPendingSubscriptions() -> void;
+        auto ClearReleasedWindows() -> void;
+        auto ReplaySticky(EventHandlerWrapper& wrapper) -> void;
+
+        /**
+         * Removes the handlers of the subscriber accepted by the filter, published or still pending
+         * */
+        template<typename FilterFuncType>
+        auto RemoveSubscriptions(UInt64_T subId, const FilterFuncType& filter) -> void {
+            // Held while the registry changes, the bus thread moves pending handlers into it under the same lock
+            std::scoped_lock lock{ m_PendingSubscriptionsMutex };
+
+            std::erase_if(m_PendingSubscriptions, [&](const PendingSubscription& entry) -> bool { return entry.SubscriberId == subId && filter(entry.Handler); });
+            m_Subscribers.Remove(subId, filter);
+        }
+        auto ExecWatched(UInt64_T subId, EventHandlerWrapper& wrapper, Event& event) -> void;
+        auto ResolvePendingQueries() -> void;
+        auto DispatchCategoryHandlers() -> void;
+        auto DispatchChannelEvents() -> void;
+
+        template<typename FunctionType>
+        auto TakeAsyncEvents(FunctionType&& function) -> void;
+
+        MKT_NODISCARD auto IsDefault() const -> bool;
+
+    private:
+        EventBusSpec m_Spec{};
+        std::atomic<std::thread::id> m_Thread{};
+
+        EventQueue_T m_EventQueue{};
+        EventQueue_T m_BackgroundQueue{};
+        ChannelQueue_T m_ChannelQueue{};
+
+        DispatchTable m_DispatchTable{};
+        SubscriberRegistry m_Subscribers{ m_DispatchTable };
+        TopicRouter m_TopicRouter{};
+        BatchChannels_T m_BatchChannels{};
+        StickySlots_T m_StickySlots{};
+
+        // Only the bus thread writes the slots of a bound bus. Guards their content for
+        // the subscribers an unbound bus can not tell apart from its processing thread
+        std::mutex m_StickyMutex{};
+
+        // Windows released from another thread, one bit per id, their sticky events
+        // are dropped by the bus thread at the start of the next pass
+        std::atomic<UInt32_T> m_ReleasedWindows{};
+
+        // Handlers subscribed from another thread, added by the next ProcessEvents()
+        std::mutex m_PendingSubscriptionsMutex{};
+        std::vector<PendingSubscription> m_PendingSubscriptions{};
+        std::vector<PendingSubscription> m_PublishingSubscriptions{};
+
+        // Indexed by GetQueryTypeIndex()
+        std::vector<std::shared_ptr<void>> m_QueryResponders{};
+
+        // Queries waiting for the next ProcessEvents(), filled from any thread
+        std::mutex m_QueriesMutex{};
+        std::vector<std::function<void()>> m_PendingQueries{};
+
+        // Shared with the producer threads, which may outlive the bus
+        std::shared_ptr<AsyncEventQueue> m_AsyncQueue{};
+
+        // Handlers the watchdog demoted during the current pass, demoted once it is over
+        std::vector<EventHandlerWrapper*> m_PendingDemotions{};
+
+        // Storage reused from one ProcessEvents() to the next
+        std::unique_ptr<FrameTags> m_FrameTags{};
+        std::vector<std::function<void()>> m_ResolvingQueries{};
+        ChannelQueue_T m_DeliveringChannelEvents{};
+
+        // Copy of the handlers of the channel being delivered, kept to reuse its storage
+        std::vector<TopicRouter::SubscriptionPtr_T> m_DeliveringChannelHandlers{};
+
+        std::unique_ptr<EventQueueJournal> m_Journal{};
+        DispatchObserver* m_DispatchObserver{};
+    };
+
+    /**
+     * Returns the bus the free functions of EventManager work on. Not bound to any thread
+     * @returns default event bus
+     * */
+    inline auto GetDefaultEventBus() -> EventBus& {
+        static EventBus bus{ { "default" } };
+        return bus;
+    }
+
+    /**
+     * Returns the queue of pending events
+     * @returns queue of pending events
+     * */
+    inline auto GetEventQueue() -> EventQueue_T& {
+        return GetDefaultEventBus().GetEventQueue();
+    }
+
+    /**
+     * Returns the journal of the event queue, null unless one is installed
+     * @returns event queue journal
+     * */
+    inline auto GetEventQueueJournal() -> std::unique_ptr<EventQueueJournal>& {
+        return GetDefaultEventBus().GetEventQueueJournal();
+    }
+
+    /**
+     * Returns the dispatch observer, null unless one is installed. Not owned by the event manager
+     * @returns dispatch observer
+     * */
+    inline auto GetDispatchObserver() -> DispatchObserver*& {
+        return GetDefaultEventBus().GetDispatchObserver();
+    }
+
+    /**
+     * Returns the queue of events that still have to be delivered to demoted handlers.
+     * Events are moved here by ProcessEvents() and consumed by ProcessBackgroundEvents()
+     * @returns queue of events pending for demoted handlers
+     * */
+    inline auto GetBackgroundQueue() -> EventQueue_T& {
+        return GetDefaultEventBus().GetBackgroundQueue();
+    }
+
+    /**
+     * Returns the current watchdog configuration
+     * @returns watchdog configuration
+     * */
+    inline auto GetWatchdogSpec() -> WatchdogSpec& {
+        return GetDefaultEventBus().GetWatchdogSpec();
+    }
+
+    /**
+     * Replaces the watchdog configuration. Takes effect from the next handler execution
+     * @param spec new watchdog configuration
+     * */
+    inline auto SetWatchdogSpec(const WatchdogSpec& spec) -> void {
+        GetDefaultEventBus().SetWatchdogSpec(spec);
+    }
+
+    /**
+     * Returns the dispatch table
+     * @returns dispatch table
+     * */
+    inline auto GetDispatchTable() -> DispatchTable& {
+        return GetDefaultEventBus().GetDispatchTable();
+    }
+
+    /**
+     * Returns the registry of event subscribers
+     * @returns event subscribers
+     * */
+    inline auto GetSubscribers() -> SubscriberRegistry& {
+        return GetDefaultEventBus().GetSubscribers();
+    }
+
+    /**
+     * Returns the queue of pending events published on named channels
+     * @returns queue of pending channel events
+     * */
+    inline auto GetChannelQueue() -> ChannelQueue_T& {
+        return GetDefaultEventBus().GetChannelQueue();
+    }
+
+    /**
+     * Returns the router holding the channel subscriptions
+     * @returns topic router
+     * */
+    inline auto GetTopicRouter() -> TopicRouter& {
+        return GetDefaultEventBus().GetTopicRouter();
+    }
+
+    /**
+     * Returns the sticky slots indexed by event type
+     * @returns sticky slots
+     * */
+    inline auto GetStickySlots() -> StickySlots_T& {
+        return GetDefaultEventBus().GetStickySlots();
+    }
+
+    /**
+     * Makes EventClassType sticky or not. The last processed event of a sticky type is
+     * kept for every window and handed to every new subscriber of that type right when it
+     * subscribes, so state-like events (e.g. the window size) are known without waiting for
+     * the next change. A handler of one window gets the event of that window, a handler of
+     * every window gets the last event of each window. The kept events can also be read
+     * at any time with Latest() and LatestWindow().
+     * @param sticky true to keep the last event of the type, false to stop and drop the kept events
+     * */
+    template<typename EventClassType>
+        requires IsEventDerived<EventClassType> && HasStaticGetType<EventClassType>
+    inline auto SetSticky(bool sticky = true) -> void {
+        GetDefaultEventBus().SetSticky<EventClassType>(sticky);
+    }
+
+    /**
+     * Sets the last event of a sticky type without dispatching it, for state that exists
+     * before any event reports it (e.g. the initial size of a window). Subscribers added
+     * later receive it like any sticky event, current subscribers are not called.
+     * Does nothing if the type is not sticky
+     * @param window window the event belongs to
+     * @param args arguments to construct the event
+     * */
+    template<typename EventClassType, typename... Args>
+        requires IsEventDerived<EventClassType> && HasStaticGetType<EventClassType>
+    inline auto SeedStickyWindow(WindowId_T window, Args&&... args) -> void {
+        GetDefaultEventBus().SeedStickyWindow<EventClassType>(window, std::forward<Args>(args)...);
+    }
+
+    /**
+     * Returns the last processed event of a sticky type. Does not allocate. Meant for the
+     * thread processing the events, the event is overwritten by the next ProcessEvents()
+     * @returns last event of the type, null if the type is not sticky or no event was processed yet
+     * */
+    template<typename EventClassType>
+        requires IsEventDerived<EventClassType> && HasStaticGetType<EventClassType>
+    MKT_NODISCARD inline auto Latest() -> const EventClassType* {
+        return GetDefaultEventBus().Latest<EventClassType>();
+    }
+
+    /**
+     * Returns the last processed event of a sticky type for one window. Same rules as Latest()
+     * @param window window the event belongs to
+     * @returns last event of the type for the window, null if the type is not sticky or there is none yet
+     * */
+    template<typename EventClassType>
+        requires IsEventDerived<EventClassType> && HasStaticGetType<EventClassType>
+    MKT_NODISCARD inline auto LatestWindow(WindowId_T window) -> const EventClassType* {
+        return GetDefaultEventBus().LatestWindow<EventClassType>(window);
+    }
+
+    /**
+     * Forgets a window before its id is reused: removes every handler subscribed for
+     * that window only and drops the sticky events kept for it, so a later window
+     * with the same id starts without them. Handlers of every window are kept.
+     * Safe to call from any thread
+     * @param window id of the released window, nothing is done for ANY_WINDOW_ID
+     * */
+    inline auto ReleaseWindow(WindowId_T window) -> void {
+        GetDefaultEventBus().ReleaseWindow(window);
+    }
+
+    /**
+     * Returns the batch channels indexed by event type
+     * @returns batch channels
+     * */
+    inline auto GetBatchChannels() -> BatchChannels_T& {
+        return GetDefaultEventBus().GetBatchChannels();
+    }
+
+    /**
+     * Returns the responder of the query type, one per type, with no lookup involved
+     * @returns query responder, its handler is empty if nobody responds to the query
+     * */
+    template<typename QueryType>
+        requires IsQuery<QueryType>
+    inline auto GetQueryResponder() -> QueryResponder<QueryType>& {
+        return GetDefaultEventBus().GetQueryResponder<QueryType>();
+    }
+
+    /**
+     * Adds a query to the ones resolved by the next ProcessEvents(). Thread safe
+     * @param resolve function answering the query and fulfilling its promise
+     * */
+    inline auto QueueQuery(std::function<void()>&& resolve) -> void {
+        GetDefaultEventBus().QueueQuery(std::move(resolve));
+    }
+
+    /**
+     * Subscribes an object to be notified when a type of event has happened.
+     * Subscribe() and Unsubscribe() may be called from any thread, the change is
+     * seen by the next event ProcessEvents() dispatches. The last sticky event is
+     * delivered right away on the calling thread, as a copy taken under a lock
+     * @param subId identifier for the subscriber object
+     * @param handler event handler from the subscriber
+     * */
+    inline auto Subscribe(UInt64_T subId, EventType type, EventHandler_T&& handler) -> void {
+        GetDefaultEventBus().Subscribe(subId, type, std::move(handler));
+    }
+
+    /**
+     * Subscribes an object to be notified when any event of the given category has happened.
+     * Category handlers are run once the type handlers have seen the whole queue, matching
+     * is done for the whole frame at once, see EventFilter::MatchCategories()
+     * @param subId identifier for the subscriber object
+     * @param category categories the subscriber is interested in
+     * @param handler event handler from the subscriber
+     * */
+    inline auto Subscribe(UInt64_T subId, EventCategory category, EventHandler_T&& handler) -> void {
+        GetDefaultEventBus().Subscribe(subId, category, std::move(handler));
+    }
+
+    /**
+     * Same as Subscribe() for the events of a single window, see Window::GetId(). The handler is
+     * kept in lists of that window, events of other windows do not even walk over it
+     * @param subId identifier for the subscriber object
+     * @param window window the subscriber is interested in
+     * @param type type of event the subscriber is interested in
+     * @param handler event handler from the subscriber
+     * */
+    inline auto SubscribeWindow(UInt64_T subId, WindowId_T window, EventType type, EventHandler_T&& handler) -> void {
+        GetDefaultEventBus().SubscribeWindow(subId, window, type, std::move(handler));
+    }
+
+    /**
+     * Same as Subscribe() for the events of the category coming from a single window
+     * @param subId identifier for the subscriber object
+     * @param window window the subscriber is interested in
+     * @param category categories the subscriber is interested in
+     * @param handler event handler from the subscriber
+     * */
+    inline auto SubscribeWindow(UInt64_T subId, WindowId_T window, EventCategory category, EventHandler_T&& handler) -> void {
+        GetDefaultEventBus().SubscribeWindow(subId, window, category, std::move(handler));
+    }
+
+    /**
+     * Subscribes an object to receive, once per ProcessEvents(), all the events
+     * of type EventClassType queued during the frame as a single contiguous span.
+     * Meant for consumers that aggregate high frequency events (e.g. mouse moves)
+     * and do not want to pay a handler call per event.
+     * @param subId identifier for the subscriber object
+     * @param handler batch handler from the subscriber
+     * */
+    template<typename EventClassType>
+        requires IsEventDerived<EventClassType> && HasStaticGetType<EventClassType>
+    inline auto SubscribeBatch(UInt64_T subId, BatchHandler_T<EventClassType>&& handler) -> void {
+        GetDefaultEventBus().SubscribeBatch<EventClassType>(subId, std::move(handler));
+    }
+
+    /**
+     * Subscribes an object to receive, once per ProcessEvents(), the events of type
+     * EventClassType queued during the frame in structure of arrays form (see EventColumns).
+     * Only available for event types with a columnar representation.
+     * @param subId identifier for the subscriber object
+     * @param handler columns handler from the subscriber
+     * */
+    template<typename EventClassType>
+        requires HasStaticGetType<EventClassType> && HasEventColumns<EventClassType>
+    inline auto SubscribeColumns(UInt64_T subId, ColumnsHandler_T<EventClassType>&& handler) -> void {
+        GetDefaultEventBus().SubscribeColumns<EventClassType>(subId, std::move(handler));
+    }
+
+    /**
+     * Removes the batch and columns handlers the object with the given id has for the event type specified.
+     * @param subId subscriber unique identifier
+     * @param type type of event to unsubscribe from
+     * */
+    inline auto UnsubscribeBatch(UInt64_T subId, EventType type) -> void {
+        GetDefaultEventBus().UnsubscribeBatch(subId, type);
+    }
+
+    /**
+     * Returns the identifier of a named channel such as "input/keyboard/pressed",
+     * registering it on first use. Publishers are expected to keep the identifier
+     * around instead of looking it up on every publish.
+     * @param path channel name
+     * @returns channel identifier
+     * */
+    inline auto GetChannel(std::string_view path) -> ChannelId_T {
+        return GetDefaultEventBus().GetChannel(path);
+    }
+
+    /**
+     * Subscribes an object to the channels matching the given pattern. '*' matches one
+     * segment of the channel name and a trailing '**' any number of them, so "net/session" followed
+     * by a '**' segment matches every channel under "net/session".
+     * Matching happens here and when a channel is first used, never when publishing.
+     * @param subId identifier for the subscriber object
+     * @param pattern channel pattern
+     * @param handler event handler from the subscriber
+     * */
+    inline auto SubscribeChannel(UInt64_T subId, std::string_view pattern, EventHandler_T&& handler) -> void {
+        GetDefaultEventBus().SubscribeChannel(subId, pattern, std::move(handler));
+    }
+
+    /**
+     * Unsubscribes the object with the given id from the given channel pattern
+     * @param subId subscriber unique identifier
+     * @param pattern pattern used when subscribing
+     * */
+    inline auto UnsubscribeChannel(UInt64_T subId, std::string_view pattern) -> void {
+        GetDefaultEventBus().UnsubscribeChannel(subId, pattern);
+    }
+
+    /**
+     * Registers the subscriber as the responder of the query type. There can only be
+     * one responder per query type, it is an error to register a second one.
+     * @param subId identifier for the subscriber object
+     * @param handler function computing the answer to a query
+     * */
+    template<typename QueryType>
+        requires IsQuery<QueryType>
+    inline auto Respond(UInt64_T subId, QueryHandler_T<QueryType>&& handler) -> void {
+        GetDefaultEventBus().Respond<QueryType>(subId, std::move(handler));
+    }
+
+    /**
+     * Removes the subscriber as responder of the query type, does nothing if it is not the responder
+     * @param subId subscriber unique identifier
+     * */
+    template<typename QueryType>
+        requires IsQuery<QueryType>
+    inline auto StopResponding(UInt64_T subId) -> void {
+        GetDefaultEventBus().StopResponding<QueryType>(subId);
+    }
+
+    /**
+     * Sends the query to its responder and returns the answer. The responder runs
+     * right away on the calling thread, nothing is queued nor allocated, so this is
+     * meant for the thread processing the events.
+     * @param query query to be answered
+     * @returns answer of the responder, empty if the query has no responder
+     * */
+    template<typename QueryType>
+        requires IsQuery<QueryType>
+    MKT_NODISCARD inline auto Query(const QueryType& query) -> std::optional<typename QueryType::Result_T> {
+        return GetDefaultEventBus().Query(query);
+    }
+
+    /**
+     * Same as Query() for threads other than the one processing the events. The query
+     * is queued and answered by the responder during the next ProcessEvents()
+     * @param query query to be answered
+     * @returns future holding the answer, empty if the query has no responder by then
+     * */
+    template<typename QueryType>
+        requires IsQuery<QueryType>
+    MKT_NODISCARD inline auto QueryAsync(QueryType query) -> std::future<std::optional<typename QueryType::Result_T>> {
+        return GetDefaultEventBus().QueryAsync(std::move(query));
+    }
+
+    /**
+     * Unsubscribes the object with the given id from the event type specified.
+     * When that type of event is triggered, the specified handler will no longer be run.
+     * @param subId subscriber unique identifier
+     * @param type type of event to unsubscribe from
+     * */
+    inline auto Unsubscribe(UInt64_T subId, EventType type) -> void {
+        GetDefaultEventBus().Unsubscribe(subId, type);
+    }
+
+    /**
+     * Unsubscribes the object with the given id from the event category.
+     * When any type of event of the given category is triggered, the specified
+     * handler will no longer be run.
+     * @param subId subscriber unique identifier
+     * @param category event category to unsubscribe from
+     * */
+    inline auto Unsubscribe(UInt64_T subId, EventCategory category) -> void {
+        GetDefaultEventBus().Unsubscribe(subId, category);
+    }
+
+    /**
+     * Unsubscribes the object with the given id from every event of the window, the handlers
+     * subscribed with SubscribeWindow() for it are no longer run. Window ids are reused,
+     * subscribers bound to a window should call this once it is destroyed
+     * @param subId subscriber unique identifier
+     * @param window window to unsubscribe from
+     * */
+    inline auto UnsubscribeWindow(UInt64_T subId, WindowId_T window) -> void {
+        GetDefaultEventBus().UnsubscribeWindow(subId, window);
+    }
+
+    /**
+     * Adds the given event to the queue of unhandled events
+     * @param event event to be added
+     * */
+    inline auto QueueEvent(std::unique_ptr<Event>&& event) -> void {
+        GetDefaultEventBus().QueueEvent(std::move(event));
+    }
+
+    /**
+     * Can be executed by a publisher to notify a type of event has happened.
+     * @param event event to be triggered
+     * */
+    template<typename EventType, typename... Args>
+    inline auto Trigger(Args&&... args) -> void {
+        QueueEvent(MakeEvent<EventType>(std::forward<Args>(args)...));
+    }
+
+    /**
+     * Same as Trigger() for an event coming from the given window
+     * @param window id of the window the event comes from
+     * */
+    template<typename EventType, typename... Args>
+    inline auto TriggerWindow(WindowId_T window, Args&&... args) -> void {
+        GetDefaultEventBus().TriggerWindow<EventType>(window, std::forward<Args>(args)...);
+    }
+
+    /**
+     * Same as QueueEvent() for threads other than the one processing the events.
+     * The event goes to a buffer owned by the calling thread, without any synchronization.
+     * The buffer is published as a whole, with a single atomic operation, once it holds
+     * ASYNC_EVENT_BATCH_SIZE events, when FlushAsyncEvents() is called or when the thread
+     * exits. ProcessEvents() takes the published buffers, keeping the order in which each
+     * thread queued its events; there is no order between events from different threads.
+     * @param event event to be added
+     * */
+    inline auto QueueEventAsync(std::unique_ptr<Event>&& event) -> void {
+        GetDefaultEventBus().QueueEventAsync(std::move(event));
+    }
+
+    /**
+     * Same as Trigger() for threads other than the one processing the events, see QueueEventAsync()
+     * */
+    template<typename EventType, typename... Args>
+    inline auto TriggerAsync(Args&&... args) -> void {
+        QueueEventAsync(MakeEvent<EventType>(std::forward<Args>(args)...));
+    }
+
+    /**
+     * Publishes the events the calling thread queued with QueueEventAsync() so far,
+     * they are processed by the next ProcessEvents()
+     * */
+    inline auto FlushAsyncEvents() -> void {
+        GetDefaultEventBus().FlushAsyncEvents();
+    }
+
+    /**
+     * Adds the given event to the queue of events published on a named channel.
+     * Only the subscribers of the channel receive it.
+     * @param channel channel identifier, see GetChannel()
+     * @param event event to be added
+     * */
+    inline auto PublishEvent(ChannelId_T channel, std::unique_ptr<Event>&& event) -> void {
+        GetDefaultEventBus().PublishEvent(channel, std::move(event));
+    }
+
+    /**
+     * Can be executed by a publisher to notify the subscribers of
+     * a named channel that an event has happened.
+     * @param channel channel identifier, see GetChannel()
+     * */
+    template<typename EventType, typename... Args>
+    inline auto Publish(ChannelId_T channel, Args&&... args) -> void {
+        PublishEvent(channel, MakeEvent<EventType>(std::forward<Args>(args)...));
+    }
+
+    /**
+     * Execute event handlers
+     * */
+    inline auto ProcessEvents() -> void {
+        GetDefaultEventBus().ProcessEvents();
+    }
+
+    /**
+     * Runs demoted handlers on the events ProcessEvents() left in the background lane.
+     * Stops once the given time budget is used up, events not yet processed are kept
+     * for the next call. At least one event is processed per call if any is pending.
+     * Runs on the calling thread, which must be the one calling ProcessEvents(), e.g.
+     * in the time left at the end of a frame
+     * @param budget maximum time to spend running demoted handlers
+     * */
+    inline auto ProcessBackgroundEvents(std::chrono::microseconds budget) -> void {
+        GetDefaultEventBus().ProcessBackgroundEvents(budget);
+    }
+
+    /**
+     * Returns every handler the watchdog has flagged as slow so far
+     * @returns list of slow handler reports
+     * */
+    MKT_NODISCARD inline auto GetSlowHandlerReports() -> std::vector<SlowHandlerReport> {
+        return GetDefaultEventBus().GetSlowHandlerReports();
+    }
+
+    /**
+     * Clears the watchdog state of every handler: strikes, worst times, reports and demotions.
+     * Demoted handlers run from ProcessEvents() again, events still in the background lane
+     * would no longer reach them, call ProcessBackgroundEvents() first to deliver those
+     * */
+    inline auto ResetWatchdog() -> void {
+        GetDefaultEventBus().ResetWatchdog();
+    }
+
+    /**
+     * Cleanup
+     * */
+    inline auto Shutdown() -> void {
+        GetDefaultEventBus().Shutdown();
+    }
 }
 
 #endif // EVENT_SYSTEM_EVENT_MANAGER_HH
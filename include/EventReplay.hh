@@ -0,0 +1,257 @@
+/**
+ * EventReplay.hh
+ * Created by kate on 10/19/26.
+ * */
+
+#ifndef EVENT_SYSTEM_EVENT_REPLAY_HH
+#define EVENT_SYSTEM_EVENT_REPLAY_HH
+
+// C++ Standard Library
+#include <chrono>
+#include <random>
+#include <vector>
+#include <optional>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+#include <EventLog.hh>
+#include <EventManager.hh>
+
+namespace Mikoto {
+    /**
+     * Handler run recorded by DispatchTrace
+     * */
+    struct DispatchRecord {
+        // ProcessEvents() call the handler ran in, counted from the start of the trace
+        UInt64_T Pass{};
+        UInt64_T SubscriberId{};
+        EventType Type{};
+        UInt32_T TimeStamp{};
+
+        // Hash of the encoded event, tells apart events of the same type with different fields
+        UInt64_T EventHash{};
+    };
+
+    /**
+     * Records which handler saw which event, in order, while installed as the
+     * dispatch observer. Two runs dispatching the same events to the same handlers in
+     * the same order have the same digest; the records tell where they part ways.
+     * */
+    class DispatchTrace final : public EventManager::DispatchObserver {
+    public:
+        /**
+         * @param keepRecords keep every record, otherwise only the digest is updated (long runs)
+         * */
+        explicit DispatchTrace(bool keepRecords = true)
+            :   m_KeepRecords{ keepRecords } {}
+
+        auto OnDispatch(UInt64_T subId, const Event& event) -> void override;
+
+        /**
+         * Marks the start of a new ProcessEvents() call
+         * */
+        auto NextPass() -> void { ++m_Pass; }
+
+        /**
+         * Returns the index of the first record differing between both traces
+         * @param other trace to compare with
+         * @returns index of the first difference, empty if both traces are the same
+         * */
+        MKT_NODISCARD auto FindFirstDifference(const DispatchTrace& other) const -> std::optional<Size_T>;
+
+        /**
+         * Writes the records as text, one per line, so traces can be diffed by hand
+         * @param path path of the output file
+         * */
+        auto Save(const Path_T& path) const -> void;
+
+        MKT_NODISCARD auto GetRecords() const -> const std::vector<DispatchRecord>& { return m_Records; }
+        MKT_NODISCARD auto GetDispatchCount() const -> UInt64_T { return m_DispatchCount; }
+        MKT_NODISCARD auto GetDigest() const -> UInt64_T { return m_Digest; }
+
+    private:
+        bool m_KeepRecords{};
+        std::vector<DispatchRecord> m_Records{};
+
+        UInt64_T m_Pass{};
+        UInt64_T m_DispatchCount{};
+        UInt64_T m_Digest{ 0xCBF29CE484222325 };
+    };
+
+    struct EventSourceSpec {
+        UInt64_T Seed{};
+
+        // Events generated per frame, picked uniformly in the range
+        UInt32_T MinEventsPerFrame{ 0 };
+        UInt32_T MaxEventsPerFrame{ 16 };
+
+        // Area the cursor moves in
+        Int32_T Width{ 640 };
+        Int32_T Height{ 480 };
+    };
+
+    /**
+     * Seeded generator of input events: cursor motion, keys, buttons, text and
+     * scrolling, with press and release kept balanced. The same seed gives the same events
+     * everywhere: std::mt19937_64 output is fixed by the standard, unlike the standard
+     * distributions, so values are mapped to ranges here.
+     * */
+    class DeterministicEventSource {
+    public:
+        explicit DeterministicEventSource(const EventSourceSpec& spec = {});
+
+        /**
+         * Queues the events of one frame, stamped at increasing times between the
+         * virtual clock time and that time plus the frame time
+         * @param frameTime duration of the frame
+         * @returns number of events queued
+         * */
+        auto QueueFrame(std::chrono::microseconds frameTime) -> UInt32_T;
+
+    private:
+        MKT_NODISCARD auto Pick(UInt64_T count) -> UInt64_T { return m_Engine() % count; }
+        auto QueueRandomEvent() -> void;
+
+    private:
+        EventSourceSpec m_Spec{};
+        std::mt19937_64 m_Engine{};
+
+        double m_CursorX{};
+        double m_CursorY{};
+        std::vector<Int32_T> m_HeldKeys{};
+        std::vector<Int32_T> m_HeldButtons{};
+    };
+
+    /**
+     * Result of a reference run of a session, kept to compare later runs of the same session
+     * */
+    struct ReplayBaseline {
+        UInt64_T Digest{};
+        UInt64_T DispatchCount{};
+        std::chrono::nanoseconds MedianFrameTime{};
+
+        /**
+         * Reads a baseline written by Save(). Throws if the file can not be read
+         * @param path path of the baseline file
+         * @returns the baseline
+         * */
+        MKT_NODISCARD static auto Load(const Path_T& path) -> ReplayBaseline;
+
+        /**
+         * Writes the baseline as a single line of text
+         * @param path path of the baseline file
+         * */
+        auto Save(const Path_T& path) const -> void;
+    };
+
+    /**
+     * Outcome of ReplaySession::Compare()
+     * */
+    struct ReplayComparison {
+        // Same dispatch trace as the baseline. When false the input or the handlers changed
+        // and the timings do not measure the same work
+        bool SameTrace{};
+
+        // Median frame time of the session over the one of the baseline
+        double Slowdown{};
+
+        // Trace differs or the slowdown goes over the tolerance
+        bool Regressed{};
+    };
+
+    struct ReplaySpec {
+        // Virtual time between two ProcessEvents() calls
+        std::chrono::microseconds FrameTime{ 16667 };
+
+        // See DispatchTrace
+        bool KeepRecords{ true };
+    };
+
+    /**
+     * Deterministic mode: while a session is alive the event clock is virtual and only moves
+     * by FrameTime per frame, the dispatch trace is installed and the watchdog does not demote
+     * handlers. Events come from a DeterministicEventSource or a recorded EventLog instead of the
+     * window, so the ProcessEvents() order only depends on the input. The real time spent in
+     * every ProcessEvents() call is kept to compare runs, see Compare().
+     *
+     * Handlers demoted before the session are promoted back when it starts, once the events
+     * waiting for them in the background lane are delivered, so they run in the traced order.
+     * Every frame drains the background lane after ProcessEvents(), its handlers are traced too.
+     *
+     * Subscribers must be set up the same way for two runs to match. Only one session may exist at a time.
+     * It starts from an empty event queue, events queued before it would be stamped with the real clock,
+     * and other threads should not produce events while it runs, their events would land in whatever
+     * frame is running when they are flushed.
+     * */
+    class ReplaySession {
+    public:
+        /**
+         * Starts the session, see the class description
+         * @param spec session options
+         * @throws std::runtime_error if the event queue is not empty
+         * */
+        explicit ReplaySession(const ReplaySpec& spec = {});
+
+        ReplaySession(const ReplaySession&) = delete;
+        auto operator=(const ReplaySession&) -> ReplaySession& = delete;
+
+        /**
+         * Runs frames with the events produced by the source
+         * @param source generator of the events
+         * @param frameCount number of frames to run
+         * */
+        auto Run(DeterministicEventSource& source, UInt64_T frameCount) -> void;
+
+        /**
+         * Runs frames until the log is exhausted. Each event is queued in the frame its
+         * recorded time falls in and stamped with that time on the virtual clock
+         * @param reader log to be replayed, read from its current position
+         * @returns number of events replayed
+         * */
+        auto Run(EventLogReader& reader) -> UInt64_T;
+
+        MKT_NODISCARD auto GetTrace() const -> const DispatchTrace& { return m_Trace; }
+        MKT_NODISCARD auto GetFrameTimes() const -> const std::vector<std::chrono::nanoseconds>& { return m_FrameTimes; }
+
+        /**
+         * Returns the median of the real time spent per frame, steadier than the mean
+         * @returns median frame processing time
+         * */
+        MKT_NODISCARD auto GetMedianFrameTime() const -> std::chrono::nanoseconds;
+
+        /**
+         * Returns the trace digest and median frame time of this session, to compare later runs with
+         * @returns baseline of this session
+         * */
+        MKT_NODISCARD auto MakeBaseline() const -> ReplayBaseline;
+
+        /**
+         * Compares this session with a baseline run of the same session. Medians are compared
+         * so a regression has to show in most frames, not in a few noisy ones
+         * @param baseline result of the reference run
+         * @param tolerance slowdown allowed before it counts as a regression, e.g. 0.1 for 10%
+         * @returns comparison with the baseline
+         * */
+        MKT_NODISCARD auto Compare(const ReplayBaseline& baseline, double tolerance) const -> ReplayComparison;
+
+        /**
+         * Restores the real clock and removes the trace
+         * */
+        ~ReplaySession();
+
+    private:
+        auto RunFrame() -> void;
+
+    private:
+        ReplaySpec m_Spec{};
+        DispatchTrace m_Trace;
+        std::vector<std::chrono::nanoseconds> m_FrameTimes{};
+
+        // State of the virtual clock before the session, restored when it ends
+        bool m_PreviousClockEnabled{};
+        UInt64_T m_PreviousClockNow{};
+    };
+}
+
+#endif // EVENT_SYSTEM_EVENT_REPLAY_HH
@@ -0,0 +1,204 @@
+/**
+ * EventTask.hh
+ * Created by kate on 10/19/26.
+ * */
+
+#ifndef EVENT_SYSTEM_EVENT_TASK_HH
+#define EVENT_SYSTEM_EVENT_TASK_HH
+
+// C++ Standard Library
+#include <chrono>
+#include <concepts>
+#include <optional>
+#include <coroutine>
+#include <exception>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+#include <EventManager.hh>
+
+namespace Mikoto {
+    /**
+     * Pool for coroutine frames. Frames are grouped in size classes of FRAME_SIZE_STEP
+     * bytes, each class keeps a free list of blocks carved from large chunks, so starting
+     * and finishing a task does not go to the global allocator once the pool is warm.
+     * Frames bigger than MAX_POOLED_FRAME_SIZE use the global allocator.
+     * Like the rest of EventManager, it is meant to be used from the main thread only.
+     * */
+    class CoroutineFramePool {
+    public:
+        static constexpr Size_T FRAME_SIZE_STEP{ 64 };
+        static constexpr Size_T MAX_POOLED_FRAME_SIZE{ 1024 };
+        static constexpr Size_T CHUNK_SIZE{ 64 * 1024 };
+
+        MKT_NODISCARD static auto Allocate(Size_T size) -> void*;
+        static auto Deallocate(void* frame, Size_T size) -> void;
+    };
+
+    /**
+     * Return type of the coroutines waiting on events. Tasks start right away and run
+     * until their first co_await, they are then resumed from EventManager::ProcessEvents()
+     * when the awaited event arrives. A task owns itself, its frame is released when it
+     * finishes, or by EventManager::Shutdown() if it is still waiting by then.
+     *
+     * Example:
+     *      auto DragFlow() -> EventTask {
+     *          co_await EventManager::NextEvent<MouseButtonPressedEvent>();
+     *          while (auto moved{ co_await EventManager::NextEvent<MouseMovedEvent>(std::chrono::milliseconds{ 500 }) }) { ... }
+     *      }
+     * */
+    class EventTask {
+    public:
+        struct promise_type {
+            auto get_return_object() -> EventTask { return {}; }
+            auto initial_suspend() -> std::suspend_never { return {}; }
+            auto final_suspend() noexcept -> std::suspend_never { return {}; }
+            auto return_void() -> void {}
+            auto unhandled_exception() -> void { std::terminate(); }
+
+            static auto operator new(Size_T size) -> void* { return CoroutineFramePool::Allocate(size); }
+            static auto operator delete(void* frame, Size_T size) -> void { CoroutineFramePool::Deallocate(frame, size); }
+        };
+    };
+}
+
+namespace Mikoto::EventManager {
+    /**
+     * Type erased part of an awaited event. Registered in the waiters of its
+     * event type while the coroutine is suspended
+     * */
+    class EventWaiterBase {
+    public:
+        explicit EventWaiterBase(EventType type, std::optional<std::chrono::steady_clock::time_point> deadline)
+            :   m_Type{ type }, m_Deadline{ deadline }
+        {
+
+        }
+
+        /**
+         * Stores the event if the waiter wants it
+         * @param event event of the awaited type
+         * @returns true if the event was taken and the coroutine has to be resumed
+         * */
+        virtual auto Accept(Event& event) -> bool = 0;
+
+        auto Resume() -> void { m_Handle.resume(); }
+        auto Destroy() -> void { m_Handle.destroy(); }
+
+        MKT_NODISCARD auto GetType() const -> EventType { return m_Type; }
+        MKT_NODISCARD auto GetDeadline() const -> const std::optional<std::chrono::steady_clock::time_point>& { return m_Deadline; }
+
+        virtual ~EventWaiterBase() = default;
+
+    protected:
+        std::coroutine_handle<> m_Handle{};
+
+    private:
+        EventType m_Type{};
+        std::optional<std::chrono::steady_clock::time_point> m_Deadline{};
+    };
+
+    /**
+     * Adds a waiter to the ones of its event type
+     * @param waiter suspended waiter, lives in the frame of its coroutine
+     * */
+    auto RegisterEventWaiter(EventWaiterBase& waiter) -> void;
+
+    /**
+     * Resumes the coroutines waiting on the type of the event whose predicate accepts it.
+     * Coroutines which wait again from there only see the events processed after this one.
+     * @param event event being processed
+     * */
+    auto ResumeEventWaiters(Event& event) -> void;
+
+    /**
+     * Resumes, without an event, the coroutines whose timeout has elapsed
+     * */
+    auto ExpireEventWaiters() -> void;
+
+    /**
+     * Destroys the frames of every coroutine still waiting on an event
+     * */
+    auto CancelEventWaiters() -> void;
+
+    /**
+     * Predicate used when NextEvent() is given none
+     * */
+    struct AcceptAnyEvent {
+        template<typename EventClassType>
+        auto operator()(const EventClassType&) const -> bool { return true; }
+    };
+
+    /**
+     * Awaitable returned by NextEvent(). The awaiter lives in the frame of the awaiting
+     * coroutine, so waiting on an event allocates nothing besides that frame.
+     * co_await yields a copy of the event, or an empty optional if the timeout elapsed first.
+     * */
+    template<typename EventClassType, typename PredicateType>
+    class EventAwaiter : public EventWaiterBase {
+    public:
+        EventAwaiter(PredicateType&& predicate, std::optional<std::chrono::steady_clock::time_point> deadline)
+            :   EventWaiterBase{ EventClassType::GetStaticType(), deadline }
+            ,   m_Predicate{ std::move(predicate) }
+        {
+
+        }
+
+        auto await_ready() const -> bool { return false; }
+
+        auto await_suspend(std::coroutine_handle<> handle) -> void {
+            m_Handle = handle;
+            RegisterEventWaiter(*this);
+        }
+
+        auto await_resume() -> std::optional<EventClassType> { return std::move(m_Result); }
+
+        auto Accept(Event& event) -> bool override {
+            auto& typedEvent{ static_cast<EventClassType&>(event) };
+
+            if (!m_Predicate(std::as_const(typedEvent))) {
+                return false;
+            }
+
+            m_Result.emplace(typedEvent);
+            return true;
+        }
+
+    private:
+        PredicateType m_Predicate{};
+        std::optional<EventClassType> m_Result{};
+    };
+
+    /**
+     * Suspends the calling coroutine until the next event of type EventClassType
+     * accepted by the predicate is processed, or until the timeout elapses
+     * @param predicate callable taking a const EventClassType& and returning true to accept it
+     * @param timeout maximum time to wait on the event clock, checked at the end of every ProcessEvents()
+     * @returns awaitable yielding std::optional<EventClassType>
+     * */
+    template<typename EventClassType, typename PredicateType = AcceptAnyEvent>
+        requires IsEventDerived<EventClassType> && HasStaticGetType<EventClassType> && std::predicate<PredicateType&, const EventClassType&>
+    MKT_NODISCARD inline auto NextEvent(PredicateType predicate = {}, std::optional<std::chrono::steady_clock::duration> timeout = {}) -> EventAwaiter<EventClassType, PredicateType> {
+        std::optional<std::chrono::steady_clock::time_point> deadline{};
+
+        if (timeout) {
+            deadline = GetEventClockNow() + *timeout;
+        }
+
+        return { std::move(predicate), deadline };
+    }
+
+    /**
+     * Same as above, accepting any event of the type
+     * @param timeout maximum time to wait, checked at the end of every ProcessEvents()
+     * @returns awaitable yielding std::optional<EventClassType>
+     * */
+    template<typename EventClassType>
+        requires IsEventDerived<EventClassType> && HasStaticGetType<EventClassType>
+    MKT_NODISCARD inline auto NextEvent(std::chrono::steady_clock::duration timeout) -> EventAwaiter<EventClassType, AcceptAnyEvent> {
+        return NextEvent<EventClassType>(AcceptAnyEvent{}, timeout);
+    }
+}
+
+#endif // EVENT_SYSTEM_EVENT_TASK_HH
@@ -0,0 +1,471 @@
+/**
+ * FlatContainers.hh
+ * Created by kate on 10/19/26.
+ * */
+
+#ifndef EVENT_SYSTEM_FLAT_CONTAINERS_HH
+#define EVENT_SYSTEM_FLAT_CONTAINERS_HH
+
+// C++ Standard Library
+#include <new>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <optional>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+
+// Project Headers
+#include <Common.hh>
+
+namespace Mikoto {
+    /**
+     * Vector keeping its first INLINE_CAPACITY elements inside the object, the heap is
+     * only used past that. Meant for lists that almost always hold a handful of elements,
+     * which then live next to their owner instead of in an allocation of their own.
+     * */
+    template<typename ValueType, Size_T INLINE_CAPACITY>
+    class SmallVector {
+    public:
+        static_assert(INLINE_CAPACITY > 0, "A small vector needs inline storage");
+
+        using value_type = ValueType;
+        using size_type = Size_T;
+        using difference_type = std::ptrdiff_t;
+        using reference = ValueType&;
+        using const_reference = const ValueType&;
+        using iterator = ValueType*;
+        using const_iterator = const ValueType*;
+
+        SmallVector() = default;
+
+        template<std::input_iterator IteratorType>
+        SmallVector(IteratorType first, IteratorType last) {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+
+        SmallVector(const SmallVector& other)
+            :   SmallVector(other.begin(), other.end()) {}
+
+        SmallVector(SmallVector&& other) noexcept {
+            TakeFrom(other);
+        }
+
+        auto operator=(const SmallVector& other) -> SmallVector& {
+            if (this != std::addressof(other)) {
+                SmallVector copy{ other };
+                *this = std::move(copy);
+            }
+
+            return *this;
+        }
+
+        auto operator=(SmallVector&& other) noexcept -> SmallVector& {
+            if (this != std::addressof(other)) {
+                Release();
+                TakeFrom(other);
+            }
+
+            return *this;
+        }
+
+        MKT_NODISCARD auto data() -> ValueType* { return IsInline() ? GetInline() : m_Heap; }
+        MKT_NODISCARD auto data() const -> const ValueType* { return IsInline() ? GetInline() : m_Heap; }
+
+        MKT_NODISCARD auto begin() -> iterator { return data(); }
+        MKT_NODISCARD auto end() -> iterator { return data() + m_Size; }
+        MKT_NODISCARD auto begin() const -> const_iterator { return data(); }
+        MKT_NODISCARD auto end() const -> const_iterator { return data() + m_Size; }
+
+        MKT_NODISCARD auto size() const -> Size_T { return m_Size; }
+        MKT_NODISCARD auto capacity() const -> Size_T { return m_Capacity; }
+        MKT_NODISCARD auto empty() const -> bool { return m_Size == 0; }
+
+        MKT_NODISCARD auto operator[](Size_T index) -> ValueType& { return data()[index]; }
+        MKT_NODISCARD auto operator[](Size_T index) const -> const ValueType& { return data()[index]; }
+
+        /**
+         * Returns true while the elements are stored inside the object
+         * */
+        MKT_NODISCARD auto IsInline() const -> bool { return m_Capacity == INLINE_CAPACITY; }
+
+        template<typename... Args>
+        auto emplace_back(Args&&... args) -> ValueType& {
+            if (m_Size < m_Capacity) {
+                return *std::construct_at(data() + m_Size++, std::forward<Args>(args)...);
+            }
+
+            // Built before the elements move, the arguments may refer to one of them
+            const Size_T capacity{ m_Capacity * 2 };
+            ValueType* storage{ std::allocator<ValueType>{}.allocate(capacity) };
+            std::construct_at(storage + m_Size, std::forward<Args>(args)...);
+
+            MoveTo(storage);
+            m_Heap = storage;
+            m_Capacity = static_cast<UInt32_T>(capacity);
+
+            return storage[m_Size++];
+        }
+
+        auto push_back(const ValueType& value) -> void { emplace_back(value); }
+        auto push_back(ValueType&& value) -> void { emplace_back(std::move(value)); }
+
+        auto reserve(Size_T capacity) -> void {
+            if (capacity <= m_Capacity) {
+                return;
+            }
+
+            ValueType* storage{ std::allocator<ValueType>{}.allocate(capacity) };
+            MoveTo(storage);
+            m_Heap = storage;
+            m_Capacity = static_cast<UInt32_T>(capacity);
+        }
+
+        auto erase(const_iterator first, const_iterator last) -> iterator {
+            auto* begin{ data() };
+            auto* target{ begin + (first - begin) };
+            auto* source{ begin + (last - begin) };
+
+            auto* newEnd{ std::move(source, end(), target) };
+            std::destroy(newEnd, end());
+            m_Size = static_cast<UInt32_T>(newEnd - begin);
+
+            return target;
+        }
+
+        auto clear() -> void {
+            std::destroy(begin(), end());
+            m_Size = 0;
+        }
+
+        ~SmallVector() {
+            Release();
+        }
+
+    private:
+        MKT_NODISCARD auto GetInline() -> ValueType* { return std::launder(reinterpret_cast<ValueType*>(m_Inline)); }
+        MKT_NODISCARD auto GetInline() const -> const ValueType* { return std::launder(reinterpret_cast<const ValueType*>(m_Inline)); }
+
+        /**
+         * Moves the elements to the storage and frees the current heap block, if any
+         * */
+        auto MoveTo(ValueType* storage) -> void {
+            std::uninitialized_move(begin(), end(), storage);
+            std::destroy(begin(), end());
+
+            if (!IsInline()) {
+                std::allocator<ValueType>{}.deallocate(m_Heap, m_Capacity);
+            }
+        }
+
+        auto Release() -> void {
+            clear();
+
+            if (!IsInline()) {
+                std::allocator<ValueType>{}.deallocate(m_Heap, m_Capacity);
+                m_Capacity = INLINE_CAPACITY;
+            }
+        }
+
+        /**
+         * Takes the elements of other, which is left empty. Must be called while this vector is empty and inline
+         * */
+        auto TakeFrom(SmallVector& other) -> void {
+            if (other.IsInline()) {
+                std::uninitialized_move(other.begin(), other.end(), GetInline());
+                m_Size = other.m_Size;
+                other.clear();
+                return;
+            }
+
+            m_Heap = std::exchange(other.m_Heap, nullptr);
+            m_Size = std::exchange(other.m_Size, 0);
+            m_Capacity = std::exchange(other.m_Capacity, static_cast<UInt32_T>(INLINE_CAPACITY));
+        }
+
+    private:
+        // Inline elements and heap block share the space, the capacity tells which one is used
+        union {
+            alignas(ValueType) std::byte m_Inline[sizeof(ValueType) * INLINE_CAPACITY];
+            ValueType* m_Heap;
+        };
+
+        UInt32_T m_Size{};
+        UInt32_T m_Capacity{ INLINE_CAPACITY };
+    };
+
+    /**
+     * Hash map with open addressing and linear probing for integer keys. Entries are
+     * stored in one array next to a byte per slot, so a lookup reads the control bytes and
+     * usually one entry, and a full traversal walks two contiguous arrays. Removal shifts
+     * the following entries back, there are no tombstones. The array grows past 7/8 full.
+     *
+     * Inserting or erasing invalidates iterators and references.
+     * */
+    template<typename KeyType, typename ValueType>
+        requires std::is_integral_v<KeyType>
+    class FlatHashMap {
+    public:
+        using Entry_T = std::pair<KeyType, ValueType>;
+
+        template<bool IS_CONST>
+        class Iterator {
+        public:
+            using Map_T = std::conditional_t<IS_CONST, const FlatHashMap, FlatHashMap>;
+            using value_type = Entry_T;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<IS_CONST, const Entry_T&, Entry_T&>;
+            using pointer = std::conditional_t<IS_CONST, const Entry_T*, Entry_T*>;
+
+            Iterator() = default;
+
+            Iterator(Map_T* map, Size_T index)
+                :   m_Map{ map }
+                ,   m_Index{ index }
+            {
+                SkipEmpty();
+            }
+
+            MKT_NODISCARD auto operator*() const -> reference { return m_Map->m_Entries[m_Index]; }
+            MKT_NODISCARD auto operator->() const -> pointer { return std::addressof(m_Map->m_Entries[m_Index]); }
+
+            auto operator++() -> Iterator& {
+                ++m_Index;
+                SkipEmpty();
+                return *this;
+            }
+
+            auto operator++(int) -> Iterator {
+                auto previous{ *this };
+                ++*this;
+                return previous;
+            }
+
+            MKT_NODISCARD auto operator==(const Iterator& other) const -> bool { return m_Index == other.m_Index; }
+
+            MKT_NODISCARD auto GetIndex() const -> Size_T { return m_Index; }
+
+        private:
+            auto SkipEmpty() -> void {
+                while (m_Index < m_Map->m_Capacity && m_Map->m_Control[m_Index] == EMPTY_SLOT) {
+                    ++m_Index;
+                }
+            }
+
+        private:
+            Map_T* m_Map{};
+            Size_T m_Index{};
+        };
+
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        FlatHashMap() = default;
+
+        FlatHashMap(const FlatHashMap&) = delete;
+        auto operator=(const FlatHashMap&) -> FlatHashMap& = delete;
+
+        FlatHashMap(FlatHashMap&& other) noexcept
+            :   m_Control{ std::exchange(other.m_Control, nullptr) }
+            ,   m_Entries{ std::exchange(other.m_Entries, nullptr) }
+            ,   m_Capacity{ std::exchange(other.m_Capacity, 0) }
+            ,   m_Size{ std::exchange(other.m_Size, 0) } {}
+
+        auto operator=(FlatHashMap&& other) noexcept -> FlatHashMap& {
+            if (this != std::addressof(other)) {
+                Release();
+                m_Control = std::exchange(other.m_Control, nullptr);
+                m_Entries = std::exchange(other.m_Entries, nullptr);
+                m_Capacity = std::exchange(other.m_Capacity, 0);
+                m_Size = std::exchange(other.m_Size, 0);
+            }
+
+            return *this;
+        }
+
+        MKT_NODISCARD auto begin() -> iterator { return { this, 0 }; }
+        MKT_NODISCARD auto end() -> iterator { return { this, m_Capacity }; }
+        MKT_NODISCARD auto begin() const -> const_iterator { return { this, 0 }; }
+        MKT_NODISCARD auto end() const -> const_iterator { return { this, m_Capacity }; }
+
+        MKT_NODISCARD auto size() const -> Size_T { return m_Size; }
+        MKT_NODISCARD auto empty() const -> bool { return m_Size == 0; }
+
+        /**
+         * Number of slots, used or not
+         * */
+        MKT_NODISCARD auto GetCapacity() const -> Size_T { return m_Capacity; }
+
+        MKT_NODISCARD auto find(KeyType key) -> iterator {
+            const auto slot{ Find(key) };
+            return slot ? iterator{ this, *slot } : end();
+        }
+
+        MKT_NODISCARD auto find(KeyType key) const -> const_iterator {
+            const auto slot{ Find(key) };
+            return slot ? const_iterator{ this, *slot } : end();
+        }
+
+        MKT_NODISCARD auto contains(KeyType key) const -> bool { return Find(key).has_value(); }
+
+        /**
+         * Returns the value of the key, inserting a default constructed one if it is not in the map
+         * */
+        auto operator[](KeyType key) -> ValueType& {
+            if (const auto slot{ Find(key) }) {
+                return m_Entries[*slot].second;
+            }
+
+            if ((m_Size + 1) * 8 > m_Capacity * 7) {
+                Rehash(std::max<Size_T>(m_Capacity * 2, MIN_CAPACITY));
+            }
+
+            const UInt64_T hash{ Hash(key) };
+            Size_T slot{ hash & (m_Capacity - 1) };
+
+            while (m_Control[slot] != EMPTY_SLOT) {
+                slot = (slot + 1) & (m_Capacity - 1);
+            }
+
+            m_Control[slot] = GetTag(hash);
+            std::construct_at(m_Entries + slot, key, ValueType{});
+            ++m_Size;
+
+            return m_Entries[slot].second;
+        }
+
+        auto erase(iterator position) -> void {
+            Size_T hole{ position.GetIndex() };
+            Size_T next{ (hole + 1) & (m_Capacity - 1) };
+
+            // Entries after the hole which would not be found past it anymore are shifted into it
+            while (m_Control[next] != EMPTY_SLOT) {
+                const Size_T home{ Hash(m_Entries[next].first) & (m_Capacity - 1) };
+
+                if (((next - home) & (m_Capacity - 1)) >= ((next - hole) & (m_Capacity - 1))) {
+                    m_Entries[hole] = std::move(m_Entries[next]);
+                    m_Control[hole] = m_Control[next];
+                    hole = next;
+                }
+
+                next = (next + 1) & (m_Capacity - 1);
+            }
+
+            std::destroy_at(m_Entries + hole);
+            m_Control[hole] = EMPTY_SLOT;
+            --m_Size;
+        }
+
+        auto clear() -> void {
+            for (Size_T slot{}; slot < m_Capacity; ++slot) {
+                if (m_Control[slot] != EMPTY_SLOT) {
+                    std::destroy_at(m_Entries + slot);
+                    m_Control[slot] = EMPTY_SLOT;
+                }
+            }
+
+            m_Size = 0;
+        }
+
+        ~FlatHashMap() {
+            Release();
+        }
+
+    private:
+        static constexpr UInt8_T EMPTY_SLOT{ 0 };
+        static constexpr Size_T MIN_CAPACITY{ 16 };
+
+        /**
+         * Finalizer of MurmurHash3. Keys are often sequential, and callers may already have
+         * split them on the high bits of a multiplicative hash, so every bit is mixed
+         * */
+        MKT_NODISCARD static auto Hash(KeyType key) -> UInt64_T {
+            auto hash{ static_cast<UInt64_T>(key) };
+            hash = (hash ^ (hash >> 33)) * 0xFF51AFD7ED558CCD;
+            hash = (hash ^ (hash >> 33)) * 0xC4CEB9FE1A85EC53;
+            return hash ^ (hash >> 33);
+        }
+
+        /**
+         * Control byte of a used slot: the top bit set plus 7 bits of the hash,
+         * compared before the key so most mismatches do not touch the entry
+         * */
+        MKT_NODISCARD static auto GetTag(UInt64_T hash) -> UInt8_T { return static_cast<UInt8_T>(0x80 | (hash >> 57)); }
+
+        MKT_NODISCARD auto Find(KeyType key) const -> std::optional<Size_T> {
+            if (m_Size == 0) {
+                return std::nullopt;
+            }
+
+            const UInt64_T hash{ Hash(key) };
+            const UInt8_T tag{ GetTag(hash) };
+
+            for (Size_T slot{ hash & (m_Capacity - 1) }; m_Control[slot] != EMPTY_SLOT; slot = (slot + 1) & (m_Capacity - 1)) {
+                if (m_Control[slot] == tag && m_Entries[slot].first == key) {
+                    return slot;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        auto Rehash(Size_T capacity) -> void {
+            auto* control{ std::allocator<UInt8_T>{}.allocate(capacity) };
+            auto* entries{ std::allocator<Entry_T>{}.allocate(capacity) };
+            std::fill_n(control, capacity, EMPTY_SLOT);
+
+            for (Size_T slot{}; slot < m_Capacity; ++slot) {
+                if (m_Control[slot] == EMPTY_SLOT) {
+                    continue;
+                }
+
+                Size_T target{ Hash(m_Entries[slot].first) & (capacity - 1) };
+
+                while (control[target] != EMPTY_SLOT) {
+                    target = (target + 1) & (capacity - 1);
+                }
+
+                control[target] = m_Control[slot];
+                std::construct_at(entries + target, std::move(m_Entries[slot]));
+                std::destroy_at(m_Entries + slot);
+            }
+
+            // Entries were moved out one by one, only the arrays are left
+            if (m_Capacity != 0) {
+                std::allocator<UInt8_T>{}.deallocate(m_Control, m_Capacity);
+                std::allocator<Entry_T>{}.deallocate(m_Entries, m_Capacity);
+            }
+
+            m_Control = control;
+            m_Entries = entries;
+            m_Capacity = capacity;
+        }
+
+        auto Release() -> void {
+            if (m_Capacity == 0) {
+                return;
+            }
+
+            clear();
+            std::allocator<UInt8_T>{}.deallocate(m_Control, m_Capacity);
+            std::allocator<Entry_T>{}.deallocate(m_Entries, m_Capacity);
+
+            m_Control = nullptr;
+            m_Entries = nullptr;
+            m_Capacity = 0;
+        }
+
+    private:
+        UInt8_T* m_Control{};
+        Entry_T* m_Entries{};
+
+        // Always a power of two, zero until the first insertion
+        Size_T m_Capacity{};
+        Size_T m_Size{};
+    };
+}
+
+#endif // EVENT_SYSTEM_FLAT_CONTAINERS_HH
@@ -0,0 +1,146 @@
+/**
+ * InputState.hh
+ * Created by kate on 10/19/26.
+ * */
+
+#ifndef EVENT_SYSTEM_INPUT_STATE_HH
+#define EVENT_SYSTEM_INPUT_STATE_HH
+
+// C++ Standard Library
+#include <bitset>
+
+// Project Headers
+#include <Common.hh>
+
+namespace Mikoto {
+    /**
+     * Snapshot of the keyboard and mouse state of a window. It is updated directly from
+     * the window callbacks before the corresponding events are queued, so systems that
+     * only need to poll (is this key held? where is the cursor?) can query it
+     * without subscribing to input events. Edges (pressed/released this frame),
+     * the cursor delta and the scroll accumulators are reset by NewFrame()
+     * */
+    class InputState {
+    public:
+        // GLFW_KEY_LAST is 348 and GLFW_MOUSE_BUTTON_LAST is 7
+        static constexpr Size_T KEY_COUNT{ 512 };
+        static constexpr Size_T MOUSE_BUTTON_COUNT{ 8 };
+
+        MKT_NODISCARD auto IsKeyDown(Int32_T key) const -> bool { return IsValidKey(key) && m_KeysDown.test(key); }
+        MKT_NODISCARD auto WasKeyPressed(Int32_T key) const -> bool { return IsValidKey(key) && m_KeysPressed.test(key); }
+        MKT_NODISCARD auto WasKeyReleased(Int32_T key) const -> bool { return IsValidKey(key) && m_KeysReleased.test(key); }
+
+        MKT_NODISCARD auto IsMouseButtonDown(Int32_T button) const -> bool { return IsValidButton(button) && m_ButtonsDown.test(button); }
+        MKT_NODISCARD auto WasMouseButtonPressed(Int32_T button) const -> bool { return IsValidButton(button) && m_ButtonsPressed.test(button); }
+        MKT_NODISCARD auto WasMouseButtonReleased(Int32_T button) const -> bool { return IsValidButton(button) && m_ButtonsReleased.test(button); }
+
+        MKT_NODISCARD auto GetModifiers() const -> Int32_T { return m_Modifiers; }
+
+        MKT_NODISCARD auto GetCursorX() const -> double { return m_CursorX; }
+        MKT_NODISCARD auto GetCursorY() const -> double { return m_CursorY; }
+        MKT_NODISCARD auto GetCursorDeltaX() const -> double { return m_CursorDeltaX; }
+        MKT_NODISCARD auto GetCursorDeltaY() const -> double { return m_CursorDeltaY; }
+
+        MKT_NODISCARD auto GetScrollX() const -> double { return m_ScrollX; }
+        MKT_NODISCARD auto GetScrollY() const -> double { return m_ScrollY; }
+
+        /**
+         * Updates the state of a key. Keys outside of the tracked range
+         * (e.g. GLFW_KEY_UNKNOWN) are ignored
+         * @param key key code
+         * @param down true if the key was pressed or repeated, false if it was released
+         * @param modifiers modifier bits reported with the key
+         * */
+        auto OnKey(Int32_T key, bool down, Int32_T modifiers) -> void {
+            m_Modifiers = modifiers;
+
+            if (!IsValidKey(key)) {
+                return;
+            }
+
+            if (down && !m_KeysDown.test(key)) { m_KeysPressed.set(key); }
+            if (!down && m_KeysDown.test(key)) { m_KeysReleased.set(key); }
+
+            m_KeysDown.set(key, down);
+        }
+
+        /**
+         * Updates the state of a mouse button
+         * @param button mouse button
+         * @param down true if the button was pressed, false if it was released
+         * @param modifiers modifier bits reported with the button
+         * */
+        auto OnMouseButton(Int32_T button, bool down, Int32_T modifiers) -> void {
+            m_Modifiers = modifiers;
+
+            if (!IsValidButton(button)) {
+                return;
+            }
+
+            if (down && !m_ButtonsDown.test(button)) { m_ButtonsPressed.set(button); }
+            if (!down && m_ButtonsDown.test(button)) { m_ButtonsReleased.set(button); }
+
+            m_ButtonsDown.set(button, down);
+        }
+
+        auto OnCursorMoved(double x, double y) -> void {
+            // The first position is where the cursor starts, not a move from the origin
+            if (m_HasCursor) {
+                m_CursorDeltaX += x - m_CursorX;
+                m_CursorDeltaY += y - m_CursorY;
+            }
+
+            m_HasCursor = true;
+
+            m_CursorX = x;
+            m_CursorY = y;
+        }
+
+        auto OnScroll(double xOffset, double yOffset) -> void {
+            m_ScrollX += xOffset;
+            m_ScrollY += yOffset;
+        }
+
+        /**
+         * Starts a new frame. Clears the per frame edges and accumulators,
+         * held keys and buttons and the cursor position are kept
+         * */
+        auto NewFrame() -> void {
+            m_KeysPressed.reset();
+            m_KeysReleased.reset();
+            m_ButtonsPressed.reset();
+            m_ButtonsReleased.reset();
+
+            m_CursorDeltaX = 0.0;
+            m_CursorDeltaY = 0.0;
+            m_ScrollX = 0.0;
+            m_ScrollY = 0.0;
+        }
+
+    private:
+        MKT_NODISCARD static constexpr auto IsValidKey(Int32_T key) -> bool { return key >= 0 && static_cast<Size_T>(key) < KEY_COUNT; }
+        MKT_NODISCARD static constexpr auto IsValidButton(Int32_T button) -> bool { return button >= 0 && static_cast<Size_T>(button) < MOUSE_BUTTON_COUNT; }
+
+    private:
+        std::bitset<KEY_COUNT> m_KeysDown{};
+        std::bitset<KEY_COUNT> m_KeysPressed{};
+        std::bitset<KEY_COUNT> m_KeysReleased{};
+
+        std::bitset<MOUSE_BUTTON_COUNT> m_ButtonsDown{};
+        std::bitset<MOUSE_BUTTON_COUNT> m_ButtonsPressed{};
+        std::bitset<MOUSE_BUTTON_COUNT> m_ButtonsReleased{};
+
+        Int32_T m_Modifiers{};
+
+        double m_CursorX{};
+        double m_CursorY{};
+        double m_CursorDeltaX{};
+        double m_CursorDeltaY{};
+        bool m_HasCursor{};
+
+        double m_ScrollX{};
+        double m_ScrollY{};
+    };
+}
+
+#endif // EVENT_SYSTEM_INPUT_STATE_HH
@@ -0,0 +1,197 @@
+/**
+ * PersistentEventQueue.hh
+ * Created by kate on 10/19/26.
+ * */
+
+#ifndef EVENT_SYSTEM_PERSISTENT_EVENT_QUEUE_HH
+#define EVENT_SYSTEM_PERSISTENT_EVENT_QUEUE_HH
+
+// C++ Standard Library
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <stop_token>
+#include <condition_variable>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+#include <EventManager.hh>
+
+namespace Mikoto {
+    struct PersistentQueueSpec {
+        // Size of every segment file, header included
+        Size_T SegmentSize{ 4 * 1024 * 1024 };
+
+        // Minimum time between two flushes to disk. Everything appended in
+        // between is flushed together, zero flushes on every commit
+        std::chrono::milliseconds SyncInterval{ 10 };
+    };
+
+    /**
+     * Location of an event in the queue: segment sequence number and byte offset in the segment
+     * */
+    struct PersistentQueuePosition {
+        UInt64_T Segment{};
+        UInt64_T Offset{};
+    };
+
+    /**
+     * Write ahead copy of the event queue kept in memory mapped segment files, so the events
+     * queued but not processed yet survive the process dying.
+     *
+     * Events are appended, encoded with EventCodec, to the current segment; a full segment is
+     * followed by a new one. The consumer position is committed after the events before it are
+     * processed, segments entirely behind it are recycled as new segments instead of creating
+     * files. A recycled segment is zeroed and flushed by a cleaner thread before it is reused;
+     * when none is clean yet a new file is created, appending never waits for the cleaner.
+     * Appending is a copy into the mapping: it survives a crash of the process as is,
+     * and is flushed to disk at most once per SyncInterval for every event appended meanwhile
+     * (group commit), no event waits on its own flush.
+     *
+     * Delivery after a crash is at least once: the events of the pass running when the process
+     * died are recovered again, and so are the events of every pass since the last one that
+     * ended with no event waiting in the background queue for demoted handlers.
+     *
+     * Only event types with a binary encoding can be persisted.
+     * See EventManager::EnablePersistentQueue() to journal the event queue with it.
+     * */
+    class PersistentEventQueue final : public EventManager::EventQueueJournal {
+    public:
+        /**
+         * Opens the queue stored in the directory, creating it if needed
+         * @param directory directory holding the segment files
+         * @param spec queue configuration
+         * */
+        explicit PersistentEventQueue(const Path_T& directory, const PersistentQueueSpec& spec = {});
+
+        PersistentEventQueue(const PersistentEventQueue&) = delete;
+        auto operator=(const PersistentEventQueue&) -> PersistentEventQueue& = delete;
+
+        /**
+         * Appends an event to the queue
+         * @param event event to be persisted
+         * @returns false if the event type has no binary encoding
+         * */
+        auto Append(const Event& event) -> bool;
+
+        /**
+         * Returns the events between the committed position and the end of the queue,
+         * those queued before the last run ended without being processed
+         * @returns events in the order they were appended
+         * */
+        MKT_NODISCARD auto Recover() const -> std::vector<std::unique_ptr<Event>>;
+
+        /**
+         * Marks every event before the position as processed. Recycles the segments
+         * left behind and flushes to disk if the sync interval elapsed
+         * @param position new consumer position, as returned by GetWritePosition()
+         * */
+        auto Commit(const PersistentQueuePosition& position) -> void;
+
+        /**
+         * Flushes the appended events and the consumer position to disk
+         * */
+        auto Sync() -> void;
+
+        auto OnQueued(const Event& event) -> void override { (void)Append(event); }
+        auto OnProcessingBegin() -> void override { m_PassEnd = m_WritePosition; }
+
+        // Events waiting in the background queue exist nowhere else, the position stays before them
+        auto OnProcessingEnd(bool deferred) -> void override { Commit(deferred ? m_CommittedPosition : m_PassEnd); }
+
+        MKT_NODISCARD auto GetWritePosition() const -> PersistentQueuePosition { return m_WritePosition; }
+        MKT_NODISCARD auto GetCommittedPosition() const -> PersistentQueuePosition { return m_CommittedPosition; }
+        MKT_NODISCARD auto GetSegmentCount() -> Size_T;
+        MKT_NODISCARD auto GetRecycledCount() const -> UInt64_T { return m_RecycledCount; }
+
+        /**
+         * Flushes everything and unmaps the files, they are kept for the next run
+         * */
+        ~PersistentEventQueue() override;
+
+    private:
+        /**
+         * File mapped in memory, unmapped when destroyed. The
+         * descriptor is not kept, the mapping outlives it
+         * */
+        class Mapping {
+        public:
+            Mapping() = default;
+
+            /**
+             * Maps the file, creating it or growing it with zeros to the given size. Throws on failure
+             * */
+            Mapping(const Path_T& path, Size_T size);
+
+            Mapping(Mapping&& other) noexcept;
+            auto operator=(Mapping&& other) noexcept -> Mapping&;
+
+            MKT_NODISCARD auto GetData() const -> std::byte* { return m_Data; }
+            MKT_NODISCARD auto GetSize() const -> Size_T { return m_Size; }
+
+            ~Mapping();
+
+        private:
+            std::byte* m_Data{};
+            Size_T m_Size{};
+        };
+
+        struct Segment {
+            UInt64_T Sequence{};
+            Mapping File{};
+        };
+
+        auto StartSegment() -> void;
+        auto RetireSegment(Segment&& segment) -> void;
+        auto CleanSegments(std::stop_token stop) -> void;
+        auto WriteConsumerPosition(const PersistentQueuePosition& position) -> void;
+
+    private:
+        Path_T m_Directory{};
+        PersistentQueueSpec m_Spec{};
+
+        // Segments holding events, ordered by sequence number. The last one is being written
+        std::vector<Segment> m_Segments{};
+        UInt64_T m_NextFileIndex{};
+        UInt64_T m_NextSequence{};
+
+        // Segments behind the consumer, waiting for the cleaner and ready to be reused
+        std::mutex m_FreeMutex{};
+        std::condition_variable_any m_FreeCondition{};
+        std::vector<Segment> m_DirtySegments{};
+        std::vector<Segment> m_FreeSegments{};
+
+        Mapping m_Consumer{};
+        UInt64_T m_ConsumerGeneration{};
+
+        PersistentQueuePosition m_WritePosition{};
+        PersistentQueuePosition m_CommittedPosition{};
+        PersistentQueuePosition m_SyncedPosition{};
+
+        // End of the events taken by the ProcessEvents() pass running
+        PersistentQueuePosition m_PassEnd{};
+
+        std::chrono::steady_clock::time_point m_LastSync{};
+        UInt64_T m_RecycledCount{};
+
+        // Last member, stopped and joined before the segments are unmapped
+        std::jthread m_Cleaner{};
+    };
+}
+
+namespace Mikoto::EventManager {
+    /**
+     * Journals the event queue in the given directory. The events left unprocessed
+     * by the previous run are put back at the front of the queue first
+     * @param directory directory holding the segment files
+     * @param spec queue configuration
+     * @returns the persistent queue, owned by the event manager until Shutdown()
+     * */
+    auto EnablePersistentQueue(const Path_T& directory, const PersistentQueueSpec& spec = {}) -> PersistentEventQueue&;
+}
+
+#endif // EVENT_SYSTEM_PERSISTENT_EVENT_QUEUE_HH
@@ -0,0 +1,181 @@
+/**
+ * SharedMemoryBridge.hh
+ * Created by kate on 10/19/26.
+ * */
+
+#ifndef EVENT_SYSTEM_SHARED_MEMORY_BRIDGE_HH
+#define EVENT_SYSTEM_SHARED_MEMORY_BRIDGE_HH
+
+// C++ Standard Library
+#include <span>
+#include <array>
+#include <atomic>
+#include <string>
+#include <string_view>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+#include <EventCodec.hh>
+
+namespace Mikoto {
+    /**
+     * Layout of the shared memory object: this header followed by SlotCount slots.
+     * Slot i holds the event with sequence number s where s % SlotCount == i,
+     * its Sequence is 2s + 1 while being written and 2s + 2 once complete, so
+     * readers detect a slot overwritten while they were copying it
+     * */
+    struct SharedRingHeader {
+        static constexpr UInt32_T MAGIC{ 0x4D4B5452 }; // "MKTR"
+        // 2 since the records carry the window id (EventCodec::FORMAT_VERSION 2), older readers would drop them
+        static constexpr UInt32_T VERSION{ 2 };
+
+        UInt32_T Magic{ MAGIC };
+        UInt32_T Version{ VERSION };
+        UInt32_T SlotCount{};
+        UInt32_T SlotSize{};
+
+        // Number of events written so far, the next event gets this sequence number
+        alignas(64) std::atomic<UInt64_T> WriteIndex{};
+    };
+
+    /**
+     * One event encoded with EventCodec
+     * */
+    struct SharedRingSlot {
+        std::atomic<UInt64_T> Sequence{};
+        alignas(EventCodec::RECORD_ALIGNMENT) std::array<std::byte, EventCodec::MAX_WIRE_SIZE> Data{};
+    };
+
+    static_assert(std::atomic<UInt64_T>::is_always_lock_free, "The shared ring needs lock free 64 bit atomics");
+
+    /**
+     * Publishes the events of the selected types to other processes of the same machine
+     * through a single producer, multiple consumer ring in POSIX shared memory. Every
+     * consumer sees every event, readers never block the writer: a reader falling more
+     * than a ring behind skips the events that were overwritten and counts them as lost.
+     * */
+    class SharedMemoryBridge {
+    public:
+        /**
+         * Creates the shared memory object and subscribes to the given types. Throws if an
+         * object with that name already exists, there is one producer per ring. An object left
+         * behind by a producer that crashed has to be removed with shm_unlink() first
+         * @param name shared memory object name, e.g. "/mikoto-events"
+         * @param subId identifier the bridge subscribes with
+         * @param types event types to be published
+         * @param slotCount capacity of the ring, rounded up to a power of two
+         * */
+        SharedMemoryBridge(std::string_view name, UInt64_T subId, std::span<const EventType> types, UInt32_T slotCount = 4096);
+
+        SharedMemoryBridge(const SharedMemoryBridge&) = delete;
+        auto operator=(const SharedMemoryBridge&) -> SharedMemoryBridge& = delete;
+
+        /**
+         * Writes an event to the ring. Called by the bridge handlers, public
+         * so events can also be published without going through the queue.
+         * Events without binary encoding (see EventCodec) are skipped
+         * @param event event to be written
+         * */
+        auto Write(const Event& event) -> void;
+
+        MKT_NODISCARD auto GetWrittenCount() const -> UInt64_T { return m_WriteIndex; }
+
+        /**
+         * Unsubscribes and removes the shared memory object. Mapped readers keep
+         * their mapping but no longer receive anything
+         * */
+        ~SharedMemoryBridge();
+
+    private:
+        std::string m_Name{};
+        UInt64_T m_SubscriberId{};
+        std::vector<EventType> m_Types{};
+
+        Int32_T m_Descriptor{ -1 };
+        Size_T m_MappingSize{};
+        SharedRingHeader* m_Header{};
+        SharedRingSlot* m_Slots{};
+
+        UInt64_T m_WriteIndex{};
+        UInt64_T m_IndexMask{};
+    };
+
+    /**
+     * Consumer side of the bridge, to be used by the processes observing the events.
+     * Reading only touches the mapped memory, no system call is made after opening
+     * */
+    class SharedMemoryReader {
+    public:
+        /**
+         * Opens an existing ring. Only the events written from now on are read
+         * @param name shared memory object name given to the bridge
+         * */
+        explicit SharedMemoryReader(std::string_view name);
+
+        SharedMemoryReader(const SharedMemoryReader&) = delete;
+        auto operator=(const SharedMemoryReader&) -> SharedMemoryReader& = delete;
+
+        /**
+         * Calls func with every record written since the last call, in order. The span
+         * is 8 byte aligned, the record can be read in place with EventCodec::View()
+         * @param func callable taking a std::span<const std::byte> holding one record
+         * @returns number of records read
+         * */
+        template<typename FuncType>
+        auto Poll(FuncType&& func) -> Size_T;
+
+        /**
+         * Returns the number of events overwritten before this reader could read them
+         * @returns lost events count
+         * */
+        MKT_NODISCARD auto GetLostCount() const -> UInt64_T { return m_LostCount; }
+
+        ~SharedMemoryReader();
+
+    private:
+        Int32_T m_Descriptor{ -1 };
+        Size_T m_MappingSize{};
+        const SharedRingHeader* m_Header{};
+        const SharedRingSlot* m_Slots{};
+
+        UInt64_T m_ReadIndex{};
+        UInt64_T m_LostCount{};
+    };
+
+    template<typename FuncType>
+    auto SharedMemoryReader::Poll(FuncType&& func) -> Size_T {
+        const UInt64_T written{ m_Header->WriteIndex.load(std::memory_order_acquire) };
+        const UInt64_T slotCount{ m_Header->SlotCount };
+        Size_T result{};
+
+        if (written - m_ReadIndex > slotCount) {
+            // The writer went around the ring, the oldest events are gone
+            m_LostCount += written - slotCount - m_ReadIndex;
+            m_ReadIndex = written - slotCount;
+        }
+
+        for (; m_ReadIndex < written; ++m_ReadIndex) {
+            const auto& slot{ m_Slots[m_ReadIndex & (slotCount - 1)] };
+            const UInt64_T expected{ m_ReadIndex * 2 + 2 };
+
+            const UInt64_T before{ slot.Sequence.load(std::memory_order_acquire) };
+            alignas(EventCodec::RECORD_ALIGNMENT) const std::array<std::byte, EventCodec::MAX_WIRE_SIZE> record{ slot.Data };
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const UInt64_T after{ slot.Sequence.load(std::memory_order_relaxed) };
+
+            if (before != expected || after != expected) {
+                // Overwritten while being read
+                ++m_LostCount;
+                continue;
+            }
+
+            func(std::span<const std::byte>{ record });
+            ++result;
+        }
+
+        return result;
+    }
+}
+
+#endif // EVENT_SYSTEM_SHARED_MEMORY_BRIDGE_HH
@@ -0,0 +1,112 @@
+/**
+ * SocketBridge.hh
+ * Created by kate on 10/19/26.
+ * */
+
+#ifndef EVENT_SYSTEM_SOCKET_BRIDGE_HH
+#define EVENT_SYSTEM_SOCKET_BRIDGE_HH
+
+// C++ Standard Library
+#include <span>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <string_view>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+
+namespace Mikoto {
+    /**
+     * Per client counters of the socket bridge
+     * */
+    struct SocketClientStats {
+        Size_T BufferedBytes{};
+        UInt64_T SentFrames{};
+        UInt64_T DroppedFrames{};
+        UInt64_T InjectedEvents{};
+    };
+
+    /**
+     * Unix domain socket server streaming the events of the selected types to the
+     * attached clients (debuggers, automation tools). Every frame is a little-endian 32 bit
+     * length followed by that many bytes of event encoded with EventCodec. The events of
+     * one ProcessEvents() pass are gathered and sent to each client with a single vectored
+     * write in Update().
+     *
+     * Clients may send frames in the same format, the events they describe are queued
+     * with EventManager::QueueEvent(). Sockets are non blocking and the data a client
+     * did not take is kept in a buffer of at most MaxClientBuffer bytes: once a pass
+     * does not fit, its frames are dropped for that client and counted, the main loop
+     * never waits on a slow client.
+     * */
+    class SocketBridge {
+    public:
+        static constexpr Size_T FRAME_LENGTH_SIZE{ sizeof(UInt32_T) };
+
+        /**
+         * Starts listening on the given path and subscribes to the given types
+         * @param path filesystem path of the socket, replaced if it exists
+         * @param subId identifier the bridge subscribes with
+         * @param types event types to be streamed
+         * @param maxClientBuffer maximum bytes kept for a client which is not reading
+         * */
+        SocketBridge(std::string_view path, UInt64_T subId, std::span<const EventType> types, Size_T maxClientBuffer = 256 * 1024);
+
+        SocketBridge(const SocketBridge&) = delete;
+        auto operator=(const SocketBridge&) -> SocketBridge& = delete;
+
+        /**
+         * Accepts new clients, queues the events they sent and sends them the
+         * frames gathered since the last call. To be called once per frame,
+         * after EventManager::ProcessEvents()
+         * */
+        auto Update() -> void;
+
+        /**
+         * Adds an event to the frames sent by the next Update(). Called by the
+         * bridge handlers, public so events can be streamed without going through the queue
+         * @param event event to be sent
+         * */
+        auto Write(const Event& event) -> void;
+
+        MKT_NODISCARD auto GetClientCount() const -> Size_T { return m_Clients.size(); }
+        MKT_NODISCARD auto GetClientStats() const -> std::vector<SocketClientStats>;
+
+        /**
+         * Unsubscribes, disconnects the clients and removes the socket file
+         * */
+        ~SocketBridge();
+
+    private:
+        struct Client {
+            Int32_T Descriptor{ -1 };
+
+            // Bytes not taken by the client yet, always whole frames once the pending pass is counted
+            std::vector<std::byte> Output{};
+            std::vector<std::byte> Input{};
+
+            SocketClientStats Stats{};
+        };
+
+        auto AcceptClients() -> void;
+        auto ReadClient(Client& client) -> bool;
+        auto SendClient(Client& client) -> bool;
+
+    private:
+        std::string m_Path{};
+        UInt64_T m_SubscriberId{};
+        std::vector<EventType> m_Types{};
+        Size_T m_MaxClientBuffer{};
+
+        Int32_T m_Descriptor{ -1 };
+        std::vector<Client> m_Clients{};
+
+        // Frames of the current pass, shared by every client
+        std::vector<std::byte> m_Pending{};
+        UInt64_T m_PendingFrames{};
+    };
+}
+
+#endif // EVENT_SYSTEM_SOCKET_BRIDGE_HH
@@ -0,0 +1,136 @@
+/**
+ * TopicRouter.hh
+ * Created by kate on 10/19/26.
+ * */
+
+#ifndef EVENT_SYSTEM_TOPIC_ROUTER_HH
+#define EVENT_SYSTEM_TOPIC_ROUTER_HH
+
+// C++ Standard Library
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+
+namespace Mikoto {
+    /**
+     * Routes events published on named, hierarchical channels such as "input/keyboard/pressed".
+     * Channel names are made of segments separated by '/'. Subscription patterns use the same
+     * syntax plus two wildcards: '*' matches exactly one segment and '**', only allowed as the
+     * last segment, matches any number of remaining segments (including none).
+     *
+     * Patterns are stored in a trie. Every concrete channel keeps a cached list of the handlers
+     * whose pattern matches it: the list is built by walking the trie when the channel is first
+     * used and kept up to date on subscribe/unsubscribe, so publishing never does any matching.
+     * */
+    class TopicRouter {
+    public:
+        using ChannelId_T = UInt32_T;
+
+        /**
+         * Alias for channel event functions, same contract as EventManager::EventHandler_T
+         * */
+        using Handler_T = std::function<bool(Event&)>;
+
+        struct Subscription {
+            UInt64_T SubscriberId{};
+            std::string Pattern{};
+            Handler_T Handler{};
+        };
+
+        using SubscriptionPtr_T = std::shared_ptr<Subscription>;
+
+    public:
+        TopicRouter() : m_Nodes(1) {}
+
+        /**
+         * Returns the identifier of the given channel, registering it on first use.
+         * Registration resolves the subscriptions matching the channel, this is
+         * the only moment a new channel is matched against the patterns.
+         * @param path channel name
+         * @returns channel identifier
+         * */
+        auto GetChannel(std::string_view path) -> ChannelId_T;
+
+        /**
+         * Subscribes a handler to every channel matching the pattern,
+         * those already registered and those registered later.
+         * Throws if '**' is used anywhere but as the last segment
+         * @param subId identifier for the subscriber object
+         * @param pattern channel pattern, may contain wildcards
+         * @param handler event handler from the subscriber
+         * */
+        auto Subscribe(UInt64_T subId, std::string_view pattern, Handler_T&& handler) -> void;
+
+        /**
+         * Removes the handlers the subscriber registered with this pattern. Patterns are compared
+         * once normalized, "a//b/" removes the handlers subscribed with "a/b"
+         * @param subId subscriber unique identifier
+         * @param pattern pattern used when subscribing, in any spelling
+         * */
+        auto Unsubscribe(UInt64_T subId, std::string_view pattern) -> void;
+
+        /**
+         * Returns the cached handlers of a channel
+         * @param channel channel identifier, as returned by GetChannel()
+         * @returns handlers subscribed to the channel
+         * */
+        MKT_NODISCARD auto GetHandlers(ChannelId_T channel) const -> const std::vector<SubscriptionPtr_T>& { return m_Channels[channel].Handlers; }
+
+        MKT_NODISCARD auto GetChannelPath(ChannelId_T channel) const -> std::string_view { return m_Channels[channel].Path; }
+        MKT_NODISCARD auto GetChannelCount() const -> Size_T { return m_Channels.size(); }
+
+        /**
+         * Returns true if the channel path matches the pattern.
+         * Patterns Subscribe() would reject match nothing
+         * @param pattern subscription pattern
+         * @param path channel name
+         * */
+        MKT_NODISCARD static auto Matches(std::string_view pattern, std::string_view path) -> bool;
+
+        auto Clear() -> void;
+
+    private:
+        static constexpr UInt32_T NO_NODE{ ~UInt32_T{} };
+
+        /**
+         * Allows looking up string keyed maps with a string_view without building a string
+         * */
+        struct StringHash {
+            using is_transparent = void;
+            auto operator()(std::string_view value) const -> Size_T { return std::hash<std::string_view>{}(value); }
+        };
+
+        template<typename ValueType>
+        using StringMap_T = std::unordered_map<std::string, ValueType, StringHash, std::equal_to<>>;
+
+        struct Node {
+            // Children by segment, wildcards are stored as the literal "*" and "**" segments
+            StringMap_T<UInt32_T> Children{};
+            std::vector<SubscriptionPtr_T> Subscriptions{};
+        };
+
+        struct Channel {
+            std::string Path{};
+            std::vector<SubscriptionPtr_T> Handlers{};
+        };
+
+        auto FindNode(std::string_view pattern) const -> UInt32_T;
+        auto Collect(UInt32_T node, const std::vector<std::string_view>& segments, Size_T index, std::vector<SubscriptionPtr_T>& result) const -> void;
+
+    private:
+        // Trie of subscription patterns, m_Nodes[0] is the root
+        std::vector<Node> m_Nodes{};
+
+        std::vector<Channel> m_Channels{};
+        StringMap_T<ChannelId_T> m_ChannelIds{};
+    };
+}
+
+#endif // EVENT_SYSTEM_TOPIC_ROUTER_HH
@@ -11,6 +11,8 @@
 #include <GLFW/glfw3.h>
 
 #include <Types.hh>
+#include <Event.hh>
+#include <InputState.hh>
 
 namespace Mikoto {
     struct WindowSpec {
@@ -28,6 +30,19 @@ namespace Mikoto {
         MKT_NODISCARD auto GetHeight() const -> Int32_T { return m_Height; }
         MKT_NODISCARD auto GetTitle() const -> const std::string& { return m_Title; }
 
+        /**
+         * Returns the id the events of this window are stamped with, see EventManager::SubscribeWindow().
+         * Ids are unique among the windows alive and reused once a window is destroyed
+         * @returns id of this window
+         * */
+        MKT_NODISCARD auto GetId() const -> WindowId_T { return m_Id; }
+
+        /**
+         * Returns the keyboard and mouse state of this window as of the last PollEvents()
+         * @returns input state of this window
+         * */
+        MKT_NODISCARD auto GetInputState() const -> const InputState& { return m_InputState; }
+
         auto SetWidth(Int32_T value) -> void { m_Width = value; }
         auto SetHeight(Int32_T value) -> void { m_Height = value; }
         auto SetTitle(std::string_view value) -> void { m_Title = value; }
@@ -53,13 +68,20 @@ namespace Mikoto {
         static auto DestroyGLFWWindow(GLFWwindow* window) -> void;
         static auto CreateGLFWWindow(const GLFWWindowCreateSpec& spec) -> GLFWwindow*;
 
+        static auto AcquireWindowId() -> WindowId_T;
+        static auto ReleaseWindowId(WindowId_T id) -> void;
+
     private:
         static inline Int32_T s_ActiveWindows{};
         static inline bool s_GLFWInitSuccess{};
 
+        // Bit N set while id N + 1 is taken
+        static inline UInt32_T s_WindowIdsInUse{};
+
         bool m_WindowCreateSuccess{};
 
         GLFWwindow* m_Window{};
+        WindowId_T m_Id{};
 
         Int32_T m_Width{};
         Int32_T m_Height{};
@@ -67,6 +89,8 @@ namespace Mikoto {
         std::string m_Title{};
 
         bool m_Resizeable{};
+
+        InputState m_InputState{};
     };
 }
 
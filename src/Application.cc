@@ -2,6 +2,7 @@
 // Created by kate on 10/4/23.
 //
 
+#include <chrono>
 #include <iostream>
 #include <thread>
 
@@ -16,6 +17,9 @@ namespace Mikoto {
     auto Application::Init() -> void {
         using namespace EventManager;
 
+        // Late subscribers get the current window size without waiting for a resize
+        EventManager::SetSticky<WindowResizedEvent>();
+
         EventManager::Subscribe(uuid,
             EventType::WINDOW_CLOSE_EVENT,
             [this](Event&) -> bool
@@ -50,6 +54,9 @@ namespace Mikoto {
         while(m_State == State::RUNNING) {
             m_Window->PollEvents();
             EventManager::ProcessEvents();
+
+            // Whatever is left of the frame goes to handlers the watchdog demoted
+            EventManager::ProcessBackgroundEvents(std::chrono::microseconds{ 2000 });
         }
     }
 
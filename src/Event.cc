@@ -0,0 +1,77 @@
+/**
+ * Event.cc
+ * Created by kate on 10/19/26.
+ * */
+
+// C++ Standard Library
+#include <bit>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <string>
+#include <stdexcept>
+
+// Project Headers
+#include <Event.hh>
+
+namespace Mikoto {
+    /**
+     * Guards registration. Lookups do not take it, registering
+     * is expected to happen before events of the new type are used
+     * */
+    static auto GetRegistryMutex() -> std::mutex& {
+        static std::mutex mutex{};
+        return mutex;
+    }
+
+    /**
+     * Set once the type table is only read, see FreezeEventTypes()
+     * */
+    static std::atomic<bool> s_EventTypesFrozen{};
+
+    auto RegisterEventType(std::string_view name, EventCategory categories) -> EventType {
+        // The table only holds views, names of runtime types are owned here
+        static std::deque<std::string> names{};
+
+        std::scoped_lock lock{ GetRegistryMutex() };
+
+        if (s_EventTypesFrozen.load(std::memory_order_relaxed)) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Cannot register event type {}. Event types are frozen once events are processed", name));
+        }
+
+        if (s_EventTypeTable.Count >= MAX_EVENT_TYPE_COUNT) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Cannot register event type {}. All {} event types are in use", name, MAX_EVENT_TYPE_COUNT));
+        }
+
+        const auto index{ s_EventTypeTable.Count };
+
+        s_EventTypeTable.Categories[index] = categories;
+        s_EventTypeTable.Names[index] = names.emplace_back(name);
+        s_EventTypeTable.Count += 1;
+
+        return static_cast<EventType>(index);
+    }
+
+    auto FreezeEventTypes() -> void {
+        if (s_EventTypesFrozen.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        // Waits for a registration in flight to complete
+        std::scoped_lock lock{ GetRegistryMutex() };
+        s_EventTypesFrozen.store(true, std::memory_order_release);
+    }
+
+    auto RegisterEventCategory() -> EventCategory {
+        // First bit not used by the core categories
+        static UInt32_T nextBit{ std::countr_zero(static_cast<UInt32_T>(EVENT_CATEGORY_COUNT)) };
+
+        std::scoped_lock lock{ GetRegistryMutex() };
+
+        if (nextBit >= 32) {
+            MKT_THROW_RUNTIME_ERROR("Cannot register event category. All 32 category bits are in use");
+        }
+
+        return static_cast<EventCategory>(UInt32_T{ 1 } << nextBit++);
+    }
+}
@@ -0,0 +1,119 @@
+/**
+ * EventCodec.cc
+ * Created by kate on 10/19/26.
+ * */
+
+// C++ Standard Library
+#include <cstring>
+
+// Project Headers
+#include <EventCodec.hh>
+
+namespace Mikoto::EventCodec {
+    template<typename EventClassType>
+    static auto EncodeAs(const Event& event, std::span<std::byte> buffer) -> Size_T {
+        if constexpr (HasWireFormat<EventClassType>) {
+            using Record_T = WireRecord_T<EventClassType>;
+
+            if (buffer.size() < sizeof(Record_T)) {
+                return 0;
+            }
+
+            // Built on the stack and copied, the destination may be misaligned
+            Record_T record{};
+            record.Header.Type = static_cast<UInt8_T>(event.GetType());
+            record.Header.Words = static_cast<UInt8_T>(sizeof(Record_T) / RECORD_ALIGNMENT);
+            record.Header.Flags = event.IsHandled() ? WIRE_HANDLED_FLAG : 0;
+
+            if (event.GetWindowId() <= WIRE_MAX_WINDOW_ID) {
+                record.Header.Flags |= static_cast<UInt8_T>(event.GetWindowId() << WIRE_WINDOW_SHIFT);
+            }
+
+            record.Header.TimeStamp.Set(event.GetTimeStamp());
+
+            WireFormat<EventClassType>::Encode(static_cast<const EventClassType&>(event), record);
+
+            std::memcpy(buffer.data(), &record, sizeof(Record_T));
+            return sizeof(Record_T);
+        }
+        else {
+            return 0;
+        }
+    }
+
+    template<typename EventClassType>
+    static auto DecodeAs(std::span<const std::byte> buffer) -> std::unique_ptr<Event> {
+        if constexpr (HasWireFormat<EventClassType>) {
+            using Record_T = WireRecord_T<EventClassType>;
+
+            Record_T record{};
+            std::memcpy(&record, buffer.data(), sizeof(Record_T));
+
+            auto result{ std::make_unique<EventClassType>(WireFormat<EventClassType>::Decode(record)) };
+            result->SetTimeStamp(record.Header.TimeStamp.Get());
+            result->SetHandled((record.Header.Flags & WIRE_HANDLED_FLAG) != 0);
+            result->SetWindowId(record.Header.GetWindowId());
+            return result;
+        }
+        else {
+            return nullptr;
+        }
+    }
+
+    auto Encode(const Event& event, std::span<std::byte> buffer) -> Size_T {
+        switch (event.GetType()) {
+            #define MKT_EVENT_ENCODE_CASE(TYPE, CATEGORIES, CLASS) case EventType::TYPE: return EncodeAs<CLASS>(event, buffer);
+            MKT_CORE_EVENT_LIST(MKT_EVENT_ENCODE_CASE)
+            #undef MKT_EVENT_ENCODE_CASE
+
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * Tells whether records of the version can be read, see FORMAT_VERSION
+     * */
+    static auto IsReadableVersion(UInt8_T version) -> bool {
+        return version >= OLDEST_FORMAT_VERSION && version <= FORMAT_VERSION;
+    }
+
+    auto PeekHeader(std::span<const std::byte> buffer) -> const WireHeader* {
+        if (buffer.size() < sizeof(WireHeader) || reinterpret_cast<std::uintptr_t>(buffer.data()) % RECORD_ALIGNMENT != 0) {
+            return nullptr;
+        }
+
+        const auto* header{ reinterpret_cast<const WireHeader*>(buffer.data()) };
+
+        if (!IsReadableVersion(header->Version) || header->GetSize() < sizeof(WireHeader) || header->GetSize() > buffer.size()) {
+            return nullptr;
+        }
+
+        return header;
+    }
+
+    auto Decode(std::span<const std::byte> buffer) -> std::unique_ptr<Event> {
+        if (buffer.size() < sizeof(WireHeader)) {
+            return nullptr;
+        }
+
+        // Copied out, the buffer may be misaligned
+        WireHeader header{};
+        std::memcpy(&header, buffer.data(), sizeof(WireHeader));
+
+        const auto type{ static_cast<EventType>(header.Type) };
+
+        if (!IsReadableVersion(header.Version) || header.GetSize() > buffer.size() || header.GetSize() != GetWireSize(type)) {
+            return nullptr;
+        }
+
+        switch (type) {
+            #define MKT_EVENT_DECODE_CASE(TYPE, CATEGORIES, CLASS) case EventType::TYPE: return DecodeAs<CLASS>(buffer);
+            MKT_CORE_EVENT_LIST(MKT_EVENT_DECODE_CASE)
+            #undef MKT_EVENT_DECODE_CASE
+
+            default:
+                return nullptr;
+        }
+    }
+}
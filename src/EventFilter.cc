@@ -0,0 +1,144 @@
+/**
+ * EventFilter.cc
+ * Created by kate on 10/19/26.
+ * */
+
+// Project Headers
+#include <EventFilter.hh>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define MKT_EVENT_FILTER_X86
+    #include <immintrin.h>
+#endif
+
+#if defined(MKT_EVENT_FILTER_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define MKT_EVENT_FILTER_AVX2
+    #define MKT_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace Mikoto::EventFilter {
+    static auto MatchCategoriesScalar(const UInt32_T* categories, Size_T count, UInt32_T wanted) -> UInt64_T {
+        UInt64_T result{};
+
+        for (Size_T index{}; index < count; ++index) {
+            result |= static_cast<UInt64_T>((categories[index] & wanted) != 0) << index;
+        }
+
+        return result;
+    }
+
+    static auto MatchTypesScalar(const UInt8_T* types, Size_T count, UInt8_T wanted) -> UInt64_T {
+        UInt64_T result{};
+
+        for (Size_T index{}; index < count; ++index) {
+            result |= static_cast<UInt64_T>(types[index] == wanted) << index;
+        }
+
+        return result;
+    }
+
+#if defined(MKT_EVENT_FILTER_X86)
+    // Both process one full word (64 events) at a time
+    static auto MatchCategoriesSSE2(const UInt32_T* categories, UInt32_T wanted) -> UInt64_T {
+        const __m128i wantedVec{ _mm_set1_epi32(static_cast<Int32_T>(wanted)) };
+        const __m128i zero{ _mm_setzero_si128() };
+        UInt64_T result{};
+
+        for (Size_T index{}; index < 64; index += 4) {
+            const __m128i values{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(categories + index)) };
+            const __m128i isZero{ _mm_cmpeq_epi32(_mm_and_si128(values, wantedVec), zero) };
+            const auto bits{ static_cast<UInt64_T>(~_mm_movemask_ps(_mm_castsi128_ps(isZero)) & 0xF) };
+            result |= bits << index;
+        }
+
+        return result;
+    }
+
+    static auto MatchTypesSSE2(const UInt8_T* types, UInt8_T wanted) -> UInt64_T {
+        const __m128i wantedVec{ _mm_set1_epi8(static_cast<char>(wanted)) };
+        UInt64_T result{};
+
+        for (Size_T index{}; index < 64; index += 16) {
+            const __m128i values{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(types + index)) };
+            const auto bits{ static_cast<UInt64_T>(static_cast<UInt32_T>(_mm_movemask_epi8(_mm_cmpeq_epi8(values, wantedVec)))) };
+            result |= bits << index;
+        }
+
+        return result;
+    }
+#endif
+
+#if defined(MKT_EVENT_FILTER_AVX2)
+    MKT_TARGET_AVX2 static auto MatchCategoriesAVX2(const UInt32_T* categories, UInt32_T wanted) -> UInt64_T {
+        const __m256i wantedVec{ _mm256_set1_epi32(static_cast<Int32_T>(wanted)) };
+        const __m256i zero{ _mm256_setzero_si256() };
+        UInt64_T result{};
+
+        for (Size_T index{}; index < 64; index += 8) {
+            const __m256i values{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(categories + index)) };
+            const __m256i isZero{ _mm256_cmpeq_epi32(_mm256_and_si256(values, wantedVec), zero) };
+            const auto bits{ static_cast<UInt64_T>(~_mm256_movemask_ps(_mm256_castsi256_ps(isZero)) & 0xFF) };
+            result |= bits << index;
+        }
+
+        return result;
+    }
+
+    MKT_TARGET_AVX2 static auto MatchTypesAVX2(const UInt8_T* types, UInt8_T wanted) -> UInt64_T {
+        const __m256i wantedVec{ _mm256_set1_epi8(static_cast<char>(wanted)) };
+
+        const __m256i low{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(types)) };
+        const __m256i high{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(types + 32)) };
+
+        const auto lowBits{ static_cast<UInt32_T>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, wantedVec))) };
+        const auto highBits{ static_cast<UInt32_T>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, wantedVec))) };
+
+        return static_cast<UInt64_T>(lowBits) | (static_cast<UInt64_T>(highBits) << 32);
+    }
+
+    static auto HasAVX2() -> bool {
+        static const bool result{ static_cast<bool>(__builtin_cpu_supports("avx2")) };
+        return result;
+    }
+#endif
+
+    auto MatchCategories(std::span<const UInt32_T> categories, UInt32_T wanted, std::span<UInt64_T> masks) -> void {
+        const Size_T fullWords{ categories.size() / 64 };
+
+        for (Size_T word{}; word < fullWords; ++word) {
+            const UInt32_T* data{ categories.data() + word * 64 };
+
+#if defined(MKT_EVENT_FILTER_AVX2)
+            masks[word] = HasAVX2() ? MatchCategoriesAVX2(data, wanted) : MatchCategoriesSSE2(data, wanted);
+#elif defined(MKT_EVENT_FILTER_X86)
+            masks[word] = MatchCategoriesSSE2(data, wanted);
+#else
+            masks[word] = MatchCategoriesScalar(data, 64, wanted);
+#endif
+        }
+
+        if (const Size_T remaining{ categories.size() % 64 }; remaining != 0) {
+            masks[fullWords] = MatchCategoriesScalar(categories.data() + fullWords * 64, remaining, wanted);
+        }
+    }
+
+    auto MatchTypes(std::span<const UInt8_T> types, UInt8_T wanted, std::span<UInt64_T> masks) -> void {
+        const Size_T fullWords{ types.size() / 64 };
+
+        for (Size_T word{}; word < fullWords; ++word) {
+            const UInt8_T* data{ types.data() + word * 64 };
+
+#if defined(MKT_EVENT_FILTER_AVX2)
+            masks[word] = HasAVX2() ? MatchTypesAVX2(data, wanted) : MatchTypesSSE2(data, wanted);
+#elif defined(MKT_EVENT_FILTER_X86)
+            masks[word] = MatchTypesSSE2(data, wanted);
+#else
+            masks[word] = MatchTypesScalar(data, 64, wanted);
+#endif
+        }
+
+        if (const Size_T remaining{ types.size() % 64 }; remaining != 0) {
+            masks[fullWords] = MatchTypesScalar(types.data() + fullWords * 64, remaining, wanted);
+        }
+    }
+}
@@ -0,0 +1,591 @@
+/**
+ * EventLog.cc
+ * Created by kate on 10/19/26.
+ * */
+
+// C++ Standard Library
+#include <cmath>
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <utility>
+#include <algorithm>
+
+// Project Headers
+#include <CoreEvents.hh>
+#include <EventCodec.hh>
+#include <EventLog.hh>
+#include <EventManager.hh>
+
+namespace Mikoto {
+    namespace {
+        constexpr UInt32_T LOG_MAGIC{ 0x4C544B4D };     // "MKTL"
+        constexpr UInt32_T CHUNK_MAGIC{ 0x43544B4D };   // "MKTC"
+        constexpr UInt32_T INDEX_MAGIC{ 0x49544B4D };   // "MKTI"
+        constexpr UInt32_T LOG_VERSION{ 3 };
+
+        // Version 1 logs are version 2 logs that never use PACKED_PIXELS, and
+        // version 2 logs are version 3 logs with no window id in the event flags
+        constexpr UInt32_T OLDEST_LOG_VERSION{ 1 };
+
+        constexpr Size_T FILE_HEADER_SIZE{ 8 };     // magic, version
+        constexpr Size_T CHUNK_HEADER_SIZE{ 24 };   // magic, byte size, event count, reserved, first time
+        constexpr Size_T INDEX_ENTRY_SIZE{ 24 };    // offset, first time, event count, reserved
+        constexpr Size_T TRAILER_SIZE{ 16 };        // index offset, chunk count, magic
+
+        // Low bits of the event tag, the type takes the bits above them. Bit 0 tells a
+        // varint of event flags follows the tag, bits 1-2 tell how coordinates are stored
+        constexpr UInt64_T TAG_HAS_FLAGS{ BIT_SET(0) };
+        constexpr UInt64_T TAG_COORDINATES_SHIFT{ 1 };
+        constexpr UInt64_T TAG_FLAG_BITS{ 3 };
+
+        enum CoordinateMode : UInt64_T {
+            WHOLE_PIXELS    = 0,
+            FIXED_POINT     = 1,
+            RAW_DOUBLES     = 2,
+            PACKED_PIXELS   = 3,    // Whole pixel deltas both within [-8, 7], one byte for the pair
+        };
+
+        // Event flags, only written when one is set. The window id takes the bits above them
+        constexpr UInt64_T FLAG_HANDLED{ BIT_SET(0) };
+        constexpr UInt64_T FLAG_REPEATED{ BIT_SET(1) };
+        constexpr UInt64_T FLAG_WINDOW_SHIFT{ 2 };
+
+        // Positions are tracked in 1/256 pixel units
+        constexpr Int64_T FIXED_POINT_ONE{ 256 };
+        constexpr double FIXED_POINT_SCALE{ 256.0 };
+        constexpr double FIXED_POINT_LIMIT{ 9007199254740992.0 }; // 2^53
+
+        auto ZigZag(Int64_T value) -> UInt64_T { return (static_cast<UInt64_T>(value) << 1) ^ static_cast<UInt64_T>(value >> 63); }
+        auto UnZigZag(UInt64_T value) -> Int64_T { return static_cast<Int64_T>(value >> 1) ^ -static_cast<Int64_T>(value & 1); }
+
+        auto PutVarint(std::vector<UInt8_T>& out, UInt64_T value) -> void {
+            while (value >= 0x80) {
+                out.push_back(static_cast<UInt8_T>(value | 0x80));
+                value >>= 7;
+            }
+
+            out.push_back(static_cast<UInt8_T>(value));
+        }
+
+        template<typename ValueType>
+        auto PutFixed(std::vector<UInt8_T>& out, ValueType value) -> void {
+            EventCodec::LittleEndian<ValueType> encoded{};
+            encoded.Set(value);
+
+            const auto* bytes{ reinterpret_cast<const UInt8_T*>(&encoded) };
+            out.insert(out.end(), bytes, bytes + sizeof(ValueType));
+        }
+
+        template<typename ValueType>
+        auto GetFixed(const UInt8_T* in) -> ValueType {
+            EventCodec::LittleEndian<ValueType> encoded{};
+            std::memcpy(&encoded, in, sizeof(ValueType));
+            return encoded.Get();
+        }
+
+        auto ToFixedPoint(double value, Int64_T& result) -> bool {
+            const double scaled{ value * FIXED_POINT_SCALE };
+
+            if (!(std::abs(scaled) < FIXED_POINT_LIMIT) || scaled != std::floor(scaled)) {
+                return false;
+            }
+
+            result = static_cast<Int64_T>(scaled);
+            return true;
+        }
+
+        auto FromFixedPoint(Int64_T value) -> double { return static_cast<double>(value) / FIXED_POINT_SCALE; }
+
+        // Zigzag deltas below this fit in the four bits PACKED_PIXELS gives each coordinate
+        constexpr UInt64_T PACKED_DELTA_LIMIT{ 16 };
+
+        /**
+         * Reads varints and raw values from a chunk, throws on truncated data
+         * */
+        class ChunkCursor {
+        public:
+            ChunkCursor(const std::vector<UInt8_T>& data, Size_T& position) : m_Data{ data }, m_Position{ position } {}
+
+            auto Varint() -> UInt64_T {
+                UInt64_T result{};
+
+                for (UInt32_T shift{}; shift < 64; shift += 7) {
+                    const UInt8_T byte{ Byte() };
+                    result |= static_cast<UInt64_T>(byte & 0x7F) << shift;
+
+                    if ((byte & 0x80) == 0) {
+                        return result;
+                    }
+                }
+
+                MKT_THROW_RUNTIME_ERROR("Corrupt event log chunk, varint too long");
+            }
+
+            auto Byte() -> UInt8_T {
+                Require(1);
+                return m_Data[m_Position++];
+            }
+
+            auto Signed() -> Int64_T { return UnZigZag(Varint()); }
+            auto Int() -> Int32_T { return static_cast<Int32_T>(Signed()); }
+
+            auto Double() -> double {
+                Require(sizeof(double));
+                const double result{ GetFixed<double>(m_Data.data() + m_Position) };
+                m_Position += sizeof(double);
+                return result;
+            }
+
+        private:
+            auto Require(Size_T count) const -> void {
+                if (m_Data.size() - m_Position < count) {
+                    MKT_THROW_RUNTIME_ERROR("Corrupt event log chunk, truncated event");
+                }
+            }
+
+        private:
+            const std::vector<UInt8_T>& m_Data;
+            Size_T& m_Position;
+        };
+    }
+
+    EventLogWriter::EventLogWriter(const Path_T& path, Size_T chunkSize)
+        :   m_Stream{ path, std::ios::binary | std::ios::trunc }
+        ,   m_ChunkSize{ chunkSize }
+    {
+        if (!m_Stream) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not create event log {}", path.string()));
+        }
+
+        std::vector<UInt8_T> header{};
+        PutFixed(header, LOG_MAGIC);
+        PutFixed(header, LOG_VERSION);
+
+        Write(header);
+        m_FileOffset = header.size();
+
+        m_Chunk.reserve(m_ChunkSize + 64);
+    }
+
+    auto EventLogWriter::Write(const std::vector<UInt8_T>& data) -> void {
+        m_Stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+        if (!m_Stream) {
+            MKT_THROW_RUNTIME_ERROR("Could not write to the event log");
+        }
+    }
+
+    auto EventLogWriter::Append(const Event& event) -> bool {
+        // The log decodes the same types EventCodec does
+        if (m_Closed || EventCodec::GetWireSize(event.GetType()) == 0) {
+            return false;
+        }
+
+        // Extend the 32 bit stamp, small backward steps (events queued out of order) are kept as such
+        const UInt32_T stamp{ event.GetTimeStamp() };
+        m_Time = m_EventCount == 0 ? stamp : m_Time + static_cast<UInt64_T>(static_cast<Int64_T>(static_cast<Int32_T>(stamp - m_LastStamp)));
+        m_LastStamp = stamp;
+
+        if (m_ChunkInfo.EventCount == 0) {
+            m_ChunkInfo.FirstTime = m_Time;
+            m_State = { m_Time };
+        }
+
+        UInt64_T flags{ (static_cast<UInt64_T>(event.GetWindowId()) << FLAG_WINDOW_SHIFT) | (event.IsHandled() ? FLAG_HANDLED : 0) };
+        Int64_T fixedX{};
+        Int64_T fixedY{};
+        double rawX{};
+        double rawY{};
+
+        // Previous pair of the same kind, coordinates are stored as deltas from it
+        Int64_T* previousX{};
+        Int64_T* previousY{};
+
+        switch (event.GetType()) {
+            case EventType::KEY_PRESSED_EVENT:
+                flags |= static_cast<const KeyPressedEvent&>(event).IsRepeated() ? FLAG_REPEATED : 0;
+                break;
+            case EventType::MOUSE_MOVED_EVENT:
+                rawX = static_cast<const MouseMovedEvent&>(event).GetPositionX();
+                rawY = static_cast<const MouseMovedEvent&>(event).GetPositionY();
+                previousX = &m_State.PositionX;
+                previousY = &m_State.PositionY;
+                break;
+            case EventType::MOUSE_SCROLLED_EVENT:
+                rawX = static_cast<const MouseScrollEvent&>(event).GetOffsetX();
+                rawY = static_cast<const MouseScrollEvent&>(event).GetOffsetY();
+                previousX = &m_State.OffsetX;
+                previousY = &m_State.OffsetY;
+                break;
+            default:
+                break;
+        }
+
+        CoordinateMode mode{ WHOLE_PIXELS };
+        UInt64_T deltaX{};
+        UInt64_T deltaY{};
+
+        if (!ToFixedPoint(rawX, fixedX) || !ToFixedPoint(rawY, fixedY)) {
+            mode = RAW_DOUBLES;
+        }
+        else if (fixedX % FIXED_POINT_ONE != 0 || fixedY % FIXED_POINT_ONE != 0) {
+            mode = FIXED_POINT;
+        }
+        else if (previousX) {
+            // Both positions are whole pixels here, and so is the difference
+            deltaX = ZigZag((fixedX - *previousX) / FIXED_POINT_ONE);
+            deltaY = ZigZag((fixedY - *previousY) / FIXED_POINT_ONE);
+            mode = deltaX < PACKED_DELTA_LIMIT && deltaY < PACKED_DELTA_LIMIT ? PACKED_PIXELS : WHOLE_PIXELS;
+        }
+
+        UInt64_T tag{ (static_cast<UInt64_T>(event.GetType()) << TAG_FLAG_BITS) | (mode << TAG_COORDINATES_SHIFT) };
+        tag |= flags != 0 ? TAG_HAS_FLAGS : 0;
+
+        PutVarint(m_Chunk, tag);
+
+        if (flags != 0) {
+            PutVarint(m_Chunk, flags);
+        }
+
+        // Delta of delta, a steady event rate costs a single byte
+        const auto timeDelta{ static_cast<Int64_T>(m_Time - m_State.Time) };
+        PutVarint(m_Chunk, ZigZag(timeDelta - m_State.TimeDelta));
+        m_State.Time = m_Time;
+        m_State.TimeDelta = timeDelta;
+
+        // Writes the coordinate pair as deltas from the previous pair of the same kind
+        auto putPair{ [&]() -> void {
+            switch (mode) {
+                case RAW_DOUBLES:
+                    PutFixed(m_Chunk, rawX);
+                    PutFixed(m_Chunk, rawY);
+                    return;
+                case PACKED_PIXELS:
+                    m_Chunk.push_back(static_cast<UInt8_T>(deltaX | (deltaY << 4)));
+                    break;
+                case WHOLE_PIXELS:
+                    PutVarint(m_Chunk, deltaX);
+                    PutVarint(m_Chunk, deltaY);
+                    break;
+                case FIXED_POINT:
+                    PutVarint(m_Chunk, ZigZag(fixedX - *previousX));
+                    PutVarint(m_Chunk, ZigZag(fixedY - *previousY));
+                    break;
+            }
+
+            *previousX = fixedX;
+            *previousY = fixedY;
+        } };
+
+        switch (event.GetType()) {
+            case EventType::WINDOW_RESIZE_EVENT:
+                PutVarint(m_Chunk, ZigZag(static_cast<const WindowResizedEvent&>(event).GetWidth()));
+                PutVarint(m_Chunk, ZigZag(static_cast<const WindowResizedEvent&>(event).GetHeight()));
+                break;
+            case EventType::KEY_PRESSED_EVENT:
+                PutVarint(m_Chunk, ZigZag(static_cast<const KeyPressedEvent&>(event).GetKeyCode()));
+                PutVarint(m_Chunk, ZigZag(static_cast<const KeyPressedEvent&>(event).GetModifiers()));
+                break;
+            case EventType::KEY_RELEASED_EVENT:
+                PutVarint(m_Chunk, ZigZag(static_cast<const KeyReleasedEvent&>(event).GetKeyCode()));
+                break;
+            case EventType::KEY_CHAR_EVENT:
+                PutVarint(m_Chunk, static_cast<const KeyCharEvent&>(event).GetChar());
+                break;
+            case EventType::MOUSE_BUTTON_PRESSED_EVENT:
+                PutVarint(m_Chunk, ZigZag(static_cast<const MouseButtonPressedEvent&>(event).GetMouseButton()));
+                PutVarint(m_Chunk, ZigZag(static_cast<const MouseButtonPressedEvent&>(event).GetModifiers()));
+                break;
+            case EventType::MOUSE_BUTTON_RELEASED_EVENT:
+                PutVarint(m_Chunk, ZigZag(static_cast<const MouseButtonReleasedEvent&>(event).GetMouseButton()));
+                break;
+            case EventType::MOUSE_MOVED_EVENT:
+            case EventType::MOUSE_SCROLLED_EVENT:
+                putPair();
+                break;
+            default:
+                break;
+        }
+
+        ++m_ChunkInfo.EventCount;
+        ++m_EventCount;
+
+        if (m_Chunk.size() >= m_ChunkSize) {
+            Flush();
+        }
+
+        return true;
+    }
+
+    auto EventLogWriter::Flush() -> void {
+        if (m_ChunkInfo.EventCount == 0) {
+            return;
+        }
+
+        std::vector<UInt8_T> header{};
+        PutFixed(header, CHUNK_MAGIC);
+        PutFixed(header, static_cast<UInt32_T>(m_Chunk.size()));
+        PutFixed(header, m_ChunkInfo.EventCount);
+        PutFixed(header, UInt32_T{});
+        PutFixed(header, m_ChunkInfo.FirstTime);
+
+        Write(header);
+        Write(m_Chunk);
+        m_Stream.flush();
+
+        if (!m_Stream) {
+            MKT_THROW_RUNTIME_ERROR("Could not write to the event log");
+        }
+
+        m_ChunkInfo.FileOffset = m_FileOffset;
+        m_Index.push_back(m_ChunkInfo);
+        m_FileOffset += header.size() + m_Chunk.size();
+
+        m_Chunk.clear();
+        m_ChunkInfo = {};
+    }
+
+    auto EventLogWriter::Close() -> void {
+        if (m_Closed) {
+            return;
+        }
+
+        Flush();
+
+        std::vector<UInt8_T> index{};
+        for (const auto& chunk : m_Index) {
+            PutFixed(index, chunk.FileOffset);
+            PutFixed(index, chunk.FirstTime);
+            PutFixed(index, chunk.EventCount);
+            PutFixed(index, UInt32_T{});
+        }
+
+        PutFixed(index, m_FileOffset);
+        PutFixed(index, static_cast<UInt32_T>(m_Index.size()));
+        PutFixed(index, INDEX_MAGIC);
+
+        // Closed first, a failed write leaves no writer to retry with
+        m_Closed = true;
+
+        Write(index);
+        m_Stream.close();
+
+        if (m_Stream.fail()) {
+            MKT_THROW_RUNTIME_ERROR("Could not close the event log");
+        }
+    }
+
+    EventLogWriter::~EventLogWriter() {
+        // Errors can not be reported from here, Close() has to be called to know the log is complete
+        try {
+            Close();
+        }
+        catch (const std::exception&) {}
+    }
+
+    EventLogReader::EventLogReader(const Path_T& path)
+        :   m_Stream{ path, std::ios::binary }
+    {
+        if (!m_Stream) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not open event log {}", path.string()));
+        }
+
+        auto read{ [this](UInt64_T offset, Size_T size) -> std::vector<UInt8_T> {
+            std::vector<UInt8_T> result(size);
+            m_Stream.clear();
+            m_Stream.seekg(static_cast<std::streamoff>(offset));
+            m_Stream.read(reinterpret_cast<char*>(result.data()), static_cast<std::streamsize>(size));
+            result.resize(static_cast<Size_T>(m_Stream.gcount()));
+            return result;
+        } };
+
+        m_Stream.seekg(0, std::ios::end);
+        const auto fileSize{ static_cast<UInt64_T>(m_Stream.tellg()) };
+
+        const auto header{ read(0, FILE_HEADER_SIZE) };
+        if (header.size() < FILE_HEADER_SIZE || GetFixed<UInt32_T>(header.data()) != LOG_MAGIC
+            || GetFixed<UInt32_T>(header.data() + 4) < OLDEST_LOG_VERSION || GetFixed<UInt32_T>(header.data() + 4) > LOG_VERSION) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("{} is not a compatible event log", path.string()));
+        }
+
+        // Index written by Close()
+        if (fileSize >= FILE_HEADER_SIZE + TRAILER_SIZE) {
+            const auto trailer{ read(fileSize - TRAILER_SIZE, TRAILER_SIZE) };
+            const auto indexOffset{ GetFixed<UInt64_T>(trailer.data()) };
+            const auto chunkCount{ GetFixed<UInt32_T>(trailer.data() + 8) };
+
+            if (GetFixed<UInt32_T>(trailer.data() + 12) == INDEX_MAGIC && indexOffset + chunkCount * INDEX_ENTRY_SIZE + TRAILER_SIZE == fileSize) {
+                const auto index{ read(indexOffset, chunkCount * INDEX_ENTRY_SIZE) };
+
+                for (Size_T offset{}; offset < index.size(); offset += INDEX_ENTRY_SIZE) {
+                    m_Index.push_back({ GetFixed<UInt64_T>(index.data() + offset), GetFixed<UInt64_T>(index.data() + offset + 8), GetFixed<UInt32_T>(index.data() + offset + 16) });
+                }
+
+                return;
+            }
+        }
+
+        // No index, walk the chunk headers up to the first incomplete chunk
+        m_Recovered = true;
+
+        for (UInt64_T offset{ FILE_HEADER_SIZE }; offset + CHUNK_HEADER_SIZE <= fileSize;) {
+            const auto chunkHeader{ read(offset, CHUNK_HEADER_SIZE) };
+            const auto byteSize{ GetFixed<UInt32_T>(chunkHeader.data() + 4) };
+
+            if (GetFixed<UInt32_T>(chunkHeader.data()) != CHUNK_MAGIC || offset + CHUNK_HEADER_SIZE + byteSize > fileSize) {
+                break;
+            }
+
+            m_Index.push_back({ offset, GetFixed<UInt64_T>(chunkHeader.data() + 16), GetFixed<UInt32_T>(chunkHeader.data() + 8) });
+            offset += CHUNK_HEADER_SIZE + byteSize;
+        }
+    }
+
+    auto EventLogReader::GetEventCount() const -> UInt64_T {
+        return std::accumulate(m_Index.begin(), m_Index.end(), UInt64_T{}, [](UInt64_T sum, const EventLogChunkInfo& chunk) -> UInt64_T { return sum + chunk.EventCount; });
+    }
+
+    auto EventLogReader::LoadChunk(Size_T chunk) -> bool {
+        if (chunk >= m_Index.size()) {
+            return false;
+        }
+
+        const auto& info{ m_Index[chunk] };
+
+        std::array<UInt8_T, CHUNK_HEADER_SIZE> header{};
+        m_Stream.clear();
+        m_Stream.seekg(static_cast<std::streamoff>(info.FileOffset));
+        m_Stream.read(reinterpret_cast<char*>(header.data()), CHUNK_HEADER_SIZE);
+
+        m_Chunk.resize(GetFixed<UInt32_T>(header.data() + 4));
+        m_Stream.read(reinterpret_cast<char*>(m_Chunk.data()), static_cast<std::streamsize>(m_Chunk.size()));
+
+        if (!m_Stream || GetFixed<UInt32_T>(header.data()) != CHUNK_MAGIC) {
+            MKT_THROW_RUNTIME_ERROR("Corrupt event log, could not read chunk");
+        }
+
+        m_Cursor = 0;
+        m_NextChunk = chunk + 1;
+
+        // Every chunk starts from a clean delta state
+        m_Time = info.FirstTime;
+        m_TimeDelta = 0;
+        m_PositionX = m_PositionY = m_OffsetX = m_OffsetY = 0;
+        return true;
+    }
+
+    auto EventLogReader::DecodeNext() -> std::unique_ptr<Event> {
+        using namespace EventManager;
+
+        while (m_Cursor >= m_Chunk.size()) {
+            if (!LoadChunk(m_NextChunk)) {
+                return nullptr;
+            }
+        }
+
+        ChunkCursor cursor{ m_Chunk, m_Cursor };
+
+        const UInt64_T tag{ cursor.Varint() };
+        const UInt64_T flags{ (tag & TAG_HAS_FLAGS) ? cursor.Varint() : 0 };
+
+        m_TimeDelta += cursor.Signed();
+        m_Time += static_cast<UInt64_T>(m_TimeDelta);
+
+        const auto type{ static_cast<EventType>(tag >> TAG_FLAG_BITS) };
+        const auto mode{ static_cast<CoordinateMode>((tag >> TAG_COORDINATES_SHIFT) & 0x3) };
+
+        auto readPair{ [&](Int64_T& previousX, Int64_T& previousY) -> std::pair<double, double> {
+            if (mode == RAW_DOUBLES) {
+                const double x{ cursor.Double() };
+                return { x, cursor.Double() };
+            }
+
+            if (mode == PACKED_PIXELS) {
+                const UInt64_T packed{ cursor.Byte() };
+                previousX += UnZigZag(packed & 0xF) * FIXED_POINT_ONE;
+                previousY += UnZigZag(packed >> 4) * FIXED_POINT_ONE;
+                return { FromFixedPoint(previousX), FromFixedPoint(previousY) };
+            }
+
+            const Int64_T scale{ mode == WHOLE_PIXELS ? FIXED_POINT_ONE : 1 };
+            previousX += cursor.Signed() * scale;
+            previousY += cursor.Signed() * scale;
+            return { FromFixedPoint(previousX), FromFixedPoint(previousY) };
+        } };
+
+        std::unique_ptr<Event> result{};
+
+        switch (type) {
+            case EventType::WINDOW_RESIZE_EVENT: {
+                const Int32_T width{ cursor.Int() };
+                result = MakeEvent<WindowResizedEvent>(width, cursor.Int());
+                break;
+            }
+            case EventType::WINDOW_CLOSE_EVENT:             result = MakeEvent<WindowCloseEvent>(); break;
+            case EventType::APP_RENDER_EVENT:               result = MakeEvent<AppRender>(); break;
+            case EventType::APP_UPDATE_EVENT:               result = MakeEvent<AppUpdate>(); break;
+            case EventType::APP_TICK_EVENT:                 result = MakeEvent<AppTick>(); break;
+            case EventType::KEY_PRESSED_EVENT: {
+                const Int32_T keyCode{ cursor.Int() };
+                result = MakeEvent<KeyPressedEvent>(keyCode, (flags & FLAG_REPEATED) != 0, cursor.Int());
+                break;
+            }
+            case EventType::KEY_RELEASED_EVENT:             result = MakeEvent<KeyReleasedEvent>(cursor.Int()); break;
+            case EventType::KEY_CHAR_EVENT:                 result = MakeEvent<KeyCharEvent>(static_cast<UInt32_T>(cursor.Varint())); break;
+            case EventType::MOUSE_BUTTON_PRESSED_EVENT: {
+                const Int32_T button{ cursor.Int() };
+                result = MakeEvent<MouseButtonPressedEvent>(button, cursor.Int());
+                break;
+            }
+            case EventType::MOUSE_BUTTON_RELEASED_EVENT:    result = MakeEvent<MouseButtonReleasedEvent>(cursor.Int()); break;
+            case EventType::MOUSE_MOVED_EVENT: {
+                const auto [x, y]{ readPair(m_PositionX, m_PositionY) };
+                result = MakeEvent<MouseMovedEvent>(x, y);
+                break;
+            }
+            case EventType::MOUSE_SCROLLED_EVENT: {
+                const auto [x, y]{ readPair(m_OffsetX, m_OffsetY) };
+                result = MakeEvent<MouseScrollEvent>(x, y);
+                break;
+            }
+            default:
+                MKT_THROW_RUNTIME_ERROR(fmt::format("Corrupt event log chunk, unknown event type {}", static_cast<UInt32_T>(type)));
+        }
+
+        result->SetTimeStamp(static_cast<UInt32_T>(m_Time));
+        result->SetHandled((flags & FLAG_HANDLED) != 0);
+        result->SetWindowId(static_cast<WindowId_T>(flags >> FLAG_WINDOW_SHIFT));
+        return result;
+    }
+
+    auto EventLogReader::Next() -> std::unique_ptr<Event> {
+        if (m_Pending) {
+            m_Time = m_PendingTime;
+            return std::move(m_Pending);
+        }
+
+        return DecodeNext();
+    }
+
+    auto EventLogReader::Seek(UInt64_T offset) -> void {
+        m_Pending.reset();
+        m_Chunk.clear();
+        m_Cursor = 0;
+
+        const UInt64_T target{ GetStartTime() + offset };
+
+        // Last chunk starting at or before the target
+        const auto next{ std::upper_bound(m_Index.begin(), m_Index.end(), target,
+                                          [](UInt64_T time, const EventLogChunkInfo& chunk) -> bool { return time < chunk.FirstTime; }) };
+        m_NextChunk = next == m_Index.begin() ? 0 : static_cast<Size_T>(std::distance(m_Index.begin(), next)) - 1;
+
+        while (auto event{ DecodeNext() }) {
+            if (m_Time >= target) {
+                m_Pending = std::move(event);
+                m_PendingTime = m_Time;
+                return;
+            }
+        }
+    }
+}
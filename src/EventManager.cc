@@ -7,78 +7,1017 @@
 #include <utility>
 #include <algorithm>
 #include <iterator>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <deque>
+#include <bit>
+#include <vector>
 
 // Project Headers
 #include <Types.hh>
+#include <Logger.hh>
+#include <EventTask.hh>
+#include <EventFilter.hh>
 #include <EventManager.hh>
 
 namespace Mikoto::EventManager {
-    // For now Container is expected to be a vector,
-    // will probably change to another container
-    template<typename Container, typename Iterator>
-    concept HasEraseMember = std::random_access_iterator<Iterator> &&
-                            requires (Container cont, Iterator it) { cont.erase(it); };
+    /**
+     * Snapshot replaced in a dispatch table, kept together with the handlers
+     * removed along with it until no reader can reach them anymore
+     * */
+    struct RetiredSnapshot {
+        std::unique_ptr<const HandlerSnapshot> Snapshot{};
+        Handlers_T Released{};
+        UInt64_T Epoch{};
+    };
+
+    // Epoch of a reader outside of any DispatchReadGuard
+    static constexpr UInt64_T IDLE_READER_EPOCH{ std::numeric_limits<UInt64_T>::max() };
+
+    struct alignas(64) DispatchReader {
+        std::atomic<bool> Claimed{};
+        std::atomic<UInt64_T> Epoch{ IDLE_READER_EPOCH };
+    };
+
+    /**
+     * Epoch based reclamation shared by every dispatch table. Each retirement moves the
+     * global epoch forward once the snapshot has been replaced, and a reader announces the
+     * epoch it sees when it starts reading: a reader which saw a later epoch than the one
+     * a snapshot was retired in can only load the snapshot replacing it. The snapshots
+     * retired before the oldest announced epoch are released, on the next retirement or
+     * when a reader leaves its outermost guard
+     * */
+    struct DispatchEpochs {
+        std::atomic<UInt64_T> Epoch{};
+        std::array<DispatchReader, MAX_DISPATCH_READER_COUNT> Readers{};
+
+        // Ordered by epoch, the epoch is taken under the lock. Reclaiming pops a prefix
+        std::mutex RetiredMutex{};
+        std::deque<RetiredSnapshot> Retired{};
+
+        // Size of Retired, read without the lock so idle readers skip it
+        std::atomic<Size_T> RetiredCount{};
+    };
+
+    static auto GetDispatchEpochs() -> DispatchEpochs& {
+        static DispatchEpochs epochs{};
+        return epochs;
+    }
+
+    /**
+     * Reader slot of the calling thread, claimed on first use and given back when the thread exits
+     * */
+    class DispatchReaderHandle {
+    public:
+        DispatchReaderHandle() {
+            for (auto& reader : GetDispatchEpochs().Readers) {
+                bool claimed{};
+
+                if (reader.Claimed.compare_exchange_strong(claimed, true, std::memory_order_acquire)) {
+                    m_Reader = std::addressof(reader);
+                    return;
+                }
+            }
+
+            MKT_THROW_RUNTIME_ERROR(fmt::format("More than {} threads are reading dispatch tables", MAX_DISPATCH_READER_COUNT));
+        }
+
+        MKT_NODISCARD auto Get() const -> DispatchReader& { return *m_Reader; }
+        MKT_NODISCARD auto GetDepth() -> UInt32_T& { return m_Depth; }
+
+        ~DispatchReaderHandle() {
+            m_Reader->Claimed.store(false, std::memory_order_release);
+        }
+
+    private:
+        DispatchReader* m_Reader{};
+        UInt32_T m_Depth{};
+    };
+
+    static auto GetDispatchReaderHandle() -> DispatchReaderHandle& {
+        static thread_local DispatchReaderHandle handle{};
+        return handle;
+    }
+
+    DispatchReadGuard::DispatchReadGuard() {
+        auto& handle{ GetDispatchReaderHandle() };
+
+        if (handle.GetDepth()++ != 0) {
+            return;
+        }
+
+        handle.Get().Epoch.store(GetDispatchEpochs().Epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+
+        // Pairs with the fence of RetireSnapshot(): either the reclamation sees this
+        // epoch or the snapshots loaded from now on are the ones replacing what it releases
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    /**
+     * Moves out the snapshots retired before the oldest epoch a reader announced.
+     * RetiredMutex must be held, the snapshots are released by the caller out of it
+     * since handlers may run arbitrary destructors
+     * @param epochs reclamation state
+     * @param reclaimed receives the snapshots no reader can reach anymore
+     * */
+    static auto CollectReclaimable(DispatchEpochs& epochs, std::vector<RetiredSnapshot>& reclaimed) -> void {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        UInt64_T oldest{ IDLE_READER_EPOCH };
+        for (const auto& reader : epochs.Readers) {
+            oldest = std::min(oldest, reader.Epoch.load(std::memory_order_acquire));
+        }
+
+        while (!epochs.Retired.empty() && epochs.Retired.front().Epoch < oldest) {
+            reclaimed.push_back(std::move(epochs.Retired.front()));
+            epochs.Retired.pop_front();
+        }
+
+        epochs.RetiredCount.store(epochs.Retired.size(), std::memory_order_relaxed);
+    }
+
+    DispatchReadGuard::~DispatchReadGuard() {
+        auto& handle{ GetDispatchReaderHandle() };
+
+        if (--handle.GetDepth() != 0) {
+            return;
+        }
+
+        handle.Get().Epoch.store(IDLE_READER_EPOCH, std::memory_order_release);
+
+        // This reader may have been the one holding retired snapshots back. Skipped if
+        // another thread is already reclaiming, the next retirement or reader does it
+        auto& epochs{ GetDispatchEpochs() };
+
+        if (epochs.RetiredCount.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+
+        std::vector<RetiredSnapshot> reclaimed{};
+
+        if (std::unique_lock lock{ epochs.RetiredMutex, std::try_to_lock }; lock.owns_lock()) {
+            CollectReclaimable(epochs, reclaimed);
+        }
+    }
+
+    /**
+     * Hands over a replaced snapshot and the handlers removed with it, then
+     * releases everything retired before the oldest epoch a reader announced
+     * @param snapshot replaced snapshot, may be null
+     * @param released handlers no longer in the table
+     * */
+    static auto RetireSnapshot(const HandlerSnapshot* snapshot, Handlers_T&& released) -> void {
+        auto& epochs{ GetDispatchEpochs() };
+
+        // Released out of the lock, handlers may run arbitrary destructors
+        std::vector<RetiredSnapshot> reclaimed{};
+        {
+            std::scoped_lock lock{ epochs.RetiredMutex };
+
+            // Taken under the lock so the retired list stays ordered by epoch
+            const UInt64_T epoch{ epochs.Epoch.fetch_add(1, std::memory_order_seq_cst) };
+
+            if (snapshot || !released.empty()) {
+                epochs.Retired.push_back({ std::unique_ptr<const HandlerSnapshot>{ snapshot }, std::move(released), epoch });
+            }
+
+            CollectReclaimable(epochs, reclaimed);
+        }
+    }
+
+    auto DispatchTable::GetLists(const EventHandlerWrapper& handler) -> HandlerLists_T& {
+        const WindowId_T window{ handler.GetWindow() };
+
+        if (window == ANY_WINDOW_ID) {
+            return m_Lists;
+        }
+
+        if (window > MAX_WINDOW_COUNT) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Window id {} is out of range, ids go up to {}", window, MAX_WINDOW_COUNT));
+        }
+
+        auto& slot{ m_WindowLists[window - 1] };
+
+        if (auto* lists{ slot.load(std::memory_order_acquire) }) {
+            return *lists;
+        }
+
+        std::scoped_lock lock{ m_WindowListsMutex };
+
+        if (auto* lists{ slot.load(std::memory_order_relaxed) }) {
+            return *lists;
+        }
+
+        auto* lists{ new HandlerLists_T{} };
+        slot.store(lists, std::memory_order_release);
+
+        return *lists;
+    }
+
+    auto DispatchTable::Publish(std::atomic<const HandlerSnapshot*>& list, std::unique_ptr<HandlerSnapshot>&& snapshot, Handlers_T&& released) -> void {
+        const auto* previous{ list.exchange(snapshot.release(), std::memory_order_acq_rel) };
+        RetireSnapshot(previous, std::move(released));
+    }
+
+    auto DispatchTable::Insert(UInt64_T subId, const HandlerPtr_T& handler) -> void {
+        const Size_T index{ GetList(*handler) };
+        auto& list{ GetLists(*handler)[index] };
+
+        std::scoped_lock lock{ m_WriteMutexes[index] };
+
+        auto snapshot{ std::make_unique<HandlerSnapshot>() };
+
+        // Writers of the list are serialized by its lock, the current snapshot is the last one published
+        if (const auto* current{ list.load(std::memory_order_relaxed) }) {
+            snapshot->Entries.reserve(current->Entries.size() + 1);
+            snapshot->Entries = current->Entries;
+        }
+
+        snapshot->Entries.push_back({ subId, handler.get() });
+
+        Publish(list, std::move(snapshot), {});
+    }
+
+    auto DispatchTable::Erase(Handlers_T&& handlers) -> void {
+        const auto byList{ [](const HandlerPtr_T& handler) -> std::tuple<WindowId_T, Size_T, const EventHandlerWrapper*> {
+            return { handler->GetWindow(), GetList(*handler), handler.get() };
+        } };
+
+        // Grouped by window and list so each list is copied once, sorted by address within it for lookups
+        std::ranges::sort(handlers, std::less<>{}, byList);
+
+        auto first{ handlers.begin() };
+        while (first != handlers.end()) {
+            const WindowId_T window{ (*first)->GetWindow() };
+            const Size_T index{ GetList(**first) };
+            const auto last{ std::find_if(first, handlers.end(), [&](const HandlerPtr_T& handler) -> bool { return handler->GetWindow() != window || GetList(*handler) != index; }) };
+
+            auto& list{ GetLists(**first)[index] };
+
+            Handlers_T released{ std::make_move_iterator(first), std::make_move_iterator(last) };
+            first = last;
+
+            const auto isReleased{ [&](const DispatchEntry& entry) -> bool {
+                return std::ranges::binary_search(released, entry.Handler, std::less<>{}, [](const HandlerPtr_T& handler) -> const EventHandlerWrapper* { return handler.get(); });
+            } };
+
+            std::scoped_lock lock{ m_WriteMutexes[index] };
+
+            auto snapshot{ std::make_unique<HandlerSnapshot>() };
+
+            if (const auto* current{ list.load(std::memory_order_relaxed) }) {
+                snapshot->Entries.reserve(current->Entries.size());
+                std::ranges::remove_copy_if(current->Entries, std::back_inserter(snapshot->Entries), isReleased);
+            }
+
+            if (snapshot->Entries.empty()) {
+                snapshot.reset();
+            }
+
+            Publish(list, std::move(snapshot), std::move(released));
+        }
+    }
+
+    auto DispatchTable::Clear() -> void {
+        const auto clear{ [&](HandlerLists_T& lists) -> void {
+            for (Size_T index{}; index < lists.size(); ++index) {
+                std::scoped_lock lock{ m_WriteMutexes[index] };
+                Publish(lists[index], nullptr, {});
+            }
+        } };
+
+        clear(m_Lists);
+
+        for (auto& slot : m_WindowLists) {
+            if (auto* lists{ slot.load(std::memory_order_acquire) }) {
+                clear(*lists);
+            }
+        }
+    }
+
+    DispatchTable::~DispatchTable() {
+        for (auto& list : m_Lists) {
+            delete list.load(std::memory_order_relaxed);
+        }
+
+        for (auto& slot : m_WindowLists) {
+            if (auto* lists{ slot.load(std::memory_order_relaxed) }) {
+                for (auto& list : *lists) {
+                    delete list.load(std::memory_order_relaxed);
+                }
+
+                delete lists;
+            }
+        }
+    }
+
+    /**
+     * Events queued by a producer thread, published all at once. Owned by its producer,
+     * reused once ProcessEvents() has taken its events
+     * */
+    struct AsyncEventBatch {
+        std::vector<std::unique_ptr<Event>> Events{};
+
+        // Next batch in the stack of published batches
+        AsyncEventBatch* Next{};
+
+        // Set while the batch is published and its events not taken yet
+        std::atomic<bool> InFlight{};
+    };
+
+    /**
+     * Buffers of one producer thread for one bus. Kept as long as the bus queue,
+     * a thread that exits leaves its producer to be adopted by a new thread
+     * */
+    struct AsyncEventProducer {
+        AsyncEventBatch* Current{};
+        std::vector<std::unique_ptr<AsyncEventBatch>> Batches{};
+        std::atomic<bool> Retired{};
+    };
+
+    /**
+     * Published batches of a bus form a lock free stack, producers push a whole batch with
+     * one compare and swap and ProcessEvents() takes the whole stack with one exchange
+     * */
+    struct AsyncEventQueue {
+        std::atomic<AsyncEventBatch*> Head{};
+
+        std::mutex ProducersMutex{};
+        std::vector<std::unique_ptr<AsyncEventProducer>> Producers{};
+    };
+
+    /**
+     * Pushes the current batch of the producer on the stack of the queue
+     * */
+    static auto PublishAsyncBatch(AsyncEventQueue& queue, AsyncEventProducer& producer) -> void {
+        auto* batch{ std::exchange(producer.Current, nullptr) };
+
+        if (!batch || batch->Events.empty()) {
+            producer.Current = batch;
+            return;
+        }
+
+        batch->InFlight.store(true, std::memory_order_relaxed);
+        batch->Next = queue.Head.load(std::memory_order_relaxed);
+
+        while (!queue.Head.compare_exchange_weak(batch->Next, batch, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+
+    /**
+     * Producers of the calling thread, one per bus it queued events on. Publishes
+     * what is left in them when the thread exits
+     * */
+    class AsyncEventProducers {
+    public:
+        MKT_NODISCARD auto Get(const std::shared_ptr<AsyncEventQueue>& queue) -> AsyncEventProducer& {
+            // A thread feeds one or two buses, looking them up in order is enough
+            for (auto& [owner, producer] : m_Producers) {
+                if (owner == queue) {
+                    return *producer;
+                }
+            }
+
+            // Once per thread and bus
+            std::scoped_lock lock{ queue->ProducersMutex };
+
+            auto retired{ std::ranges::find_if(queue->Producers, [](const auto& producer) -> bool { return producer->Retired.load(std::memory_order_relaxed); }) };
+            auto* producer{ retired != queue->Producers.end() ? retired->get() : queue->Producers.emplace_back(std::make_unique<AsyncEventProducer>()).get() };
+            producer->Retired.store(false, std::memory_order_relaxed);
+
+            m_Producers.emplace(m_Producers.begin(), queue, producer);
+            return *producer;
+        }
+
+        ~AsyncEventProducers() {
+            for (auto& [queue, producer] : m_Producers) {
+                PublishAsyncBatch(*queue, *producer);
+
+                std::scoped_lock lock{ queue->ProducersMutex };
+                producer->Retired.store(true, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        // The queue is kept alive by its producer threads, a bus may go away before them
+        std::vector<std::pair<std::shared_ptr<AsyncEventQueue>, AsyncEventProducer*>> m_Producers{};
+    };
+
+    static auto GetAsyncEventProducers() -> AsyncEventProducers& {
+        static thread_local AsyncEventProducers producers{};
+        return producers;
+    }
+
+    /**
+     * Packed view of the current frame used by the batch filters. Kept between
+     * frames so the arrays only allocate when the queue grows past its previous size
+     * */
+    struct FrameTags {
+        std::vector<UInt8_T> Types{};
+        std::vector<UInt32_T> Categories{};
+        std::vector<UInt8_T> Windows{};
+        std::vector<UInt64_T> Matches{};
+        std::vector<UInt64_T> WindowMatches{};
+        std::vector<UInt64_T> PendingForBackground{};
+    };
+
+    static_assert(MAX_EVENT_TYPE_COUNT <= 256, "Event types must fit the packed 8 bit tags");
+    static_assert(MAX_WINDOW_COUNT < 256, "Window ids must fit the packed 8 bit tags");
+
+    EventBus::EventBus(EventBusSpec spec)
+        :   m_Spec{ std::move(spec) }
+        ,   m_AsyncQueue{ std::make_shared<AsyncEventQueue>() }
+        ,   m_FrameTags{ std::make_unique<FrameTags>() }
+    {
+
+    }
+
+    auto EventBus::IsDefault() const -> bool {
+        return this == std::addressof(GetDefaultEventBus());
+    }
+
+    /**
+     * Throws if the bus is bound to a thread other than the calling one
+     * @param operation what was attempted, for the message
+     * */
+    auto EventBus::CheckBoundThread(std::string_view operation) const -> void {
+        if (!IsOnBoundThread()) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("{} on event bus {} outside of the thread it is bound to", operation, m_Spec.Name));
+        }
+    }
+
+    /**
+     * Hands the last events of the sticky types to a new handler, the ones it would have
+     * received, in window order. Copied under the lock, ProcessEvents() may be storing
+     * new ones on its thread
+     * @param wrapper handler just subscribed
+     * */
+    auto EventBus::ReplaySticky(EventHandlerWrapper& wrapper) -> void {
+        std::vector<std::unique_ptr<Event>> latest{};
+        {
+            std::scoped_lock lock{ m_StickyMutex };
+
+            for (const auto& slot : m_StickySlots) {
+                if (!slot) {
+                    continue;
+                }
+
+                // One event per window, a handler of every window gets the state of each
+                for (WindowId_T window{}; window <= MAX_WINDOW_COUNT; ++window) {
+                    if (const auto* event{ slot->Get(window) }; event && wrapper.Matches(*event)) {
+                        latest.push_back(slot->Copy(window));
+                    }
+                }
+            }
+        }
+
+        for (const auto& event : latest) {
+            wrapper.Exec(*event);
+        }
+    }
+
+    /**
+     * Runs the handler and updates its watchdog bookkeeping. A handler which goes over
+     * the budget StrikeLimit times in a row is reported once and, if the spec asks for it, demoted.
+     * @param subId identifier of the subscriber owning the handler
+     * @param wrapper handler to be run
+     * @param event event passed to the handler
+     * */
+    auto EventBus::ExecWatched(UInt64_T subId, EventHandlerWrapper& wrapper, Event& event) -> void {
+        const auto& spec{ m_Spec.Watchdog };
+
+        if (m_DispatchObserver) {
+            m_DispatchObserver->OnDispatch(subId, event);
+        }
+
+        const auto start{ std::chrono::steady_clock::now() };
+        wrapper.Exec(event);
+        const auto elapsed{ std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start) };
+
+        wrapper.SetWorstTime(std::max(wrapper.GetWorstTime(), elapsed));
+
+        if (elapsed <= spec.Budget) {
+            wrapper.SetStrikes(0);
+            return;
+        }
+
+        wrapper.SetStrikes(wrapper.GetStrikes() + 1);
+
+        if (wrapper.GetStrikes() >= spec.StrikeLimit && !wrapper.IsReported()) {
+            wrapper.SetReported(true);
+
+            // Events of this pass already queued for it, or not, stay where they are
+            const bool demote{ spec.DemoteSlowHandlers && !GetVirtualEventClock().Enabled.load(std::memory_order_relaxed) };
+            if (demote) {
+                m_PendingDemotions.push_back(std::addressof(wrapper));
+            }
+
+            MKT_CORE_LOGGER_WARN("Slow handler on bus {}. Subscriber {} on {} went over the {} us budget {} times in a row (worst {} us){}",
+                                 m_Spec.Name, subId, GetEventFormattedStr(wrapper.GetType()), spec.Budget.count(), wrapper.GetStrikes(),
+                                 std::chrono::duration_cast<std::chrono::microseconds>(wrapper.GetWorstTime()).count(),
+                                 demote ? ". Demoted to background lane from the next pass on" : "");
+        }
+    }
+
+    auto EventBus::Unsubscribe(UInt64_T subId, EventType type) -> void {
+        RemoveSubscriptions(subId, [&](const HandlerPtr_T& wrapper) -> bool { return !wrapper->IsCategoryHandler() && wrapper->GetType() == type; });
+    }
+
+    auto EventBus::Unsubscribe(UInt64_T subId, EventCategory category) -> void {
+        RemoveSubscriptions(subId, [&](const HandlerPtr_T& wrapper) -> bool { return wrapper->GetCategory() == category; });
+    }
+
+    auto EventBus::UnsubscribeWindow(UInt64_T subId, WindowId_T window) -> void {
+        RemoveSubscriptions(subId, [&](const HandlerPtr_T& wrapper) -> bool { return wrapper->GetWindow() == window; });
+    }
+
+    auto EventBus::ReleaseWindow(WindowId_T window) -> void {
+        if (window == ANY_WINDOW_ID) {
+            return;
+        }
+
+        const auto matches{ [&](const HandlerPtr_T& wrapper) -> bool { return wrapper->GetWindow() == window; } };
+
+        {
+            std::scoped_lock lock{ m_PendingSubscriptionsMutex };
+            std::erase_if(m_PendingSubscriptions, [&](const PendingSubscription& entry) -> bool { return matches(entry.Handler); });
+
+            // Removed from the dispatch table too, the window lists are left empty for the next owner of the id
+            m_Subscribers.RemoveIf(matches);
+        }
+
+        // Ids past the limit share the entry of the events of no window, which stay
+        if (window > MAX_WINDOW_COUNT) {
+            return;
+        }
+
+        m_ReleasedWindows.fetch_or(UInt32_T{ 1 } << (window - 1), std::memory_order_relaxed);
+
+        // The slots belong to the bus thread, the next pass drops the events otherwise
+        if (IsOnBoundThread()) {
+            ClearReleasedWindows();
+        }
+    }
+
+    /**
+     * Drops the sticky events of the windows released since the last call
+     * */
+    auto EventBus::ClearReleasedWindows() -> void {
+        auto released{ m_ReleasedWindows.exchange(0, std::memory_order_relaxed) };
+
+        if (released == 0) {
+            return;
+        }
+
+        std::scoped_lock lock{ m_StickyMutex };
+
+        for (; released != 0; released &= released - 1) {
+            const auto window{ static_cast<WindowId_T>(std::countr_zero(released) + 1) };
+
+            for (auto& slot : m_StickySlots) {
+                if (slot) {
+                    slot->Clear(window);
+                }
+            }
+        }
+    }
+
+    /**
+     * Adds the handler right away on the thread processing the bus. From another thread of a bound
+     * bus it is left for the bus thread, which publishes it and replays its sticky events before
+     * dispatching anything else, so the handler runs on one thread and never sees an older state
+     * after a newer one
+     * @param subId identifier for the subscriber object
+     * @param wrapper handler to be added
+     * */
+    auto EventBus::AddSubscription(UInt64_T subId, HandlerPtr_T&& wrapper) -> void {
+        if (!IsOnBoundThread()) {
+            std::scoped_lock lock{ m_PendingSubscriptionsMutex };
+            m_PendingSubscriptions.push_back({ subId, std::move(wrapper) });
+            return;
+        }
+
+        m_Subscribers.Add(subId, wrapper);
+        ReplaySticky(*wrapper);
+    }
+
+    /**
+     * Publishes the handlers subscribed from other threads, then hands them their sticky events
+     * */
+    auto EventBus::PublishPendingSubscriptions() -> void {
+        {
+            // Added under the lock, an Unsubscribe() looks at both the pending list and the registry
+            std::scoped_lock lock{ m_PendingSubscriptionsMutex };
+
+            if (m_PendingSubscriptions.empty()) {
+                return;
+            }
+
+            m_PublishingSubscriptions.swap(m_PendingSubscriptions);
+
+            for (const auto& [subId, wrapper] : m_PublishingSubscriptions) {
+                m_Subscribers.Add(subId, wrapper);
+            }
+        }
+
+        // Replayed without the lock, handlers may change subscriptions
+        for (const auto& entry : m_PublishingSubscriptions) {
+            ReplaySticky(*entry.Handler);
+        }
+
+        m_PublishingSubscriptions.clear();
+    }
+
+    auto EventBus::UnsubscribeBatch(UInt64_T subId, EventType type) -> void {
+        CheckBoundThread("Batch subscription changed");
+
+        auto& channel{ m_BatchChannels[static_cast<Size_T>(type)] };
+
+        if (channel) {
+            channel->Unsubscribe(subId);
+        }
+    }
+
+    auto EventBus::QueueQuery(std::function<void()>&& resolve) -> void {
+        std::scoped_lock lock{ m_QueriesMutex };
+        m_PendingQueries.push_back(std::move(resolve));
+    }
 
     /**
-     * Erase elements from a container that meets the Unary predicate "filter".
-     * Container must be iterable and offer erase() operation which takes an iterator and returns
-     * an iterator to the erased element
+     * Answers the queued queries. They are taken out under the lock
+     * and answered without it, so responders may queue queries again
      * */
-    template<typename FilterFuncType, typename Container>
-        requires HasEraseMember<Container, typename Container::iterator>
-    static auto EraseWithFilter(Container& container, const FilterFuncType& filter) -> void {
-        auto begin{ container.begin() };
+    auto EventBus::ResolvePendingQueries() -> void {
+        {
+            std::scoped_lock lock{ m_QueriesMutex };
+            m_ResolvingQueries.swap(m_PendingQueries);
+        }
+
+        for (auto& resolve : m_ResolvingQueries) {
+            resolve();
+        }
+
+        m_ResolvingQueries.clear();
+    }
 
-        for ( ; begin != container.end(); ++begin) {
-            if (filter(*begin)) {
-                begin = container.erase(begin);
+    auto EventBus::QueueEventAsync(std::unique_ptr<Event>&& event) -> void {
+        auto& producer{ GetAsyncEventProducers().Get(m_AsyncQueue) };
+
+        if (!producer.Current) {
+            // A batch whose events were taken already, or a new one if all are in flight
+            auto available{ std::ranges::find_if(producer.Batches, [](const auto& batch) -> bool { return !batch->InFlight.load(std::memory_order_acquire); }) };
+
+            // Not reserved, QueueEvent() from another thread publishes batches of one event.
+            // A batch keeps its storage when reused, so it only grows the first time
+            if (available == producer.Batches.end()) {
+                available = producer.Batches.insert(available, std::make_unique<AsyncEventBatch>());
+            }
+
+            producer.Current = available->get();
+        }
+
+        producer.Current->Events.push_back(std::move(event));
+
+        if (producer.Current->Events.size() >= ASYNC_EVENT_BATCH_SIZE) {
+            PublishAsyncBatch(*m_AsyncQueue, producer);
+        }
+    }
+
+    auto EventBus::FlushAsyncEvents() -> void {
+        PublishAsyncBatch(*m_AsyncQueue, GetAsyncEventProducers().Get(m_AsyncQueue));
+    }
+
+    /**
+     * Takes every published batch and hands its events to the function, batches of
+     * a producer in the order they were published. The batches go back to their producers
+     * */
+    template<typename FunctionType>
+    auto EventBus::TakeAsyncEvents(FunctionType&& function) -> void {
+        auto* batch{ m_AsyncQueue->Head.exchange(nullptr, std::memory_order_acquire) };
+
+        // The stack holds the last published batch first
+        AsyncEventBatch* ordered{};
+        while (batch) {
+            auto* next{ batch->Next };
+            batch->Next = ordered;
+            ordered = batch;
+            batch = next;
+        }
+
+        while (ordered) {
+            auto* next{ ordered->Next };
+
+            for (auto& event : ordered->Events) {
+                function(std::move(event));
             }
+
+            ordered->Events.clear();
+            ordered->InFlight.store(false, std::memory_order_release);
+            ordered = next;
         }
     }
 
-    auto Unsubscribe(UInt64_T subId, EventType type) -> void {
-        auto& subscribers{ GetSubscribers() };
+    /**
+     * Runs the category handlers over the whole frame. Each handler gets its match
+     * mask computed in one pass over the packed categories, the events themselves
+     * are only touched for the ones that match. Handlers bound to a window have
+     * their masks narrowed to the events of the window, computed once per window
+     * */
+    auto EventBus::DispatchCategoryHandlers() -> void {
+        auto& tags{ *m_FrameTags };
+
+        const auto dispatch{ [&](std::span<const DispatchEntry> handlers, bool byWindow) -> void {
+            for (const auto& [subId, handlerWrapper] : handlers) {
+                EventFilter::MatchCategories(tags.Categories, handlerWrapper->GetCategory(), tags.Matches);
 
-        auto it{ subscribers.find(subId) };
-        if (it != subscribers.end()) {
-            // TODO: maybe change container to set
-            EraseWithFilter(it->second, [&](const EventHandlerWrapper& wrapper) -> bool { return wrapper.GetType() == type; });
+                if (byWindow) {
+                    std::transform(tags.Matches.begin(), tags.Matches.end(), tags.WindowMatches.begin(),
+                                   tags.Matches.begin(), std::bit_and<>{});
+                }
+
+                if (handlerWrapper->IsDemoted()) {
+                    std::transform(tags.Matches.begin(), tags.Matches.end(), tags.PendingForBackground.begin(),
+                                   tags.PendingForBackground.begin(), std::bit_or<>{});
+                    continue;
+                }
+
+                EventFilter::ForEachMatch(tags.Matches, [&](Size_T index) -> void { ExecWatched(subId, *handlerWrapper, *m_EventQueue[index]); });
+            }
+        } };
+
+        dispatch(m_DispatchTable.GetCategoryHandlers(), false);
+
+        for (Size_T window{ 1 }; window <= MAX_WINDOW_COUNT; ++window) {
+            const auto handlers{ m_DispatchTable.GetCategoryHandlers(static_cast<WindowId_T>(window)) };
+
+            if (handlers.empty()) {
+                continue;
+            }
+
+            tags.WindowMatches.resize(tags.Matches.size());
+            EventFilter::MatchTypes(tags.Windows, static_cast<UInt8_T>(window), tags.WindowMatches);
+
+            dispatch(handlers, true);
         }
     }
 
-    auto Unsubscribe(UInt64_T subId, EventCategory category) -> void {
-        auto& subscribers{ GetSubscribers() };
+    /**
+     * Delivers the events published on named channels. Each channel already holds the
+     * list of handlers matching it, so this is a plain walk over that list
+     * */
+    auto EventBus::DispatchChannelEvents() -> void {
+        // Handlers may publish again, those events are delivered on the next call
+        auto& pending{ m_DeliveringChannelEvents };
+        pending.swap(m_ChannelQueue);
+
+        for (auto& [channel, payload] : pending) {
+            // Walked over a copy, handlers may register channels or change subscriptions
+            // while it is being walked. Those changes apply from the next event on
+            auto& handlers{ m_DeliveringChannelHandlers };
+            handlers.assign(m_TopicRouter.GetHandlers(channel).begin(), m_TopicRouter.GetHandlers(channel).end());
 
-        auto it{ subscribers.find(subId) };
-        if (it != subscribers.end()) {
-            // TODO: maybe change container to set
-            EraseWithFilter(it->second, [&](const EventHandlerWrapper& wrapper) -> bool { return wrapper.GetCategory() == category; });
+            for (const auto& subscription : handlers) {
+                subscription->Handler(*payload);
+            }
         }
+
+        m_DeliveringChannelHandlers.clear();
+        pending.clear();
     }
 
-    auto ProcessEvents() -> void {
-        auto& subscribers{ GetSubscribers() };
-        auto& eventQueue{ GetEventQueue() };
+    auto EventBus::ProcessEvents() -> void {
+        CheckBoundThread("Events processed");
+
+        auto& eventQueue{ m_EventQueue };
+        auto& tags{ *m_FrameTags };
+
+        // Handlers may now read the type table from any thread
+        FreezeEventTypes();
+
+        // Event waiters are not kept per bus
+        const bool resumesWaiters{ IsDefault() };
+
+        // Snapshots loaded during this pass stay valid until it ends
+        const DispatchReadGuard guard{};
+
+        // Before the replays, a handler subscribed for the next owner of a released id must not get its events
+        ClearReleasedWindows();
+        PublishPendingSubscriptions();
+
+        ResolvePendingQueries();
+
+        TakeAsyncEvents([this](std::unique_ptr<Event>&& event) -> void { QueueEvent(std::move(event)); });
+
+        // Events queued by handlers or resumed coroutines are left for the next call
+        const Size_T eventCount{ eventQueue.size() };
+
+        if (m_Journal) {
+            m_Journal->OnProcessingBegin();
+        }
+
+        const Size_T wordCount{ EventFilter::GetMaskWordCount(eventCount) };
+        tags.Types.resize(eventCount);
+        tags.Categories.resize(eventCount);
+        tags.Windows.resize(eventCount);
+        tags.Matches.assign(wordCount, 0);
+        tags.PendingForBackground.assign(wordCount, 0);
 
         // Traverse event queue
-        auto begin{ eventQueue.begin() };
-        for ( ; begin != eventQueue.end(); ++begin) {
+        for (Size_T index{}; index < eventCount; ++index) {
+            // Pointer copy, the queue may reallocate while the handlers run
+            Event* eventPtr{ eventQueue[index].get() };
+
+            // Ids out of range have no lists, tagged as no window so no window mask matches them
+            const WindowId_T window{ eventPtr->GetWindowId() <= MAX_WINDOW_COUNT ? eventPtr->GetWindowId() : ANY_WINDOW_ID };
+
+            tags.Types[index] = static_cast<UInt8_T>(eventPtr->GetType());
+            tags.Categories[index] = GetCategoryFromType(eventPtr->GetType());
+            tags.Windows[index] = static_cast<UInt8_T>(window);
+
+            // Updated before the handlers run so Latest() already returns this event from them
+            if (auto& slot{ m_StickySlots[static_cast<Size_T>(eventPtr->GetType())] }) {
+                std::scoped_lock lock{ m_StickyMutex };
+                slot->Store(*eventPtr);
+            }
+
+            // Handlers may subscribe or unsubscribe, changes are picked up from the next event on
+            const auto dispatch{ [&](std::span<const DispatchEntry> handlers) -> void {
+                for (const auto& [subId, handlerWrapper] : handlers) {
+                    if (handlerWrapper->IsDemoted()) {
+                        // A demoted handler still has to see this event
+                        tags.PendingForBackground[index / 64] |= UInt64_T{ 1 } << (index % 64);
+                        continue;
+                    }
+
+                    ExecWatched(subId, *handlerWrapper, *eventPtr);
+                }
+            } };
+
+            // Handlers of every window run first, then the ones bound to the window of the event
+            dispatch(m_DispatchTable.GetHandlers(eventPtr->GetType()));
+
+            if (window != ANY_WINDOW_ID) {
+                dispatch(m_DispatchTable.GetHandlers(eventPtr->GetType(), window));
+            }
+
+            // Group by type for the batch handlers
+            if (auto& channel{ m_BatchChannels[static_cast<Size_T>(eventPtr->GetType())] }) {
+                channel->Append(*eventPtr);
+            }
+
+            if (resumesWaiters) {
+                ResumeEventWaiters(*eventPtr);
+            }
+        }
+
+        DispatchCategoryHandlers();
+
+        EventFilter::ForEachMatch(tags.PendingForBackground, [&](Size_T index) -> void { m_BackgroundQueue.push_back(std::move(eventQueue[index])); });
+
+        // Handlers still alive, the read guard holds them until the end of the pass
+        for (auto* wrapper : m_PendingDemotions) {
+            wrapper->SetDemoted(true);
+        }
+
+        m_PendingDemotions.clear();
+
+        eventQueue.erase(eventQueue.begin(), eventQueue.begin() + static_cast<std::ptrdiff_t>(eventCount));
+
+        for (auto& channel : m_BatchChannels) {
+            if (channel) {
+                channel->Dispatch();
+                channel->Clear();
+            }
+        }
+
+        DispatchChannelEvents();
+
+        if (resumesWaiters) {
+            ExpireEventWaiters();
+        }
+
+        if (m_Journal) {
+            m_Journal->OnProcessingEnd(!m_BackgroundQueue.empty());
+        }
+    }
+
+    auto EventBus::ProcessBackgroundEvents(std::chrono::microseconds budget) -> void {
+        CheckBoundThread("Background events processed");
+
+        const auto deadline{ std::chrono::steady_clock::now() + budget };
+
+        const DispatchReadGuard guard{};
+
+        auto begin{ m_BackgroundQueue.begin() };
+        while (begin != m_BackgroundQueue.end()) {
             auto& eventPtr{ *begin };
 
-            for (auto& [subId, listOfHandlers] : subscribers) {
-                const auto handlerWrapper{ std::find_if(listOfHandlers.begin(),
-                                              listOfHandlers.end(),
-                                              [&](const EventHandlerWrapper& a) -> bool { return eventPtr->IsInCategory(a.GetCategory()) && a.GetType() == eventPtr->GetType(); }) };
+            const auto dispatch{ [&](WindowId_T window) -> void {
+                for (const auto& [subId, handlerWrapper] : m_DispatchTable.GetHandlers(eventPtr->GetType(), window)) {
+                    if (handlerWrapper->IsDemoted()) {
+                        ExecWatched(subId, *handlerWrapper, *eventPtr);
+                    }
+                }
+
+                for (const auto& [subId, handlerWrapper] : m_DispatchTable.GetCategoryHandlers(window)) {
+                    if (handlerWrapper->IsDemoted() && handlerWrapper->Matches(*eventPtr)) {
+                        ExecWatched(subId, *handlerWrapper, *eventPtr);
+                    }
+                }
+            } };
+
+            dispatch(ANY_WINDOW_ID);
+
+            if (eventPtr->GetWindowId() != ANY_WINDOW_ID) {
+                dispatch(eventPtr->GetWindowId());
+            }
+
+            ++begin;
 
-                if (handlerWrapper != listOfHandlers.end()) { handlerWrapper->GetHandler()(*eventPtr); }
+            if (std::chrono::steady_clock::now() >= deadline) {
+                break;
             }
         }
 
-        eventQueue.clear();
+        m_BackgroundQueue.erase(m_BackgroundQueue.begin(), begin);
+    }
+
+    auto EventBus::GetSlowHandlerReports() -> std::vector<SlowHandlerReport> {
+        CheckBoundThread("Watchdog used");
+
+        std::vector<SlowHandlerReport> result{};
+
+        m_Subscribers.ForEach([&](UInt64_T subId, const Handlers_T& listOfHandlers) -> void {
+            for (const auto& handlerWrapper : listOfHandlers) {
+                if (handlerWrapper->IsReported()) {
+                    result.push_back({ subId, handlerWrapper->GetType(), handlerWrapper->GetStrikes(), handlerWrapper->GetWorstTime(), handlerWrapper->IsDemoted() });
+                }
+            }
+        });
+
+        return result;
+    }
+
+    auto EventBus::ResetWatchdog() -> void {
+        CheckBoundThread("Watchdog used");
+
+        m_Subscribers.ForEach([](UInt64_T, const Handlers_T& listOfHandlers) -> void {
+            for (const auto& handlerWrapper : listOfHandlers) {
+                handlerWrapper->SetStrikes(0);
+                handlerWrapper->SetWorstTime({});
+                handlerWrapper->SetReported(false);
+                handlerWrapper->SetDemoted(false);
+            }
+        });
+
+        m_PendingDemotions.clear();
+    }
+
+    auto EventBus::Shutdown() -> void {
+        // Events still queued stay in the journal for the next run
+        m_Journal.reset();
+        m_EventQueue.clear();
+        m_BackgroundQueue.clear();
+        TakeAsyncEvents([](std::unique_ptr<Event>&&) -> void {});
+
+        {
+            std::scoped_lock lock{ m_PendingSubscriptionsMutex };
+            m_PendingSubscriptions.clear();
+            m_Subscribers.Clear();
+        }
+
+        m_ChannelQueue.clear();
+        m_TopicRouter.Clear();
+
+        if (IsDefault()) {
+            CancelEventWaiters();
+        }
+
+        {
+            std::scoped_lock lock{ m_QueriesMutex };
+            m_PendingQueries.clear();
+        }
+
+        m_QueryResponders.clear();
+
+        for (auto& channel : m_BatchChannels) {
+            channel.reset();
+        }
+
+        m_ReleasedWindows.store(0, std::memory_order_relaxed);
+
+        std::scoped_lock lock{ m_StickyMutex };
+
+        for (auto& slot : m_StickySlots) {
+            slot.reset();
+        }
     }
 
-    auto Shutdown() -> void {
-        GetEventQueue().clear();
-        GetSubscribers().clear();
+    EventBus::~EventBus() {
+        // Producers keep the queue alive, the events already published are dropped now
+        TakeAsyncEvents([](std::unique_ptr<Event>&&) -> void {});
     }
 }
@@ -0,0 +1,306 @@
+/**
+ * EventReplay.cc
+ * Created by kate on 10/19/26.
+ * */
+
+// C++ Standard Library
+#include <array>
+#include <string>
+#include <fstream>
+#include <algorithm>
+
+// Project Headers
+#include <CoreEvents.hh>
+#include <EventCodec.hh>
+#include <EventReplay.hh>
+
+namespace Mikoto {
+    static constexpr UInt64_T FNV_PRIME{ 0x100000001B3 };
+
+    // Enough to drain the background lane in one call, small enough for its deadline not to overflow
+    static constexpr std::chrono::microseconds DRAIN_BUDGET{ std::chrono::hours{ 24 } };
+
+    static auto HashValue(UInt64_T hash, UInt64_T value) -> UInt64_T {
+        for (Size_T byte{}; byte < sizeof(value); ++byte) {
+            hash = (hash ^ ((value >> (byte * 8)) & 0xFF)) * FNV_PRIME;
+        }
+
+        return hash;
+    }
+
+    auto DispatchTrace::OnDispatch(UInt64_T subId, const Event& event) -> void {
+        DispatchRecord record{ m_Pass, subId, event.GetType(), event.GetTimeStamp(), 0xCBF29CE484222325 };
+
+        // The encoding covers every field, types without one are told apart by type and time only
+        alignas(EventCodec::RECORD_ALIGNMENT) std::array<std::byte, EventCodec::MAX_WIRE_SIZE> bytes{};
+        const Size_T size{ EventCodec::Encode(event, bytes) };
+
+        for (Size_T index{}; index < size; ++index) {
+            record.EventHash = (record.EventHash ^ static_cast<UInt64_T>(bytes[index])) * FNV_PRIME;
+        }
+
+        m_Digest = HashValue(m_Digest, record.Pass);
+        m_Digest = HashValue(m_Digest, record.SubscriberId);
+        m_Digest = HashValue(m_Digest, static_cast<UInt64_T>(record.Type));
+        m_Digest = HashValue(m_Digest, record.TimeStamp);
+        m_Digest = HashValue(m_Digest, record.EventHash);
+        ++m_DispatchCount;
+
+        if (m_KeepRecords) {
+            m_Records.push_back(record);
+        }
+    }
+
+    auto DispatchTrace::FindFirstDifference(const DispatchTrace& other) const -> std::optional<Size_T> {
+        const auto isSame{ [](const DispatchRecord& left, const DispatchRecord& right) -> bool {
+            return left.Pass == right.Pass && left.SubscriberId == right.SubscriberId && left.Type == right.Type &&
+                   left.TimeStamp == right.TimeStamp && left.EventHash == right.EventHash;
+        } };
+
+        const auto [left, right]{ std::ranges::mismatch(m_Records, other.m_Records, isSame) };
+
+        if (left != m_Records.end() || right != other.m_Records.end()) {
+            return static_cast<Size_T>(left - m_Records.begin());
+        }
+
+        // Records may not have been kept
+        if (m_Digest != other.m_Digest || m_DispatchCount != other.m_DispatchCount) {
+            return m_Records.size();
+        }
+
+        return std::nullopt;
+    }
+
+    auto DispatchTrace::Save(const Path_T& path) const -> void {
+        std::ofstream stream{ path };
+
+        if (!stream) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not create dispatch trace {}", path.string()));
+        }
+
+        for (const auto& record : m_Records) {
+            stream << fmt::format("{} {} {} {} {:016x}\n", record.Pass, record.SubscriberId, GetEventFormattedStr(record.Type), record.TimeStamp, record.EventHash);
+        }
+
+        stream << fmt::format("dispatches {} digest {:016x}\n", m_DispatchCount, m_Digest);
+    }
+
+    DeterministicEventSource::DeterministicEventSource(const EventSourceSpec& spec)
+        :   m_Spec{ spec }
+        ,   m_Engine{ spec.Seed }
+        ,   m_CursorX{ spec.Width / 2.0 }
+        ,   m_CursorY{ spec.Height / 2.0 }
+    {
+        m_Spec.MaxEventsPerFrame = std::max(m_Spec.MaxEventsPerFrame, m_Spec.MinEventsPerFrame);
+    }
+
+    auto DeterministicEventSource::QueueRandomEvent() -> void {
+        using namespace EventManager;
+
+        // Mostly cursor motion, like real input
+        switch (Pick(10)) {
+            case 0:
+            case 1:
+            case 2:
+            case 3:
+            case 4:
+            case 5:
+                m_CursorX = std::clamp(m_CursorX + static_cast<double>(Pick(33)) - 16.0, 0.0, static_cast<double>(m_Spec.Width));
+                m_CursorY = std::clamp(m_CursorY + static_cast<double>(Pick(33)) - 16.0, 0.0, static_cast<double>(m_Spec.Height));
+                QueueEvent(MakeEvent<MouseMovedEvent>(m_CursorX, m_CursorY));
+                break;
+
+            case 6:
+                if (!m_HeldKeys.empty() && Pick(2) == 0) {
+                    const auto held{ m_HeldKeys.begin() + static_cast<std::ptrdiff_t>(Pick(m_HeldKeys.size())) };
+                    QueueEvent(MakeEvent<KeyReleasedEvent>(*held));
+                    m_HeldKeys.erase(held);
+                }
+                else {
+                    const auto keyCode{ static_cast<Int32_T>(32 + Pick(59)) };
+                    const bool repeated{ std::ranges::find(m_HeldKeys, keyCode) != m_HeldKeys.end() };
+
+                    if (!repeated) {
+                        m_HeldKeys.push_back(keyCode);
+                    }
+
+                    QueueEvent(MakeEvent<KeyPressedEvent>(keyCode, repeated, static_cast<Int32_T>(Pick(16))));
+                }
+                break;
+
+            case 7:
+                QueueEvent(MakeEvent<KeyCharEvent>(static_cast<UInt32_T>(32 + Pick(95))));
+                break;
+
+            case 8:
+                if (!m_HeldButtons.empty()) {
+                    QueueEvent(MakeEvent<MouseButtonReleasedEvent>(m_HeldButtons.back()));
+                    m_HeldButtons.pop_back();
+                }
+                else {
+                    m_HeldButtons.push_back(static_cast<Int32_T>(Pick(3)));
+                    QueueEvent(MakeEvent<MouseButtonPressedEvent>(m_HeldButtons.back()));
+                }
+                break;
+
+            default:
+                QueueEvent(MakeEvent<MouseScrollEvent>(0.0, Pick(2) == 0 ? -1.0 : 1.0));
+                break;
+        }
+    }
+
+    auto DeterministicEventSource::QueueFrame(std::chrono::microseconds frameTime) -> UInt32_T {
+        auto& clock{ GetVirtualEventClock() };
+        const UInt64_T frameStart{ clock.Now.load(std::memory_order_relaxed) };
+        const auto frameLength{ static_cast<UInt64_T>(std::max<std::chrono::microseconds::rep>(frameTime.count(), 1)) };
+
+        const auto count{ static_cast<UInt32_T>(m_Spec.MinEventsPerFrame + Pick(m_Spec.MaxEventsPerFrame - m_Spec.MinEventsPerFrame + 1)) };
+
+        std::vector<UInt64_T> offsets(count);
+        std::ranges::generate(offsets, [&]() -> UInt64_T { return Pick(frameLength); });
+        std::ranges::sort(offsets);
+
+        // Events are stamped from the clock as they are created
+        for (const auto offset : offsets) {
+            clock.Now.store(frameStart + offset, std::memory_order_relaxed);
+            QueueRandomEvent();
+        }
+
+        clock.Now.store(frameStart, std::memory_order_relaxed);
+        return count;
+    }
+
+    auto ReplayBaseline::Load(const Path_T& path) -> ReplayBaseline {
+        std::ifstream stream{ path };
+
+        ReplayBaseline result{};
+        std::string digest{};
+        std::chrono::nanoseconds::rep median{};
+
+        if (!(stream >> digest >> result.DispatchCount >> median)) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not read replay baseline {}", path.string()));
+        }
+
+        result.Digest = std::stoull(digest, nullptr, 16);
+        result.MedianFrameTime = std::chrono::nanoseconds{ median };
+        return result;
+    }
+
+    auto ReplayBaseline::Save(const Path_T& path) const -> void {
+        std::ofstream stream{ path };
+        stream << fmt::format("{:016x} {} {}\n", Digest, DispatchCount, MedianFrameTime.count());
+
+        if (!stream) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not write replay baseline {}", path.string()));
+        }
+    }
+
+    ReplaySession::ReplaySession(const ReplaySpec& spec)
+        :   m_Spec{ spec }
+        ,   m_Trace{ spec.KeepRecords }
+        ,   m_PreviousClockEnabled{ GetVirtualEventClock().Enabled.load(std::memory_order_relaxed) }
+        ,   m_PreviousClockNow{ GetVirtualEventClock().Now.load(std::memory_order_relaxed) }
+    {
+        // Queued events were stamped with the real clock and would make the first frame depend on them
+        if (const auto& queue{ EventManager::GetEventQueue() }; !queue.empty()) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Replay session started with {} queued events", queue.size()));
+        }
+
+        // Demoted handlers would run in whatever order the background lane is drained,
+        // they get the events already waiting for them and are promoted back
+        EventManager::ProcessBackgroundEvents(DRAIN_BUDGET);
+        EventManager::ResetWatchdog();
+
+        // Every session starts at the same time so stamps match between runs
+        auto& clock{ GetVirtualEventClock() };
+        clock.Now.store(0, std::memory_order_relaxed);
+        clock.Enabled.store(true, std::memory_order_relaxed);
+        EventManager::GetDispatchObserver() = std::addressof(m_Trace);
+    }
+
+    auto ReplaySession::RunFrame() -> void {
+        // The frame is processed once it is over, after every event in it
+        GetVirtualEventClock().Now.fetch_add(static_cast<UInt64_T>(m_Spec.FrameTime.count()), std::memory_order_relaxed);
+        m_Trace.NextPass();
+
+        const auto start{ std::chrono::steady_clock::now() };
+        EventManager::ProcessEvents();
+        EventManager::ProcessBackgroundEvents(DRAIN_BUDGET);
+        m_FrameTimes.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+    }
+
+    auto ReplaySession::Run(DeterministicEventSource& source, UInt64_T frameCount) -> void {
+        m_FrameTimes.reserve(m_FrameTimes.size() + frameCount);
+
+        for (UInt64_T frame{}; frame < frameCount; ++frame) {
+            (void)source.QueueFrame(m_Spec.FrameTime);
+            RunFrame();
+        }
+    }
+
+    auto ReplaySession::Run(EventLogReader& reader) -> UInt64_T {
+        const auto& clock{ GetVirtualEventClock() };
+        const UInt64_T start{ clock.Now.load(std::memory_order_relaxed) };
+        const auto frameLength{ static_cast<UInt64_T>(m_Spec.FrameTime.count()) };
+
+        UInt64_T count{};
+        bool pending{};
+
+        while (auto event{ reader.Next() }) {
+            const UInt64_T time{ start + reader.GetTime() };
+
+            while (time >= clock.Now.load(std::memory_order_relaxed) + frameLength) {
+                RunFrame();
+                pending = false;
+            }
+
+            event->SetTimeStamp(static_cast<UInt32_T>(time));
+            EventManager::QueueEvent(std::move(event));
+            pending = true;
+            ++count;
+        }
+
+        if (pending) {
+            RunFrame();
+        }
+
+        return count;
+    }
+
+    auto ReplaySession::GetMedianFrameTime() const -> std::chrono::nanoseconds {
+        if (m_FrameTimes.empty()) {
+            return {};
+        }
+
+        auto times{ m_FrameTimes };
+        const auto middle{ times.begin() + static_cast<std::ptrdiff_t>(times.size() / 2) };
+        std::nth_element(times.begin(), middle, times.end());
+
+        return *middle;
+    }
+
+    auto ReplaySession::MakeBaseline() const -> ReplayBaseline {
+        return { m_Trace.GetDigest(), m_Trace.GetDispatchCount(), GetMedianFrameTime() };
+    }
+
+    auto ReplaySession::Compare(const ReplayBaseline& baseline, double tolerance) const -> ReplayComparison {
+        ReplayComparison result{};
+        result.SameTrace = baseline.Digest == m_Trace.GetDigest() && baseline.DispatchCount == m_Trace.GetDispatchCount();
+
+        const auto reference{ std::max<std::chrono::nanoseconds::rep>(baseline.MedianFrameTime.count(), 1) };
+        result.Slowdown = static_cast<double>(GetMedianFrameTime().count()) / static_cast<double>(reference);
+        result.Regressed = !result.SameTrace || result.Slowdown > 1.0 + tolerance;
+
+        return result;
+    }
+
+    ReplaySession::~ReplaySession() {
+        if (EventManager::GetDispatchObserver() == std::addressof(m_Trace)) {
+            EventManager::GetDispatchObserver() = nullptr;
+        }
+
+        auto& clock{ GetVirtualEventClock() };
+        clock.Now.store(m_PreviousClockNow, std::memory_order_relaxed);
+        clock.Enabled.store(m_PreviousClockEnabled, std::memory_order_relaxed);
+    }
+}
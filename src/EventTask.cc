@@ -0,0 +1,195 @@
+/**
+ * EventTask.cc
+ * Created by kate on 10/19/26.
+ * */
+
+// C++ Standard Library
+#include <array>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+// Project Headers
+#include <EventTask.hh>
+
+namespace Mikoto {
+    namespace {
+        struct FreeBlock {
+            FreeBlock* Next{};
+        };
+
+        struct FramePoolState {
+            std::array<FreeBlock*, CoroutineFramePool::MAX_POOLED_FRAME_SIZE / CoroutineFramePool::FRAME_SIZE_STEP> FreeLists{};
+            std::vector<std::unique_ptr<std::byte[]>> Chunks{};
+        };
+
+        auto GetFramePoolState() -> FramePoolState& {
+            static FramePoolState state{};
+            return state;
+        }
+
+        auto GetSizeClass(Size_T size) -> Size_T {
+            return (size + CoroutineFramePool::FRAME_SIZE_STEP - 1) / CoroutineFramePool::FRAME_SIZE_STEP - 1;
+        }
+    }
+
+    auto CoroutineFramePool::Allocate(Size_T size) -> void* {
+        if (size > MAX_POOLED_FRAME_SIZE) {
+            return ::operator new(size);
+        }
+
+        auto& state{ GetFramePoolState() };
+        auto& head{ state.FreeLists[GetSizeClass(size)] };
+
+        if (head == nullptr) {
+            // Carve a whole chunk into blocks of this class
+            const Size_T blockSize{ (GetSizeClass(size) + 1) * FRAME_SIZE_STEP };
+            auto& chunk{ state.Chunks.emplace_back(std::make_unique<std::byte[]>(CHUNK_SIZE)) };
+
+            for (Size_T offset{}; offset + blockSize <= CHUNK_SIZE; offset += blockSize) {
+                head = new (chunk.get() + offset) FreeBlock{ head };
+            }
+        }
+
+        FreeBlock* block{ head };
+        head = block->Next;
+        return block;
+    }
+
+    auto CoroutineFramePool::Deallocate(void* frame, Size_T size) -> void {
+        if (size > MAX_POOLED_FRAME_SIZE) {
+            ::operator delete(frame);
+            return;
+        }
+
+        auto& head{ GetFramePoolState().FreeLists[GetSizeClass(size)] };
+        head = new (frame) FreeBlock{ head };
+    }
+}
+
+namespace Mikoto::EventManager {
+    using EventWaiters_T = std::array<std::vector<EventWaiterBase*>, MAX_EVENT_TYPE_COUNT>;
+
+    static auto GetEventWaiters() -> EventWaiters_T& {
+        static EventWaiters_T waiters{};
+        return waiters;
+    }
+
+    // Waiters with a deadline, lets ExpireEventWaiters() return early when there are none
+    static Size_T s_TimedWaiterCount{};
+
+    // Waiters being resumed, one buffer per nesting level as a resumed coroutine may process
+    // events again. Kept from one call to the next so resuming does not allocate, a deque so
+    // adding a level does not move the buffers of the levels below
+    static auto GetReadyWaiters() -> std::deque<std::vector<EventWaiterBase*>>& {
+        static std::deque<std::vector<EventWaiterBase*>> ready{};
+        return ready;
+    }
+
+    static Size_T s_ResumeDepth{};
+
+    /**
+     * Lends the buffer of the current nesting level, left empty for the next call when done
+     * */
+    class ReadyWaitersScope {
+    public:
+        ReadyWaitersScope() {
+            auto& levels{ GetReadyWaiters() };
+
+            if (s_ResumeDepth == levels.size()) {
+                levels.emplace_back();
+            }
+
+            m_Ready = std::addressof(levels[s_ResumeDepth++]);
+        }
+
+        ReadyWaitersScope(const ReadyWaitersScope&) = delete;
+        auto operator=(const ReadyWaitersScope&) -> ReadyWaitersScope& = delete;
+
+        MKT_NODISCARD auto Get() -> std::vector<EventWaiterBase*>& { return *m_Ready; }
+
+        ~ReadyWaitersScope() {
+            m_Ready->clear();
+            --s_ResumeDepth;
+        }
+
+    private:
+        std::vector<EventWaiterBase*>* m_Ready{};
+    };
+
+    /**
+     * Moves the waiters meeting the predicate from the list into ready, keeping the order of the others
+     * */
+    template<typename PredicateType>
+    static auto TakeWaiters(std::vector<EventWaiterBase*>& waiters, std::vector<EventWaiterBase*>& ready, const PredicateType& predicate) -> void {
+        auto kept{ waiters.begin() };
+
+        for (auto* waiter : waiters) {
+            if (predicate(*waiter)) {
+                ready.push_back(waiter);
+                s_TimedWaiterCount -= waiter->GetDeadline().has_value();
+            }
+            else {
+                *kept++ = waiter;
+            }
+        }
+
+        waiters.erase(kept, waiters.end());
+    }
+
+    auto RegisterEventWaiter(EventWaiterBase& waiter) -> void {
+        GetEventWaiters()[static_cast<Size_T>(waiter.GetType())].push_back(std::addressof(waiter));
+        s_TimedWaiterCount += waiter.GetDeadline().has_value();
+    }
+
+    auto ResumeEventWaiters(Event& event) -> void {
+        auto& waiters{ GetEventWaiters()[static_cast<Size_T>(event.GetType())] };
+
+        if (waiters.empty()) {
+            return;
+        }
+
+        // Taken out before resuming, a coroutine waiting again registers into the list
+        ReadyWaitersScope scope{};
+        auto& ready{ scope.Get() };
+        TakeWaiters(waiters, ready, [&](EventWaiterBase& waiter) -> bool { return waiter.Accept(event); });
+
+        for (auto* waiter : ready) {
+            waiter->Resume();
+        }
+    }
+
+    auto ExpireEventWaiters() -> void {
+        if (s_TimedWaiterCount == 0) {
+            return;
+        }
+
+        const auto now{ GetEventClockNow() };
+
+        ReadyWaitersScope scope{};
+        auto& ready{ scope.Get() };
+
+        for (auto& waiters : GetEventWaiters()) {
+            TakeWaiters(waiters, ready, [&](EventWaiterBase& waiter) -> bool { return waiter.GetDeadline() && *waiter.GetDeadline() <= now; });
+        }
+
+        for (auto* waiter : ready) {
+            waiter->Resume();
+        }
+    }
+
+    auto CancelEventWaiters() -> void {
+        for (auto& waiters : GetEventWaiters()) {
+            // The waiters live in the frames being destroyed
+            auto pending{ std::move(waiters) };
+            waiters.clear();
+
+            for (auto* waiter : pending) {
+                waiter->Destroy();
+            }
+        }
+
+        s_TimedWaiterCount = 0;
+    }
+}
@@ -0,0 +1,431 @@
+/**
+ * PersistentEventQueue.cc
+ * Created by kate on 10/19/26.
+ * */
+
+// C++ Standard Library
+#include <new>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <iterator>
+#include <optional>
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+
+// POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Project Headers
+#include <EventCodec.hh>
+#include <PersistentEventQueue.hh>
+
+namespace Mikoto {
+    // Files are only read back on the machine that wrote them, headers use the host byte order
+    static constexpr std::array<char, 4> SEGMENT_MAGIC{ 'M', 'K', 'T', 'Q' };
+    static constexpr std::array<char, 4> CONSUMER_MAGIC{ 'M', 'K', 'T', 'O' };
+    static constexpr UInt32_T QUEUE_VERSION{ 1 };
+
+    static constexpr std::string_view SEGMENT_PREFIX{ "segment-" };
+    static constexpr std::string_view SEGMENT_EXTENSION{ ".mkq" };
+    static constexpr std::string_view CONSUMER_FILE_NAME{ "consumer.mkq" };
+
+    struct SegmentHeader {
+        std::array<char, 4> Magic{ SEGMENT_MAGIC };
+        UInt32_T Version{ QUEUE_VERSION };
+        UInt64_T Sequence{};
+    };
+
+    // Records start here, keeps them aligned for EventCodec::View()
+    static constexpr Size_T SEGMENT_HEADER_SIZE{ 64 };
+    static_assert(sizeof(SegmentHeader) <= SEGMENT_HEADER_SIZE);
+
+    /**
+     * The consumer position is written in turns to two slots, each with a check
+     * value. A slot torn by a power loss fails the check and the other one is used
+     * */
+    struct ConsumerSlot {
+        UInt64_T Generation{};
+        UInt64_T Segment{};
+        UInt64_T Offset{};
+        UInt64_T Check{};
+    };
+
+    struct ConsumerFile {
+        std::array<char, 4> Magic{ CONSUMER_MAGIC };
+        UInt32_T Version{ QUEUE_VERSION };
+        std::array<ConsumerSlot, 2> Slots{};
+    };
+
+    static auto GetSlotCheck(UInt64_T generation, UInt64_T segment, UInt64_T offset) -> UInt64_T {
+        // Never zero for a zero filled slot
+        return (generation * 0x9E3779B97F4A7C15) ^ (segment * 0xC2B2AE3D27D4EB4F) ^ (offset * 0x165667B19E3779F9) ^ 0x27D4EB2F165667C5;
+    }
+
+    PersistentEventQueue::Mapping::Mapping(const Path_T& path, Size_T size) {
+        const Int32_T descriptor{ open(path.c_str(), O_RDWR | O_CREAT, 0600) };
+
+        if (descriptor == -1) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not open {}: {}", path.string(), std::strerror(errno)));
+        }
+
+        struct stat status{};
+
+        // New files read as zeros, which is an empty segment
+        if (fstat(descriptor, &status) == -1 || (static_cast<Size_T>(status.st_size) < size && ftruncate(descriptor, static_cast<off_t>(size)) == -1)) {
+            const Int32_T error{ errno };
+            close(descriptor);
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not size {}: {}", path.string(), std::strerror(error)));
+        }
+
+        void* mapping{ mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0) };
+        const Int32_T error{ errno };
+
+        close(descriptor);
+
+        if (mapping == MAP_FAILED) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not map {}: {}", path.string(), std::strerror(error)));
+        }
+
+        m_Data = static_cast<std::byte*>(mapping);
+        m_Size = size;
+    }
+
+    PersistentEventQueue::Mapping::Mapping(Mapping&& other) noexcept
+        :   m_Data{ std::exchange(other.m_Data, nullptr) }
+        ,   m_Size{ std::exchange(other.m_Size, 0) }
+    {}
+
+    auto PersistentEventQueue::Mapping::operator=(Mapping&& other) noexcept -> Mapping& {
+        std::swap(m_Data, other.m_Data);
+        std::swap(m_Size, other.m_Size);
+        return *this;
+    }
+
+    PersistentEventQueue::Mapping::~Mapping() {
+        if (m_Data) {
+            munmap(m_Data, m_Size);
+        }
+    }
+
+    /**
+     * Walks the records of a segment
+     * @returns offset of the first byte after the last complete record
+     * */
+    static auto FindSegmentEnd(const std::byte* data, Size_T size, UInt64_T offset) -> UInt64_T {
+        while (offset < size) {
+            const auto* header{ EventCodec::PeekHeader({ data + offset, size - offset }) };
+
+            if (!header || header->GetSize() != EventCodec::GetWireSize(static_cast<EventType>(header->Type))) {
+                break;
+            }
+
+            offset += header->GetSize();
+        }
+
+        return offset;
+    }
+
+    static auto ParseSegmentIndex(const Path_T& path) -> std::optional<UInt64_T> {
+        const std::string name{ path.filename().string() };
+
+        if (!name.starts_with(SEGMENT_PREFIX) || !name.ends_with(SEGMENT_EXTENSION)) {
+            return std::nullopt;
+        }
+
+        UInt64_T index{};
+        const char* begin{ name.data() + SEGMENT_PREFIX.size() };
+        const char* end{ name.data() + name.size() - SEGMENT_EXTENSION.size() };
+
+        if (auto [last, error]{ std::from_chars(begin, end, index) }; error != std::errc{} || last != end) {
+            return std::nullopt;
+        }
+
+        return index;
+    }
+
+    PersistentEventQueue::PersistentEventQueue(const Path_T& directory, const PersistentQueueSpec& spec)
+        :   m_Directory{ directory }
+        ,   m_Spec{ spec }
+    {
+        // Room for at least one record, whole records only
+        m_Spec.SegmentSize = std::max(m_Spec.SegmentSize, SEGMENT_HEADER_SIZE + EventCodec::MAX_WIRE_SIZE);
+        m_Spec.SegmentSize -= m_Spec.SegmentSize % EventCodec::RECORD_ALIGNMENT;
+
+        std::error_code error{};
+        std::filesystem::create_directories(m_Directory, error);
+
+        if (error) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not create queue directory {}: {}", m_Directory.string(), error.message()));
+        }
+
+        // Members own their mappings, a later failure unmaps what was already mapped
+        m_Consumer = Mapping{ m_Directory / CONSUMER_FILE_NAME, sizeof(ConsumerFile) };
+
+        auto* consumer{ reinterpret_cast<ConsumerFile*>(m_Consumer.GetData()) };
+        bool hasPosition{};
+
+        if (std::ranges::all_of(consumer->Magic, [](char value) -> bool { return value == 0; })) {
+            consumer = new (m_Consumer.GetData()) ConsumerFile{};
+        }
+        else if (consumer->Magic != CONSUMER_MAGIC || consumer->Version != QUEUE_VERSION) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("{} does not hold an event queue", m_Directory.string()));
+        }
+
+        for (const auto& slot : consumer->Slots) {
+            if (slot.Check == GetSlotCheck(slot.Generation, slot.Segment, slot.Offset) && (!hasPosition || slot.Generation > m_ConsumerGeneration)) {
+                m_ConsumerGeneration = slot.Generation;
+                m_CommittedPosition = { slot.Segment, slot.Offset };
+                hasPosition = true;
+            }
+        }
+
+        for (const auto& entry : std::filesystem::directory_iterator{ m_Directory }) {
+            const auto index{ ParseSegmentIndex(entry.path()) };
+
+            if (!index || !entry.is_regular_file()) {
+                continue;
+            }
+
+            m_NextFileIndex = std::max(m_NextFileIndex, *index + 1);
+
+            // Grown to the configured size, a file cut short has zeros after its last record
+            Size_T size{ std::max(static_cast<Size_T>(entry.file_size()), m_Spec.SegmentSize) };
+            size -= size % EventCodec::RECORD_ALIGNMENT;
+
+            Segment segment{ .File = Mapping{ entry.path(), size } };
+            const auto* header{ reinterpret_cast<const SegmentHeader*>(segment.File.GetData()) };
+
+            // A segment whose header was never written holds nothing, it may still hold old records
+            if (header->Magic != SEGMENT_MAGIC || header->Version != QUEUE_VERSION || (hasPosition && header->Sequence < m_CommittedPosition.Segment)) {
+                m_DirtySegments.push_back(std::move(segment));
+                continue;
+            }
+
+            segment.Sequence = header->Sequence;
+            m_NextSequence = std::max(m_NextSequence, segment.Sequence + 1);
+            m_Segments.push_back(std::move(segment));
+        }
+
+        std::ranges::sort(m_Segments, {}, &Segment::Sequence);
+
+        if (m_Segments.empty()) {
+            m_NextSequence = std::max(m_NextSequence, m_CommittedPosition.Segment);
+            StartSegment();
+        }
+
+        if (!hasPosition || m_CommittedPosition.Segment < m_Segments.front().Sequence) {
+            m_CommittedPosition = { m_Segments.front().Sequence, SEGMENT_HEADER_SIZE };
+        }
+
+        const auto& last{ m_Segments.back() };
+        m_WritePosition = { last.Sequence, FindSegmentEnd(last.File.GetData(), last.File.GetSize(), last.Sequence == m_CommittedPosition.Segment ? m_CommittedPosition.Offset : SEGMENT_HEADER_SIZE) };
+
+        m_SyncedPosition = m_WritePosition;
+        m_LastSync = std::chrono::steady_clock::now();
+
+        m_Cleaner = std::jthread{ [this](std::stop_token stop) -> void { CleanSegments(stop); } };
+    }
+
+    auto PersistentEventQueue::StartSegment() -> void {
+        std::optional<Segment> recycled{};
+
+        {
+            std::scoped_lock lock{ m_FreeMutex };
+
+            if (!m_FreeSegments.empty()) {
+                recycled = std::move(m_FreeSegments.back());
+                m_FreeSegments.pop_back();
+            }
+        }
+
+        Segment segment{};
+
+        if (recycled) {
+            segment = std::move(*recycled);
+            ++m_RecycledCount;
+        }
+        else {
+            segment.File = Mapping{ m_Directory / fmt::format("{}{}{}", SEGMENT_PREFIX, m_NextFileIndex++, SEGMENT_EXTENSION), m_Spec.SegmentSize };
+        }
+
+        segment.Sequence = m_NextSequence++;
+        new (segment.File.GetData()) SegmentHeader{ .Sequence = segment.Sequence };
+
+        m_WritePosition = { segment.Sequence, SEGMENT_HEADER_SIZE };
+        m_Segments.push_back(std::move(segment));
+    }
+
+    auto PersistentEventQueue::RetireSegment(Segment&& segment) -> void {
+        {
+            std::scoped_lock lock{ m_FreeMutex };
+            m_DirtySegments.push_back(std::move(segment));
+        }
+
+        m_FreeCondition.notify_one();
+    }
+
+    auto PersistentEventQueue::CleanSegments(std::stop_token stop) -> void {
+        std::unique_lock lock{ m_FreeMutex };
+
+        while (m_FreeCondition.wait(lock, stop, [this]() -> bool { return !m_DirtySegments.empty(); })) {
+            Segment segment{ std::move(m_DirtySegments.back()) };
+            m_DirtySegments.pop_back();
+
+            lock.unlock();
+
+            // Old records must be gone from the disk before the segment gets a valid
+            // sequence number, otherwise a power loss could bring them back
+            std::memset(segment.File.GetData() + SEGMENT_HEADER_SIZE, 0, segment.File.GetSize() - SEGMENT_HEADER_SIZE);
+            msync(segment.File.GetData(), segment.File.GetSize(), MS_SYNC);
+
+            lock.lock();
+            m_FreeSegments.push_back(std::move(segment));
+        }
+    }
+
+    auto PersistentEventQueue::GetSegmentCount() -> Size_T {
+        std::scoped_lock lock{ m_FreeMutex };
+        return m_Segments.size() + m_DirtySegments.size() + m_FreeSegments.size();
+    }
+
+    auto PersistentEventQueue::Append(const Event& event) -> bool {
+        const Size_T size{ EventCodec::GetWireSize(event.GetType()) };
+
+        if (size == 0) {
+            return false;
+        }
+
+        if (m_WritePosition.Offset + size > m_Segments.back().File.GetSize()) {
+            StartSegment();
+        }
+
+        alignas(EventCodec::RECORD_ALIGNMENT) std::array<std::byte, EventCodec::MAX_WIRE_SIZE> record{};
+        (void)EventCodec::Encode(event, record);
+
+        // The version byte goes last, a record cut short reads as the end of the queue
+        std::byte* destination{ m_Segments.back().File.GetData() + m_WritePosition.Offset };
+        std::memcpy(destination + 1, record.data() + 1, size - 1);
+        std::atomic_thread_fence(std::memory_order_release);
+        destination[0] = record[0];
+
+        m_WritePosition.Offset += size;
+        return true;
+    }
+
+    auto PersistentEventQueue::Recover() const -> std::vector<std::unique_ptr<Event>> {
+        std::vector<std::unique_ptr<Event>> result{};
+
+        for (const auto& segment : m_Segments) {
+            if (segment.Sequence < m_CommittedPosition.Segment) {
+                continue;
+            }
+
+            UInt64_T offset{ segment.Sequence == m_CommittedPosition.Segment ? m_CommittedPosition.Offset : SEGMENT_HEADER_SIZE };
+            const std::byte* data{ segment.File.GetData() };
+            const UInt64_T end{ segment.Sequence == m_WritePosition.Segment ? m_WritePosition.Offset : FindSegmentEnd(data, segment.File.GetSize(), offset) };
+
+            while (offset < end) {
+                const std::span<const std::byte> bytes{ data + offset, end - offset };
+                const auto* header{ EventCodec::PeekHeader(bytes) };
+
+                if (!header) {
+                    break;
+                }
+
+                if (auto event{ EventCodec::Decode(bytes.first(header->GetSize())) }) {
+                    result.push_back(std::move(event));
+                }
+
+                offset += header->GetSize();
+            }
+        }
+
+        return result;
+    }
+
+    auto PersistentEventQueue::WriteConsumerPosition(const PersistentQueuePosition& position) -> void {
+        auto* consumer{ reinterpret_cast<ConsumerFile*>(m_Consumer.GetData()) };
+        auto& slot{ consumer->Slots[++m_ConsumerGeneration % consumer->Slots.size()] };
+
+        slot.Generation = m_ConsumerGeneration;
+        slot.Segment = position.Segment;
+        slot.Offset = position.Offset;
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.Check = GetSlotCheck(slot.Generation, slot.Segment, slot.Offset);
+    }
+
+    auto PersistentEventQueue::Commit(const PersistentQueuePosition& position) -> void {
+        if (position.Segment != m_CommittedPosition.Segment || position.Offset != m_CommittedPosition.Offset) {
+            m_CommittedPosition = position;
+            WriteConsumerPosition(position);
+
+            // Segments entirely behind the consumer, the one being written is kept
+            while (m_Segments.size() > 1 && m_Segments.front().Sequence < position.Segment) {
+                RetireSegment(std::move(m_Segments.front()));
+                m_Segments.erase(m_Segments.begin());
+            }
+        }
+
+        if (std::chrono::steady_clock::now() - m_LastSync >= m_Spec.SyncInterval) {
+            Sync();
+        }
+    }
+
+    auto PersistentEventQueue::Sync() -> void {
+        const auto pageSize{ static_cast<UInt64_T>(sysconf(_SC_PAGESIZE)) };
+
+        for (const auto& segment : m_Segments) {
+            if (segment.Sequence < m_SyncedPosition.Segment) {
+                continue;
+            }
+
+            const UInt64_T begin{ segment.Sequence == m_SyncedPosition.Segment ? m_SyncedPosition.Offset / pageSize * pageSize : 0 };
+            const UInt64_T end{ segment.Sequence == m_WritePosition.Segment ? m_WritePosition.Offset : segment.File.GetSize() };
+
+            if (begin < end) {
+                msync(segment.File.GetData() + begin, end - begin, MS_SYNC);
+            }
+        }
+
+        msync(m_Consumer.GetData(), sizeof(ConsumerFile), MS_SYNC);
+
+        m_SyncedPosition = m_WritePosition;
+        m_LastSync = std::chrono::steady_clock::now();
+    }
+
+    PersistentEventQueue::~PersistentEventQueue() {
+        // Segments not cleaned yet are cleaned by the next run
+        m_Cleaner.request_stop();
+        m_Cleaner.join();
+
+        Sync();
+    }
+}
+
+namespace Mikoto::EventManager {
+    auto EnablePersistentQueue(const Path_T& directory, const PersistentQueueSpec& spec) -> PersistentEventQueue& {
+        auto queue{ std::make_unique<PersistentEventQueue>(directory, spec) };
+        auto recovered{ queue->Recover() };
+
+        // Stamped by the clock of the previous run
+        for (auto& event : recovered) {
+            event->SetTimeStamp(GetEventTimeStamp());
+        }
+
+        // Already in the journal, so not queued through QueueEvent()
+        auto& eventQueue{ GetEventQueue() };
+        eventQueue.insert(eventQueue.begin(), std::make_move_iterator(recovered.begin()), std::make_move_iterator(recovered.end()));
+
+        auto& result{ *queue };
+        GetEventQueueJournal() = std::move(queue);
+
+        return result;
+    }
+}
@@ -0,0 +1,147 @@
+/**
+ * SharedMemoryBridge.cc
+ * Created by kate on 10/19/26.
+ * */
+
+// C++ Standard Library
+#include <bit>
+#include <new>
+#include <cerrno>
+#include <cstring>
+
+// POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Project Headers
+#include <EventCodec.hh>
+#include <EventManager.hh>
+#include <SharedMemoryBridge.hh>
+
+namespace Mikoto {
+    SharedMemoryBridge::SharedMemoryBridge(std::string_view name, UInt64_T subId, std::span<const EventType> types, UInt32_T slotCount)
+        :   m_Name{ name }
+        ,   m_SubscriberId{ subId }
+        ,   m_Types{ types.begin(), types.end() }
+    {
+        slotCount = std::bit_ceil(std::max(slotCount, UInt32_T{ 1 }));
+        m_IndexMask = slotCount - 1;
+        m_MappingSize = sizeof(SharedRingHeader) + slotCount * sizeof(SharedRingSlot);
+
+        // Exclusive, sizing and initializing an existing object would wipe a ring in use
+        m_Descriptor = shm_open(m_Name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+        if (m_Descriptor == -1 && errno == EEXIST) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Shared memory object {} already exists, another producer owns it or it was left behind by one", m_Name));
+        }
+
+        if (m_Descriptor == -1) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not create shared memory object {}: {}", m_Name, std::strerror(errno)));
+        }
+
+        if (ftruncate(m_Descriptor, static_cast<off_t>(m_MappingSize)) == -1) {
+            const Int32_T error{ errno };
+            close(m_Descriptor);
+            shm_unlink(m_Name.c_str());
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not size shared memory object {}: {}", m_Name, std::strerror(error)));
+        }
+
+        void* mapping{ mmap(nullptr, m_MappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_Descriptor, 0) };
+
+        if (mapping == MAP_FAILED) {
+            const Int32_T error{ errno };
+            close(m_Descriptor);
+            shm_unlink(m_Name.c_str());
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not map shared memory object {}: {}", m_Name, std::strerror(error)));
+        }
+
+        m_Header = new (mapping) SharedRingHeader{};
+        m_Header->SlotCount = slotCount;
+        m_Header->SlotSize = sizeof(SharedRingSlot);
+
+        m_Slots = reinterpret_cast<SharedRingSlot*>(static_cast<std::byte*>(mapping) + sizeof(SharedRingHeader));
+
+        for (UInt32_T index{}; index < slotCount; ++index) {
+            new (m_Slots + index) SharedRingSlot{};
+        }
+
+        for (const auto type : m_Types) {
+            EventManager::Subscribe(m_SubscriberId, type, [this](Event& event) -> bool { Write(event); return false; });
+        }
+    }
+
+    auto SharedMemoryBridge::Write(const Event& event) -> void {
+        if (EventCodec::GetWireSize(event.GetType()) == 0) {
+            return;
+        }
+
+        auto& slot{ m_Slots[m_WriteIndex & m_IndexMask] };
+
+        // Odd sequence while the record is incomplete
+        slot.Sequence.store(m_WriteIndex * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        (void)EventCodec::Encode(event, slot.Data);
+
+        slot.Sequence.store(m_WriteIndex * 2 + 2, std::memory_order_release);
+        m_Header->WriteIndex.store(++m_WriteIndex, std::memory_order_release);
+    }
+
+    SharedMemoryBridge::~SharedMemoryBridge() {
+        for (const auto type : m_Types) {
+            EventManager::Unsubscribe(m_SubscriberId, type);
+        }
+
+        munmap(m_Header, m_MappingSize);
+        close(m_Descriptor);
+        shm_unlink(m_Name.c_str());
+    }
+
+    SharedMemoryReader::SharedMemoryReader(std::string_view name) {
+        const std::string path{ name };
+        m_Descriptor = shm_open(path.c_str(), O_RDONLY, 0);
+
+        if (m_Descriptor == -1) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not open shared memory object {}: {}", path, std::strerror(errno)));
+        }
+
+        struct stat info{};
+        if (fstat(m_Descriptor, &info) == -1 || static_cast<Size_T>(info.st_size) < sizeof(SharedRingHeader)) {
+            close(m_Descriptor);
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Shared memory object {} is not an event ring", path));
+        }
+
+        m_MappingSize = static_cast<Size_T>(info.st_size);
+        void* mapping{ mmap(nullptr, m_MappingSize, PROT_READ, MAP_SHARED, m_Descriptor, 0) };
+
+        if (mapping == MAP_FAILED) {
+            const Int32_T error{ errno };
+            close(m_Descriptor);
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not map shared memory object {}: {}", path, std::strerror(error)));
+        }
+
+        m_Header = static_cast<const SharedRingHeader*>(mapping);
+        m_Slots = reinterpret_cast<const SharedRingSlot*>(static_cast<const std::byte*>(mapping) + sizeof(SharedRingHeader));
+
+        const bool valid{ m_Header->Magic == SharedRingHeader::MAGIC &&
+                          m_Header->Version == SharedRingHeader::VERSION &&
+                          m_Header->SlotSize == sizeof(SharedRingSlot) &&
+                          std::has_single_bit(m_Header->SlotCount) &&
+                          sizeof(SharedRingHeader) + m_Header->SlotCount * sizeof(SharedRingSlot) <= m_MappingSize };
+
+        if (!valid) {
+            munmap(mapping, m_MappingSize);
+            close(m_Descriptor);
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Shared memory object {} is not a compatible event ring", path));
+        }
+
+        m_ReadIndex = m_Header->WriteIndex.load(std::memory_order_acquire);
+    }
+
+    SharedMemoryReader::~SharedMemoryReader() {
+        munmap(const_cast<SharedRingHeader*>(m_Header), m_MappingSize);
+        close(m_Descriptor);
+    }
+}
@@ -0,0 +1,254 @@
+/**
+ * SocketBridge.cc
+ * Created by kate on 10/19/26.
+ * */
+
+// C++ Standard Library
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+
+// POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/uio.h>
+#include <sys/socket.h>
+
+// Project Headers
+#include <EventCodec.hh>
+#include <EventManager.hh>
+#include <SocketBridge.hh>
+
+namespace Mikoto {
+    static auto SetNonBlocking(Int32_T descriptor) -> bool {
+        const Int32_T flags{ fcntl(descriptor, F_GETFL, 0) };
+        return flags != -1 && fcntl(descriptor, F_SETFL, flags | O_NONBLOCK) != -1;
+    }
+
+    SocketBridge::SocketBridge(std::string_view path, UInt64_T subId, std::span<const EventType> types, Size_T maxClientBuffer)
+        :   m_Path{ path }
+        ,   m_SubscriberId{ subId }
+        ,   m_Types{ types.begin(), types.end() }
+        ,   m_MaxClientBuffer{ maxClientBuffer }
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+
+        if (m_Path.size() >= sizeof(address.sun_path)) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Socket path {} is too long", m_Path));
+        }
+
+        std::copy(m_Path.begin(), m_Path.end(), address.sun_path);
+
+        m_Descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (m_Descriptor == -1) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not create socket: {}", std::strerror(errno)));
+        }
+
+        if (!SetNonBlocking(m_Descriptor)) {
+            const Int32_T error{ errno };
+            close(m_Descriptor);
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not make socket non blocking: {}", std::strerror(error)));
+        }
+
+        unlink(m_Path.c_str());
+
+        if (bind(m_Descriptor, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == -1 || listen(m_Descriptor, 8) == -1) {
+            const Int32_T error{ errno };
+            close(m_Descriptor);
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Could not listen on {}: {}", m_Path, std::strerror(error)));
+        }
+
+        for (const auto type : m_Types) {
+            EventManager::Subscribe(m_SubscriberId, type, [this](Event& event) -> bool { Write(event); return false; });
+        }
+    }
+
+    auto SocketBridge::Write(const Event& event) -> void {
+        if (m_Clients.empty()) {
+            return;
+        }
+
+        const Size_T size{ EventCodec::GetWireSize(event.GetType()) };
+
+        if (size == 0) {
+            return;
+        }
+
+        EventCodec::LittleEndian<UInt32_T> length{};
+        length.Set(static_cast<UInt32_T>(size));
+
+        const auto* lengthBytes{ reinterpret_cast<const std::byte*>(&length) };
+        m_Pending.insert(m_Pending.end(), lengthBytes, lengthBytes + FRAME_LENGTH_SIZE);
+
+        const Size_T offset{ m_Pending.size() };
+        m_Pending.resize(offset + size);
+        (void)EventCodec::Encode(event, std::span{ m_Pending }.subspan(offset));
+        ++m_PendingFrames;
+    }
+
+    auto SocketBridge::AcceptClients() -> void {
+        while (true) {
+            const Int32_T descriptor{ accept(m_Descriptor, nullptr, nullptr) };
+
+            if (descriptor == -1) {
+                break;
+            }
+
+            if (!SetNonBlocking(descriptor)) {
+                close(descriptor);
+                continue;
+            }
+
+            m_Clients.push_back({ descriptor });
+        }
+    }
+
+    auto SocketBridge::ReadClient(Client& client) -> bool {
+        std::array<std::byte, 4096> buffer{};
+
+        while (true) {
+            const ssize_t count{ recv(client.Descriptor, buffer.data(), buffer.size(), 0) };
+
+            if (count == 0) {
+                return false;
+            }
+
+            if (count == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+
+            client.Input.insert(client.Input.end(), buffer.begin(), buffer.begin() + count);
+
+            // Queue every complete frame
+            Size_T offset{};
+            while (client.Input.size() - offset >= FRAME_LENGTH_SIZE) {
+                EventCodec::LittleEndian<UInt32_T> encodedLength{};
+                std::memcpy(&encodedLength, client.Input.data() + offset, FRAME_LENGTH_SIZE);
+                const UInt32_T length{ encodedLength.Get() };
+
+                if (length < sizeof(EventCodec::WireHeader) || length > EventCodec::MAX_WIRE_SIZE) {
+                    // Not speaking the protocol, nothing after this can be trusted
+                    return false;
+                }
+
+                if (client.Input.size() - offset - FRAME_LENGTH_SIZE < length) {
+                    break;
+                }
+
+                if (auto event{ EventCodec::Decode(std::span{ client.Input }.subspan(offset + FRAME_LENGTH_SIZE, length)) }) {
+                    // The sender time stamp comes from another clock
+                    event->SetTimeStamp(GetEventTimeStamp());
+                    EventManager::QueueEvent(std::move(event));
+                    ++client.Stats.InjectedEvents;
+                }
+
+                offset += FRAME_LENGTH_SIZE + length;
+            }
+
+            client.Input.erase(client.Input.begin(), client.Input.begin() + static_cast<std::ptrdiff_t>(offset));
+        }
+    }
+
+    auto SocketBridge::SendClient(Client& client) -> bool {
+        // A pass is sent whole or not at all, so the client never gets half a frame
+        const bool sendPending{ !m_Pending.empty() && client.Output.size() + m_Pending.size() <= m_MaxClientBuffer };
+
+        if (!m_Pending.empty() && !sendPending) {
+            client.Stats.DroppedFrames += m_PendingFrames;
+        }
+
+        std::array<iovec, 2> vectors{};
+        Size_T vectorCount{};
+
+        if (!client.Output.empty()) {
+            vectors[vectorCount++] = { client.Output.data(), client.Output.size() };
+        }
+
+        if (sendPending) {
+            vectors[vectorCount++] = { m_Pending.data(), m_Pending.size() };
+        }
+
+        if (vectorCount == 0) {
+            return true;
+        }
+
+        // sendmsg() is writev() with flags, MSG_NOSIGNAL keeps a closed peer from raising SIGPIPE
+        msghdr message{};
+        message.msg_iov = vectors.data();
+        message.msg_iovlen = vectorCount;
+
+        ssize_t written{ sendmsg(client.Descriptor, &message, MSG_NOSIGNAL) };
+
+        if (written == -1) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                return false;
+            }
+
+            written = 0;
+        }
+
+        auto remaining{ static_cast<Size_T>(written) };
+
+        const Size_T fromOutput{ std::min(remaining, client.Output.size()) };
+        client.Output.erase(client.Output.begin(), client.Output.begin() + static_cast<std::ptrdiff_t>(fromOutput));
+        remaining -= fromOutput;
+
+        if (sendPending) {
+            client.Output.insert(client.Output.end(), m_Pending.begin() + static_cast<std::ptrdiff_t>(remaining), m_Pending.end());
+            client.Stats.SentFrames += m_PendingFrames;
+        }
+
+        client.Stats.BufferedBytes = client.Output.size();
+        return true;
+    }
+
+    auto SocketBridge::Update() -> void {
+        AcceptClients();
+
+        auto begin{ m_Clients.begin() };
+        while (begin != m_Clients.end()) {
+            if (ReadClient(*begin) && SendClient(*begin)) {
+                ++begin;
+            }
+            else {
+                close(begin->Descriptor);
+                begin = m_Clients.erase(begin);
+            }
+        }
+
+        m_Pending.clear();
+        m_PendingFrames = 0;
+    }
+
+    auto SocketBridge::GetClientStats() const -> std::vector<SocketClientStats> {
+        std::vector<SocketClientStats> result{};
+        result.reserve(m_Clients.size());
+
+        for (const auto& client : m_Clients) {
+            result.push_back(client.Stats);
+        }
+
+        return result;
+    }
+
+    SocketBridge::~SocketBridge() {
+        for (const auto type : m_Types) {
+            EventManager::Unsubscribe(m_SubscriberId, type);
+        }
+
+        for (const auto& client : m_Clients) {
+            close(client.Descriptor);
+        }
+
+        close(m_Descriptor);
+        unlink(m_Path.c_str());
+    }
+}
@@ -0,0 +1,201 @@
+/**
+ * TopicRouter.cc
+ * Created by kate on 10/19/26.
+ * */
+
+// C++ Standard Library
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <string_view>
+
+// Project Headers
+#include <TopicRouter.hh>
+
+namespace Mikoto {
+    static constexpr std::string_view ANY_SEGMENT{ "*" };
+    static constexpr std::string_view ANY_SEGMENTS{ "**" };
+
+    /**
+     * Splits a channel name or pattern into its segments. Empty segments are skipped
+     * so "a//b/" and "a/b" name the same channel
+     * */
+    static auto SplitPath(std::string_view path) -> std::vector<std::string_view> {
+        std::vector<std::string_view> result{};
+
+        while (!path.empty()) {
+            const auto separator{ path.find('/') };
+            const auto segment{ path.substr(0, separator) };
+
+            if (!segment.empty()) {
+                result.push_back(segment);
+            }
+
+            path = separator == std::string_view::npos ? std::string_view{} : path.substr(separator + 1);
+        }
+
+        return result;
+    }
+
+    /**
+     * Returns true if "**" only appears as the last segment of the pattern
+     * */
+    static auto IsValidPattern(const std::vector<std::string_view>& segments) -> bool {
+        const auto it{ std::ranges::find(segments, ANY_SEGMENTS) };
+        return it == segments.end() || std::next(it) == segments.end();
+    }
+
+    auto TopicRouter::Matches(std::string_view pattern, std::string_view path) -> bool {
+        const auto patternSegments{ SplitPath(pattern) };
+        const auto pathSegments{ SplitPath(path) };
+
+        if (!IsValidPattern(patternSegments)) {
+            return false;
+        }
+
+        for (Size_T index{}; index < patternSegments.size(); ++index) {
+            if (patternSegments[index] == ANY_SEGMENTS) {
+                return true;
+            }
+
+            if (index >= pathSegments.size()) {
+                return false;
+            }
+
+            if (patternSegments[index] != ANY_SEGMENT && patternSegments[index] != pathSegments[index]) {
+                return false;
+            }
+        }
+
+        return patternSegments.size() == pathSegments.size();
+    }
+
+    auto TopicRouter::GetChannel(std::string_view path) -> ChannelId_T {
+        if (const auto it{ m_ChannelIds.find(path) }; it != m_ChannelIds.end()) {
+            return it->second;
+        }
+
+        const auto id{ static_cast<ChannelId_T>(m_Channels.size()) };
+
+        Channel channel{};
+        channel.Path = path;
+        Collect(0, SplitPath(path), 0, channel.Handlers);
+
+        m_Channels.push_back(std::move(channel));
+        m_ChannelIds.emplace(path, id);
+
+        return id;
+    }
+
+    auto TopicRouter::Subscribe(UInt64_T subId, std::string_view pattern, Handler_T&& handler) -> void {
+        const auto segments{ SplitPath(pattern) };
+
+        if (!IsValidPattern(segments)) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Invalid channel pattern {}. '**' is only allowed as the last segment", pattern));
+        }
+
+        UInt32_T node{ 0 };
+
+        for (const auto segment : segments) {
+            auto it{ m_Nodes[node].Children.find(segment) };
+
+            if (it == m_Nodes[node].Children.end()) {
+                const auto child{ static_cast<UInt32_T>(m_Nodes.size()) };
+
+                // Do not keep references into m_Nodes across the push_back
+                m_Nodes.emplace_back();
+                it = m_Nodes[node].Children.emplace(segment, child).first;
+            }
+
+            node = it->second;
+        }
+
+        auto subscription{ std::make_shared<Subscription>(Subscription{ subId, std::string{ pattern }, std::move(handler) }) };
+        m_Nodes[node].Subscriptions.push_back(subscription);
+
+        // Existing channels are matched once, here. Through the trie as GetChannel() does, so
+        // a channel gets the same handlers whether it was registered before or after the subscription
+        std::vector<SubscriptionPtr_T> matching{};
+        for (auto& channel : m_Channels) {
+            matching.clear();
+            Collect(0, SplitPath(channel.Path), 0, matching);
+
+            if (std::ranges::find(matching, subscription) != matching.end()) {
+                channel.Handlers.push_back(subscription);
+            }
+        }
+    }
+
+    auto TopicRouter::Unsubscribe(UInt64_T subId, std::string_view pattern) -> void {
+        const auto node{ FindNode(pattern) };
+
+        if (node == NO_NODE) {
+            return;
+        }
+
+        // The node stands for the pattern once normalized, whichever spelling was used to subscribe
+        auto& subscriptions{ m_Nodes[node].Subscriptions };
+        const auto removed{ std::stable_partition(subscriptions.begin(), subscriptions.end(), [&](const SubscriptionPtr_T& subscription) -> bool {
+            return subscription->SubscriberId != subId;
+        }) };
+
+        if (removed == subscriptions.end()) {
+            return;
+        }
+
+        const std::vector<SubscriptionPtr_T> targets{ removed, subscriptions.end() };
+        subscriptions.erase(removed, subscriptions.end());
+
+        for (auto& channel : m_Channels) {
+            std::erase_if(channel.Handlers, [&](const SubscriptionPtr_T& subscription) -> bool { return std::ranges::find(targets, subscription) != targets.end(); });
+        }
+    }
+
+    auto TopicRouter::Clear() -> void {
+        m_Nodes.assign(1, Node{});
+        m_Channels.clear();
+        m_ChannelIds.clear();
+    }
+
+    auto TopicRouter::FindNode(std::string_view pattern) const -> UInt32_T {
+        UInt32_T node{ 0 };
+
+        for (const auto segment : SplitPath(pattern)) {
+            const auto it{ m_Nodes[node].Children.find(segment) };
+
+            if (it == m_Nodes[node].Children.end()) {
+                return NO_NODE;
+            }
+
+            node = it->second;
+        }
+
+        return node;
+    }
+
+    auto TopicRouter::Collect(UInt32_T node, const std::vector<std::string_view>& segments, Size_T index, std::vector<SubscriptionPtr_T>& result) const -> void {
+        const auto& current{ m_Nodes[node] };
+
+        // "**" also matches when there are no segments left
+        if (const auto it{ current.Children.find(ANY_SEGMENTS) }; it != current.Children.end()) {
+            const auto& subscriptions{ m_Nodes[it->second].Subscriptions };
+            result.insert(result.end(), subscriptions.begin(), subscriptions.end());
+        }
+
+        if (index == segments.size()) {
+            result.insert(result.end(), current.Subscriptions.begin(), current.Subscriptions.end());
+            return;
+        }
+
+        if (const auto it{ current.Children.find(segments[index]) }; it != current.Children.end()) {
+            Collect(it->second, segments, index + 1, result);
+        }
+
+        // A segment literally named "*" was already visited above
+        if (segments[index] != ANY_SEGMENT) {
+            if (const auto it{ current.Children.find(ANY_SEGMENT) }; it != current.Children.end()) {
+                Collect(it->second, segments, index + 1, result);
+            }
+        }
+    }
+}
@@ -2,6 +2,8 @@
 // Created by kate on 10/4/23.
 //
 
+#include <bit>
+
 #include <GLFW/glfw3.h>
 
 #include <Logger.hh>
@@ -42,7 +44,11 @@ namespace Mikoto {
         MKT_CORE_LOGGER_INFO("Created GLFW Window with name '{}'", GetTitle());
         MKT_CORE_LOGGER_INFO("Created GLFW Window with dim [{}, {}]", GetWidth(), GetHeight());
 
+        m_Id = AcquireWindowId();
         InstallCallbacks();
+
+        // Sticky subscribers rely on having a size, the window was not resized so nothing is dispatched
+        EventManager::SeedStickyWindow<WindowResizedEvent>(GetId(), GetWidth(), GetHeight());
     }
 
     auto Window::AllowResizing(bool value) -> void {
@@ -65,7 +71,7 @@ namespace Mikoto {
                                       data->SetWidth(width);
                                       data->SetHeight(height);
 
-                                      EventManager::Trigger<WindowResizedEvent>(width, height);
+                                      EventManager::TriggerWindow<WindowResizedEvent>(data->GetId(), width, height);
                                   }
         );
 
@@ -73,25 +79,26 @@ namespace Mikoto {
                                    [](GLFWwindow* window) {
                                        const Window* data{ static_cast<Window*>(glfwGetWindowUserPointer(window)) };
 
-                                       EventManager::Trigger<WindowCloseEvent>();
+                                       EventManager::TriggerWindow<WindowCloseEvent>(data->GetId());
                                    }
         );
 
         glfwSetKeyCallback(m_Window,
                            [](GLFWwindow* window, Int32_T key, [[maybe_unused]] Int32_T  scancode, Int32_T action, Int32_T mods) -> void {
-                               const Window* data{ static_cast<Window*>(glfwGetWindowUserPointer(window)) };
+                               Window* data{ static_cast<Window*>(glfwGetWindowUserPointer(window)) };
+                               data->m_InputState.OnKey(key, action != GLFW_RELEASE, mods);
 
                                switch (action) {
                                    case GLFW_PRESS: {
-                                       EventManager::Trigger<KeyPressedEvent>(key, false, mods);
+                                       EventManager::TriggerWindow<KeyPressedEvent>(data->GetId(), key, false, mods);
                                        break;
                                    }
                                    case GLFW_RELEASE: {
-                                       EventManager::Trigger<KeyReleasedEvent>(key);
+                                       EventManager::TriggerWindow<KeyReleasedEvent>(data->GetId(), key);
                                        break;
                                    }
                                    case GLFW_REPEAT: {
-                                       EventManager::Trigger<KeyPressedEvent>(key, true, mods);
+                                       EventManager::TriggerWindow<KeyPressedEvent>(data->GetId(), key, true, mods);
                                        break;
                                    }
                                    default: {
@@ -104,15 +111,16 @@ namespace Mikoto {
 
         glfwSetMouseButtonCallback(m_Window,
                                    [](GLFWwindow* window, Int32_T button, Int32_T action, Int32_T mods) -> void {
-                                       const Window* data{ static_cast<Window*>(glfwGetWindowUserPointer(window)) };
+                                       Window* data{ static_cast<Window*>(glfwGetWindowUserPointer(window)) };
+                                       data->m_InputState.OnMouseButton(button, action == GLFW_PRESS, mods);
 
                                        switch (action) {
                                            case GLFW_PRESS: {
-                                               MouseButtonPressedEvent mousePressed{ button, mods };
+                                               EventManager::TriggerWindow<MouseButtonPressedEvent>(data->GetId(), button, mods);
                                                break;
                                            }
                                            case GLFW_RELEASE: {
-                                               MouseButtonReleasedEvent mouseReleased{ button };
+                                               EventManager::TriggerWindow<MouseButtonReleasedEvent>(data->GetId(), button);
                                                break;
                                            }
                                            default:
@@ -124,22 +132,26 @@ namespace Mikoto {
 
         glfwSetScrollCallback(m_Window,
                               [](GLFWwindow* window, double xOffset, double yOffset) -> void {
-                                  const Window* data{ static_cast<Window*>(glfwGetWindowUserPointer(window)) };
-                                  MouseScrollEvent msc{ xOffset, yOffset };
+                                  Window* data{ static_cast<Window*>(glfwGetWindowUserPointer(window)) };
+                                  data->m_InputState.OnScroll(xOffset, yOffset);
+
+                                  EventManager::TriggerWindow<MouseScrollEvent>(data->GetId(), xOffset, yOffset);
                               }
         );
 
         glfwSetCursorPosCallback(m_Window,
                                  [](GLFWwindow* window, double x, double y) -> void {
-                                     const Window* data{ static_cast<Window*>(glfwGetWindowUserPointer(window)) };
-                                     EventManager::Trigger<MouseMovedEvent>(x, y);
+                                     Window* data{ static_cast<Window*>(glfwGetWindowUserPointer(window)) };
+                                     data->m_InputState.OnCursorMoved(x, y);
+
+                                     EventManager::TriggerWindow<MouseMovedEvent>(data->GetId(), x, y);
                                  }
         );
 
         glfwSetCharCallback(m_Window,
                             [](GLFWwindow* window, UInt32_T codePoint) -> void {
                                 const Window* data{ static_cast<Window*>(glfwGetWindowUserPointer(window)) };
-                                KeyCharEvent kce{ codePoint };
+                                EventManager::TriggerWindow<KeyCharEvent>(data->GetId(), codePoint);
                             }
         );
 
@@ -158,6 +170,29 @@ namespace Mikoto {
         MKT_CORE_LOGGER_INFO("GLFW Window dimensions are [{}, {}]", GetWidth(), GetHeight());
 
         DestroyGLFWWindow(m_Window);
+        ReleaseWindowId(m_Id);
+    }
+
+    auto Window::AcquireWindowId() -> WindowId_T {
+        // Lowest free id, ids stay small enough to index the per window dispatch lists
+        const auto index{ std::countr_one(s_WindowIdsInUse) };
+        MKT_ASSERT(static_cast<Size_T>(index) < MAX_WINDOW_COUNT, "Too many windows alive");
+
+        // Events of windows past the limit are only seen by the handlers of every window
+        if (static_cast<Size_T>(index) >= MAX_WINDOW_COUNT) {
+            return ANY_WINDOW_ID;
+        }
+
+        s_WindowIdsInUse |= UInt32_T{ 1 } << index;
+        return static_cast<WindowId_T>(index + 1);
+    }
+
+    auto Window::ReleaseWindowId(WindowId_T id) -> void {
+        if (id != ANY_WINDOW_ID) {
+            // Handlers and sticky events of this window must not reach the next window given the id
+            EventManager::ReleaseWindow(id);
+            s_WindowIdsInUse &= ~(UInt32_T{ 1 } << (id - 1));
+        }
     }
 
     auto Window::DestroyGLFWWindow(GLFWwindow* window) -> void {
@@ -183,6 +218,8 @@ namespace Mikoto {
     }
 
     auto Window::PollEvents() -> void {
+        // Edges and accumulators of the input state only cover what this poll delivers
+        m_InputState.NewFrame();
         glfwPollEvents();
     }
 
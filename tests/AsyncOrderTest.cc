@@ -0,0 +1,120 @@
+/**
+ * AsyncOrderTest.cc
+ *
+ * Producer threads queue events tagged with their producer and sequence number while the
+ * main thread dispatches. Each producer mixes QueueEventAsync() batches filled past
+ * ASYNC_EVENT_BATCH_SIZE, explicit FlushAsyncEvents() calls and plain QueueEvent(), and every
+ * producer has to be delivered all its events in the order it queued them. Meant to be run
+ * under ThreadSanitizer as well, see EVENT_SYSTEM_SANITIZER in CMakeLists.txt.
+ * */
+
+// C++ Standard Library
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <thread>
+#include <vector>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+#include <CoreEvents.hh>
+#include <EventManager.hh>
+#include <TestCheck.hh>
+
+namespace {
+    using namespace Mikoto;
+    using namespace Mikoto::EventManager;
+
+    constexpr UInt32_T PRODUCER_COUNT{ 4 };
+    constexpr UInt64_T EVENTS_PER_PRODUCER{ ASYNC_EVENT_BATCH_SIZE * 8 + 17 };
+
+    // Every so often a producer flushes a partial batch or goes through QueueEvent()
+    constexpr UInt64_T FLUSH_PERIOD{ 97 };
+    constexpr UInt64_T QUEUE_EVENT_PERIOD{ 41 };
+
+    constexpr UInt64_T SUBSCRIBER{ 1 };
+
+    /**
+     * Queues the events of one producer, tagged as (producer, sequence) in the mouse position
+     * */
+    auto Produce(EventBus& bus, UInt32_T producer) -> void {
+        for (UInt64_T sequence{}; sequence < EVENTS_PER_PRODUCER; ++sequence) {
+            const auto x{ static_cast<double>(producer) };
+            const auto y{ static_cast<double>(sequence) };
+
+            if (sequence % QUEUE_EVENT_PERIOD == 0) {
+                bus.Trigger<MouseMovedEvent>(x, y);
+            }
+            else {
+                bus.TriggerAsync<MouseMovedEvent>(x, y);
+            }
+
+            if (sequence % FLUSH_PERIOD == 0) {
+                bus.FlushAsyncEvents();
+            }
+        }
+
+        bus.FlushAsyncEvents();
+    }
+}
+
+int main() {
+    EventBus bus{ { "async-order" } };
+    bus.BindToCurrentThread();
+
+    std::array<UInt64_T, PRODUCER_COUNT> nextSequence{};
+    UInt64_T received{};
+    bool outOfOrder{};
+
+    bus.Subscribe(SUBSCRIBER, EventType::MOUSE_MOVED_EVENT, [&](Event& event) -> bool {
+        const auto& moved{ static_cast<MouseMovedEvent&>(event) };
+        const auto producer{ static_cast<Size_T>(moved.GetPositionX()) };
+        const auto sequence{ static_cast<UInt64_T>(moved.GetPositionY()) };
+
+        outOfOrder = outOfOrder || producer >= PRODUCER_COUNT || sequence != nextSequence[producer];
+
+        if (producer < PRODUCER_COUNT) {
+            nextSequence[producer] = sequence + 1;
+        }
+
+        ++received;
+        return false;
+    });
+
+    std::latch start{ PRODUCER_COUNT + 1 };
+    std::vector<std::jthread> producers{};
+
+    for (UInt32_T producer{}; producer < PRODUCER_COUNT; ++producer) {
+        producers.emplace_back([&bus, &start, producer]() -> void {
+            start.arrive_and_wait();
+            Produce(bus, producer);
+        });
+    }
+
+    start.arrive_and_wait();
+
+    const auto deadline{ std::chrono::steady_clock::now() + std::chrono::seconds{ 30 } };
+    const UInt64_T expected{ PRODUCER_COUNT * EVENTS_PER_PRODUCER };
+
+    while (received < expected && std::chrono::steady_clock::now() < deadline) {
+        bus.ProcessEvents();
+        std::this_thread::yield();
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    bus.ProcessEvents();
+
+    MKT_TEST_CHECK(received == expected);
+    MKT_TEST_CHECK(!outOfOrder);
+
+    for (const auto sequence : nextSequence) {
+        MKT_TEST_CHECK(sequence == EVENTS_PER_PRODUCER);
+    }
+
+    return MKT_TEST_EXIT_CODE();
+}
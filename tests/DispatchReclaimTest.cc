@@ -0,0 +1,49 @@
+/**
+ * DispatchReclaimTest.cc
+ *
+ * Handlers removed while the dispatcher walks their snapshot are released once
+ * the dispatcher leaves its read guard, without waiting for another retirement.
+ * */
+
+// C++ Standard Library
+#include <memory>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+#include <CoreEvents.hh>
+#include <EventManager.hh>
+#include <TestCheck.hh>
+
+int main() {
+    using namespace Mikoto;
+
+    constexpr UInt64_T SUBSCRIBER{ 5 };
+
+    // Owned by the handler only, released with it
+    auto token{ std::make_shared<int>() };
+    const std::weak_ptr<int> watched{ token };
+
+    EventManager::Subscribe(SUBSCRIBER, EventType::KEY_CHAR_EVENT, [token = std::move(token)](Event&) -> bool {
+        EventManager::Unsubscribe(SUBSCRIBER, EventType::KEY_CHAR_EVENT);
+        return false;
+    });
+
+    EventManager::Trigger<KeyCharEvent>(65u);
+    EventManager::ProcessEvents();
+
+    MKT_TEST_CHECK(watched.expired());
+
+    // Retirements with no reader around are released right away
+    auto other{ std::make_shared<int>() };
+    const std::weak_ptr<int> otherWatched{ other };
+
+    EventManager::Subscribe(SUBSCRIBER, EventType::KEY_CHAR_EVENT, [other = std::move(other)](Event&) -> bool { return false; });
+    EventManager::Unsubscribe(SUBSCRIBER, EventType::KEY_CHAR_EVENT);
+
+    MKT_TEST_CHECK(otherWatched.expired());
+
+    EventManager::Shutdown();
+
+    return MKT_TEST_EXIT_CODE();
+}
@@ -0,0 +1,205 @@
+/**
+ * EventBusTest.cc
+ *
+ * Two buses processed on threads of their own, fed and subscribed to from the main thread.
+ * Checks that buses share nothing, that events queued from another thread are delivered
+ * without a flush, that handlers subscribed from another thread while the bus dispatches run on
+ * the bus thread only and get their sticky replay before any newer event, and that what belongs
+ * to the processing thread throws elsewhere. Meant to be run under
+ * ThreadSanitizer as well, see EVENT_SYSTEM_SANITIZER in CMakeLists.txt.
+ * */
+
+// C++ Standard Library
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <memory>
+#include <thread>
+#include <stdexcept>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+#include <CoreEvents.hh>
+#include <EventManager.hh>
+#include <TestCheck.hh>
+
+namespace {
+    using namespace Mikoto;
+    using namespace Mikoto::EventManager;
+
+    constexpr UInt64_T SUBSCRIBER{ 1 };
+    constexpr UInt64_T STICKY_SUBSCRIBER{ 2 };
+
+    struct PingQuery {
+        using Result_T = Int32_T;
+    };
+
+    /**
+     * Bus processed by a thread of its own until stopped
+     * */
+    struct BusThread {
+        explicit BusThread(const char* name)
+            :   Bus{ { name } } {}
+
+        auto Start(std::latch& bound) -> void {
+            Thread = std::jthread{ [this, &bound](std::stop_token stop) -> void {
+                Bus.BindToCurrentThread();
+                bound.count_down();
+
+                while (!stop.stop_requested()) {
+                    Bus.ProcessEvents();
+                    std::this_thread::yield();
+                }
+
+                Bus.ProcessEvents();
+            } };
+        }
+
+        EventBus Bus;
+
+        // Incremented by the handlers, which only run on the bus thread
+        std::atomic<UInt64_T> KeyChars{};
+        std::atomic<UInt64_T> MouseMoves{};
+        std::atomic<bool> WrongThread{};
+
+        // Last member, stopped and joined before the bus goes away
+        std::jthread Thread{};
+    };
+
+    auto WaitFor(const std::atomic<UInt64_T>& counter, UInt64_T expected) -> bool {
+        const auto deadline{ std::chrono::steady_clock::now() + std::chrono::seconds{ 10 } };
+
+        while (counter.load() < expected) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+
+            std::this_thread::yield();
+        }
+
+        return true;
+    }
+
+    auto Throws(auto&& function) -> bool {
+        try {
+            function();
+        }
+        catch (const std::runtime_error&) {
+            return true;
+        }
+
+        return false;
+    }
+}
+
+int main() {
+    constexpr UInt64_T EVENT_COUNT{ 2'000 };
+    constexpr UInt64_T RESUBSCRIBE_COUNT{ 500 };
+
+    std::array<BusThread, 2> buses{ BusThread{ "first" }, BusThread{ "second" } };
+
+    // Set up before the buses are bound, from the thread which will not process them
+    for (auto& bus : buses) {
+        bus.Bus.SetSticky<WindowResizedEvent>();
+
+        bus.Bus.Subscribe(SUBSCRIBER, EventType::KEY_CHAR_EVENT, [&bus](Event&) -> bool {
+            bus.WrongThread = bus.WrongThread || !bus.Bus.IsOnBoundThread();
+            ++bus.KeyChars;
+            return false;
+        });
+    }
+
+    // Only the second bus has mouse handlers
+    auto& second{ buses[1] };
+    second.Bus.Subscribe(SUBSCRIBER, EventType::MOUSE_MOVED_EVENT, [&second](Event&) -> bool { ++second.MouseMoves; return false; });
+
+    std::latch bound{ static_cast<std::ptrdiff_t>(buses.size()) };
+
+    for (auto& bus : buses) {
+        bus.Start(bound);
+    }
+
+    bound.wait();
+
+    // Plain QueueEvent() from another thread, nothing flushed: every event has to arrive
+    for (UInt64_T index{}; index < EVENT_COUNT; ++index) {
+        for (auto& bus : buses) {
+            bus.Bus.Trigger<KeyCharEvent>(65u);
+            bus.Bus.Trigger<MouseMovedEvent>(1.0, 2.0);
+        }
+    }
+
+    for (auto& bus : buses) {
+        MKT_TEST_CHECK(WaitFor(bus.KeyChars, EVENT_COUNT));
+    }
+
+    MKT_TEST_CHECK(WaitFor(second.MouseMoves, EVENT_COUNT));
+    MKT_TEST_CHECK(buses[0].MouseMoves.load() == 0);
+
+    // One resize is stored before the handlers below subscribe, so each of them has a replay
+    std::atomic<UInt64_T> resized{};
+    second.Bus.Subscribe(SUBSCRIBER, EventType::WINDOW_RESIZE_EVENT, [&resized](Event&) -> bool { ++resized; return false; });
+    second.Bus.Trigger<WindowResizedEvent>(1, 10);
+    MKT_TEST_CHECK(WaitFor(resized, 1));
+
+    // Sticky handlers subscribed from this thread while the bus thread dispatches resize events
+    // of growing width. Every handler has to run on the bus thread only, its replay first, and
+    // never see a width it has already seen or an older one. Half of them unsubscribe right away
+    std::atomic<UInt64_T> replayed{};
+    std::atomic<bool> stickyWrongThread{};
+    std::atomic<bool> stickyWentBack{};
+
+    for (UInt64_T index{}; index < RESUBSCRIBE_COUNT; ++index) {
+        second.Bus.Trigger<WindowResizedEvent>(static_cast<Int32_T>(index + 2), 10);
+
+        const bool kept{ index % 2 == 0 };
+        const UInt64_T subId{ STICKY_SUBSCRIBER + index };
+
+        second.Bus.Subscribe(subId, EventType::WINDOW_RESIZE_EVENT, [&, kept, lastWidth{ std::make_shared<Int32_T>() }](Event& event) -> bool {
+            const auto width{ static_cast<WindowResizedEvent&>(event).GetWidth() };
+
+            stickyWrongThread = stickyWrongThread || !second.Bus.IsOnBoundThread();
+            stickyWentBack = stickyWentBack || width <= *lastWidth;
+
+            if (kept && *lastWidth == 0) {
+                ++replayed;
+            }
+
+            *lastWidth = width;
+            return false;
+        });
+
+        if (!kept) {
+            second.Bus.Unsubscribe(subId, EventType::WINDOW_RESIZE_EVENT);
+        }
+    }
+
+    MKT_TEST_CHECK(WaitFor(replayed, RESUBSCRIBE_COUNT / 2));
+    MKT_TEST_CHECK(!stickyWrongThread.load());
+    MKT_TEST_CHECK(!stickyWentBack.load());
+
+    // Processing thread only, the bound buses refuse them from here
+    auto& first{ buses[0].Bus };
+    MKT_TEST_CHECK(Throws([&]() -> void { first.ProcessEvents(); }));
+    MKT_TEST_CHECK(Throws([&]() -> void { first.SubscribeChannel(SUBSCRIBER, "net/*", [](Event&) -> bool { return false; }); }));
+    MKT_TEST_CHECK(Throws([&]() -> void { first.SubscribeBatch<KeyCharEvent>(SUBSCRIBER, [](std::span<const KeyCharEvent>) -> void {}); }));
+    MKT_TEST_CHECK(Throws([&]() -> void { first.Respond<PingQuery>(SUBSCRIBER, [](const PingQuery&) -> Int32_T { return 1; }); }));
+    MKT_TEST_CHECK(Throws([&]() -> void { first.SetSticky<KeyCharEvent>(); }));
+    MKT_TEST_CHECK(Throws([&]() -> void { first.SeedStickyWindow<WindowResizedEvent>(1, 1, 1); }));
+    MKT_TEST_CHECK(Throws([&]() -> void { (void)first.Latest<WindowResizedEvent>(); }));
+    MKT_TEST_CHECK(Throws([&]() -> void { (void)first.LatestWindow<WindowResizedEvent>(1); }));
+    MKT_TEST_CHECK(Throws([&]() -> void { first.SetWatchdogSpec({}); }));
+    MKT_TEST_CHECK(Throws([&]() -> void { first.ResetWatchdog(); }));
+    MKT_TEST_CHECK(Throws([&]() -> void { (void)first.GetSlowHandlerReports(); }));
+
+    for (auto& bus : buses) {
+        bus.Thread.request_stop();
+        bus.Thread.join();
+
+        MKT_TEST_CHECK(!bus.WrongThread.load());
+    }
+
+    return MKT_TEST_EXIT_CODE();
+}
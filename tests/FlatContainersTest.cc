@@ -0,0 +1,291 @@
+/**
+ * FlatContainersTest.cc
+ *
+ * SmallVector growth out of its inline storage, FlatHashMap rehashing and backward shift
+ * erase, and a randomized comparison of both against std::unordered_map and std::vector.
+ * */
+
+// C++ Standard Library
+#include <array>
+#include <random>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+
+// Project Headers
+#include <Common.hh>
+#include <FlatContainers.hh>
+#include <TestCheck.hh>
+
+namespace {
+    using namespace Mikoto;
+
+    /**
+     * Value counting its live instances, catches elements leaked or destroyed twice
+     * */
+    class Counted {
+    public:
+        Counted(Int64_T value = 0)
+            :   m_Value{ value } { ++s_Live; }
+
+        Counted(const Counted& other)
+            :   m_Value{ other.m_Value } { ++s_Live; }
+
+        Counted(Counted&& other) noexcept
+            :   m_Value{ std::exchange(other.m_Value, -1) } { ++s_Live; }
+
+        auto operator=(const Counted& other) -> Counted& = default;
+
+        auto operator=(Counted&& other) noexcept -> Counted& {
+            m_Value = std::exchange(other.m_Value, -1);
+            return *this;
+        }
+
+        MKT_NODISCARD auto GetValue() const -> Int64_T { return m_Value; }
+        MKT_NODISCARD static auto GetLive() -> Int64_T { return s_Live; }
+
+        ~Counted() { --s_Live; }
+
+    private:
+        Int64_T m_Value{};
+        static inline Int64_T s_Live{};
+    };
+
+    using Vector_T = SmallVector<Counted, 3>;
+
+    // Same mixing as FlatHashMap, to build keys sharing a home slot
+    auto GetHomeSlot(UInt64_T key, Size_T capacity) -> Size_T {
+        key = (key ^ (key >> 33)) * 0xFF51AFD7ED558CCD;
+        key = (key ^ (key >> 33)) * 0xC4CEB9FE1A85EC53;
+        return (key ^ (key >> 33)) & (capacity - 1);
+    }
+
+    auto FindKeys(Size_T home, Size_T capacity, Size_T count, UInt64_T first) -> std::vector<UInt64_T> {
+        std::vector<UInt64_T> keys{};
+
+        for (UInt64_T key{ first }; keys.size() < count; ++key) {
+            if (GetHomeSlot(key, capacity) == home) {
+                keys.push_back(key);
+            }
+        }
+
+        return keys;
+    }
+
+    auto Matches(const Vector_T& vector, const std::vector<Int64_T>& expected) -> bool {
+        return std::ranges::equal(vector, expected, {}, &Counted::GetValue);
+    }
+
+    auto TestSmallVectorGrowth() -> void {
+        {
+            Vector_T vector{};
+
+            for (Int64_T value{}; value < 3; ++value) {
+                vector.emplace_back(value);
+            }
+
+            MKT_TEST_CHECK(vector.IsInline());
+            MKT_TEST_CHECK(vector.capacity() == 3);
+
+            // Full, the new element refers to one of those being moved to the heap
+            vector.emplace_back(vector[0]);
+
+            MKT_TEST_CHECK(!vector.IsInline());
+            MKT_TEST_CHECK(vector.capacity() == 6);
+            MKT_TEST_CHECK(Matches(vector, { 0, 1, 2, 0 }));
+
+            for (Int64_T value{ 4 }; value < 20; ++value) {
+                vector.emplace_back(value);
+            }
+
+            MKT_TEST_CHECK(vector.size() == 20);
+            MKT_TEST_CHECK(vector[19].GetValue() == 19);
+
+            vector.erase(vector.begin() + 1, vector.begin() + 3);
+            MKT_TEST_CHECK(vector.size() == 18);
+            MKT_TEST_CHECK(vector[1].GetValue() == 0 && vector[2].GetValue() == 4);
+
+            // Heap storage is taken over by a move, the source is left empty and inline
+            Vector_T moved{ std::move(vector) };
+            MKT_TEST_CHECK(moved.size() == 18 && !moved.IsInline());
+            MKT_TEST_CHECK(vector.empty() && vector.IsInline());
+
+            Vector_T copy{ moved };
+            MKT_TEST_CHECK(std::ranges::equal(copy, moved, {}, &Counted::GetValue, &Counted::GetValue));
+
+            // Inline storage is moved element by element
+            Vector_T small{};
+            small.emplace_back(7);
+            copy = std::move(small);
+            MKT_TEST_CHECK(Matches(copy, { 7 }) && copy.IsInline());
+            MKT_TEST_CHECK(small.empty());
+
+            vector.reserve(10);
+            MKT_TEST_CHECK(!vector.IsInline() && vector.capacity() == 10);
+        }
+
+        MKT_TEST_CHECK(Counted::GetLive() == 0);
+    }
+
+    auto TestRehash() -> void {
+        {
+            FlatHashMap<UInt64_T, Counted> map{};
+
+            // Grows past 7/8 of the slots, sequential keys as subscriber ids usually are
+            for (UInt64_T key{}; key < 1000; ++key) {
+                const auto capacity{ map.GetCapacity() };
+                map[key] = Counted{ static_cast<Int64_T>(key * 3) };
+
+                MKT_TEST_CHECK(map.size() * 8 <= map.GetCapacity() * 7);
+                MKT_TEST_CHECK(map.GetCapacity() == capacity || map.GetCapacity() == std::max<Size_T>(capacity * 2, 16));
+            }
+
+            MKT_TEST_CHECK(map.GetCapacity() == 2048);
+
+            Size_T visited{};
+            for (const auto& [key, value] : map) {
+                MKT_TEST_CHECK(value.GetValue() == static_cast<Int64_T>(key * 3));
+                ++visited;
+            }
+
+            MKT_TEST_CHECK(visited == 1000);
+            MKT_TEST_CHECK(Counted::GetLive() == 1000);
+        }
+
+        MKT_TEST_CHECK(Counted::GetLive() == 0);
+    }
+
+    auto TestBackwardShiftErase() -> void {
+        constexpr Size_T CAPACITY{ 16 };
+
+        // A cluster wrapping past the end of the slots: three keys at home in the last
+        // slot and two in the first one, stored in slots 15, 0, 1, 2 and 3
+        const auto last{ FindKeys(CAPACITY - 1, CAPACITY, 3, 1) };
+        const auto first{ FindKeys(0, CAPACITY, 2, 1) };
+
+        std::vector<UInt64_T> cluster{ last };
+        cluster.insert(cluster.end(), first.begin(), first.end());
+
+        // Every removal order of the cluster members
+        std::array<Size_T, 5> order{ 0, 1, 2, 3, 4 };
+
+        do {
+            FlatHashMap<UInt64_T, Counted> map{};
+
+            for (const auto key : cluster) {
+                map[key] = Counted{ static_cast<Int64_T>(key) };
+            }
+
+            MKT_TEST_CHECK(map.GetCapacity() == CAPACITY);
+
+            for (Size_T removed{}; removed < order.size(); ++removed) {
+                map.erase(map.find(cluster[order[removed]]));
+
+                // The keys left must still be reachable from their home slot
+                for (Size_T index{ removed + 1 }; index < order.size(); ++index) {
+                    const auto key{ cluster[order[index]] };
+                    const auto found{ map.find(key) };
+
+                    MKT_TEST_CHECK(found != map.end() && found->second.GetValue() == static_cast<Int64_T>(key));
+                }
+
+                MKT_TEST_CHECK(!map.contains(cluster[order[removed]]));
+                MKT_TEST_CHECK(map.size() == order.size() - removed - 1);
+            }
+
+            MKT_TEST_CHECK(map.begin() == map.end());
+        } while (std::ranges::next_permutation(order).found);
+
+        MKT_TEST_CHECK(Counted::GetLive() == 0);
+    }
+
+    auto TestAgainstStandardContainers() -> void {
+        constexpr UInt64_T OPERATION_COUNT{ 200'000 };
+        constexpr UInt64_T KEY_RANGE{ 2'000 };
+
+        {
+            std::mt19937_64 engine{ 7 };
+
+            FlatHashMap<UInt64_T, Vector_T> map{};
+            std::unordered_map<UInt64_T, std::vector<Int64_T>> expected{};
+
+            for (UInt64_T operation{}; operation < OPERATION_COUNT; ++operation) {
+                const UInt64_T key{ engine() % KEY_RANGE };
+                const auto value{ static_cast<Int64_T>(engine() % 1000) };
+
+                switch (engine() % 4) {
+                    case 0:
+                    case 1:
+                        map[key].emplace_back(value);
+                        expected[key].push_back(value);
+                        break;
+
+                    case 2: {
+                        const auto found{ map.find(key) };
+                        const auto expectedFound{ expected.find(key) };
+
+                        MKT_TEST_CHECK((found == map.end()) == (expectedFound == expected.end()));
+
+                        if (found != map.end() && expectedFound != expected.end()) {
+                            map.erase(found);
+                            expected.erase(expectedFound);
+                        }
+
+                        break;
+                    }
+
+                    default: {
+                        // Drops the first element, going back to inline storage through a copy
+                        const auto found{ map.find(key) };
+
+                        if (found == map.end() || found->second.empty()) {
+                            break;
+                        }
+
+                        auto& vector{ found->second };
+                        vector.erase(vector.begin(), vector.begin() + 1);
+                        vector = Vector_T{ vector.begin(), vector.end() };
+
+                        auto& expectedVector{ expected.at(key) };
+                        expectedVector.erase(expectedVector.begin());
+                        break;
+                    }
+                }
+
+                if (operation % 10'000 != 0) {
+                    continue;
+                }
+
+                MKT_TEST_CHECK(map.size() == expected.size());
+
+                for (const auto& [expectedKey, expectedVector] : expected) {
+                    const auto found{ map.find(expectedKey) };
+                    MKT_TEST_CHECK(found != map.end() && Matches(found->second, expectedVector));
+                }
+            }
+
+            Size_T visited{};
+            for (const auto& [key, vector] : map) {
+                MKT_TEST_CHECK(expected.contains(key) && Matches(vector, expected.at(key)));
+                ++visited;
+            }
+
+            MKT_TEST_CHECK(visited == expected.size());
+
+            map.clear();
+            MKT_TEST_CHECK(map.empty() && Counted::GetLive() == 0);
+        }
+
+        MKT_TEST_CHECK(Counted::GetLive() == 0);
+    }
+}
+
+int main() {
+    TestSmallVectorGrowth();
+    TestRehash();
+    TestBackwardShiftErase();
+    TestAgainstStandardContainers();
+
+    return MKT_TEST_EXIT_CODE();
+}
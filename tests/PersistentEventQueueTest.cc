@@ -0,0 +1,213 @@
+/**
+ * PersistentEventQueueTest.cc
+ *
+ * Events queued by a process dying without unwinding are recovered by the next one, past
+ * its committed position only. A consumer slot torn while written falls back to the position
+ * committed before it, and segments behind the consumer are recycled instead of new files
+ * being created, without their old records coming back.
+ * */
+
+// C++ Standard Library
+#include <array>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+
+// POSIX
+#include <unistd.h>
+#include <sys/wait.h>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+#include <CoreEvents.hh>
+#include <PersistentEventQueue.hh>
+#include <TestCheck.hh>
+
+namespace {
+    using namespace Mikoto;
+
+    constexpr UInt32_T EVENT_COUNT{ 100 };
+    constexpr UInt32_T PROCESSED_COUNT{ 30 };
+
+    /**
+     * Empty directory of its own for every check, removed when done
+     * */
+    struct QueueDirectory {
+        explicit QueueDirectory(std::string_view name)
+            :   Path{ std::filesystem::temp_directory_path() / fmt::format("PersistentEventQueueTest-{}-{}", getpid(), name) }
+        {
+            std::filesystem::remove_all(Path);
+        }
+
+        ~QueueDirectory() { std::filesystem::remove_all(Path); }
+
+        Path_T Path{};
+    };
+
+    auto IsSamePosition(const PersistentQueuePosition& first, const PersistentQueuePosition& second) -> bool {
+        return first.Segment == second.Segment && first.Offset == second.Offset;
+    }
+
+    /**
+     * Checks the events are key chars numbered from first on
+     * */
+    auto IsSequence(const std::vector<std::unique_ptr<Event>>& events, UInt32_T first, UInt32_T count) -> bool {
+        if (events.size() != count) {
+            return false;
+        }
+
+        for (UInt32_T index{}; index < count; ++index) {
+            const auto& event{ *events[index] };
+
+            if (event.GetType() != EventType::KEY_CHAR_EVENT || static_cast<const KeyCharEvent&>(event).GetChar() != first + index) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    auto AppendSequence(PersistentEventQueue& queue, UInt32_T first, UInt32_T count) -> void {
+        for (UInt32_T index{}; index < count; ++index) {
+            MKT_TEST_CHECK(queue.Append(KeyCharEvent{ first + index }));
+        }
+    }
+
+    auto CheckUncleanExit() -> void {
+        QueueDirectory directory{ "unclean" };
+
+        // The child appends, commits part of the events and dies with nothing flushed nor unmapped
+        const pid_t child{ fork() };
+
+        if (child == 0) {
+            PersistentEventQueue queue{ directory.Path, PersistentQueueSpec{ .SyncInterval = std::chrono::hours{ 1 } } };
+
+            AppendSequence(queue, 0, PROCESSED_COUNT);
+            queue.Commit(queue.GetWritePosition());
+            AppendSequence(queue, PROCESSED_COUNT, EVENT_COUNT - PROCESSED_COUNT);
+
+            _exit(MKT_TEST_EXIT_CODE());
+        }
+
+        Int32_T status{};
+        MKT_TEST_CHECK(child > 0 && waitpid(child, &status, 0) == child);
+        MKT_TEST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+        PersistentEventQueue queue{ directory.Path };
+        MKT_TEST_CHECK(IsSequence(queue.Recover(), PROCESSED_COUNT, EVENT_COUNT - PROCESSED_COUNT));
+
+        // Appending after the recovered events keeps them
+        AppendSequence(queue, EVENT_COUNT, 1);
+        MKT_TEST_CHECK(IsSequence(queue.Recover(), PROCESSED_COUNT, EVENT_COUNT - PROCESSED_COUNT + 1));
+    }
+
+    auto CheckTornConsumerSlot() -> void {
+        QueueDirectory directory{ "torn" };
+        PersistentQueuePosition older{};
+
+        {
+            PersistentEventQueue queue{ directory.Path };
+
+            AppendSequence(queue, 0, PROCESSED_COUNT);
+            older = queue.GetWritePosition();
+            queue.Commit(older);
+
+            AppendSequence(queue, PROCESSED_COUNT, EVENT_COUNT - PROCESSED_COUNT);
+            queue.Commit(queue.GetWritePosition());
+        }
+
+        // Same layout as the consumer file: magic and version, then two slots of
+        // generation, segment, offset and check. The newest slot gets a wrong check
+        struct Slot {
+            UInt64_T Generation{};
+            UInt64_T Segment{};
+            UInt64_T Offset{};
+            UInt64_T Check{};
+        };
+
+        constexpr std::streamoff SLOTS_OFFSET{ 8 };
+        std::array<Slot, 2> slots{};
+
+        std::fstream file{ directory.Path / "consumer.mkq", std::ios::in | std::ios::out | std::ios::binary };
+        file.seekg(SLOTS_OFFSET);
+        file.read(reinterpret_cast<char*>(slots.data()), sizeof(slots));
+
+        auto& newest{ slots[0].Generation > slots[1].Generation ? slots[0] : slots[1] };
+        newest.Check ^= 1;
+
+        file.seekp(SLOTS_OFFSET);
+        file.write(reinterpret_cast<const char*>(slots.data()), sizeof(slots));
+        file.close();
+        MKT_TEST_CHECK(!file.fail());
+
+        PersistentEventQueue queue{ directory.Path };
+        MKT_TEST_CHECK(IsSamePosition(queue.GetCommittedPosition(), older));
+        MKT_TEST_CHECK(IsSequence(queue.Recover(), PROCESSED_COUNT, EVENT_COUNT - PROCESSED_COUNT));
+    }
+
+    auto CountSegmentFiles(const Path_T& directory) -> Size_T {
+        Size_T result{};
+
+        for (const auto& entry : std::filesystem::directory_iterator{ directory }) {
+            result += entry.path().filename().string().starts_with("segment-");
+        }
+
+        return result;
+    }
+
+    auto CheckSegmentRecycling() -> void {
+        QueueDirectory directory{ "recycling" };
+
+        // Smallest segments, a few records each
+        const PersistentQueueSpec spec{ .SegmentSize = 1 };
+        constexpr UInt32_T EVENTS_PER_ROUND{ 64 };
+        constexpr UInt64_T RECYCLED_COUNT{ 8 };
+
+        {
+            PersistentEventQueue queue{ directory.Path, spec };
+
+            // Each round fills several segments and processes them. The cleaner
+            // runs on its own thread, the rounds go on until it kept up a few times
+            const auto deadline{ std::chrono::steady_clock::now() + std::chrono::seconds{ 10 } };
+            UInt32_T next{};
+
+            while (queue.GetRecycledCount() < RECYCLED_COUNT && std::chrono::steady_clock::now() < deadline) {
+                AppendSequence(queue, next, EVENTS_PER_ROUND);
+                next += EVENTS_PER_ROUND;
+
+                queue.Commit(queue.GetWritePosition());
+                std::this_thread::sleep_for(std::chrono::milliseconds{ 5 });
+            }
+
+            const auto started{ queue.GetWritePosition().Segment + 1 };
+
+            MKT_TEST_CHECK(queue.GetRecycledCount() >= RECYCLED_COUNT);
+            MKT_TEST_CHECK(queue.GetSegmentCount() == CountSegmentFiles(directory.Path));
+            MKT_TEST_CHECK(CountSegmentFiles(directory.Path) + queue.GetRecycledCount() == started);
+            MKT_TEST_CHECK(queue.Recover().empty());
+        }
+
+        // Recycled segments keep no record of their previous use
+        {
+            PersistentEventQueue queue{ directory.Path, spec };
+            MKT_TEST_CHECK(queue.Recover().empty());
+
+            AppendSequence(queue, 0, EVENTS_PER_ROUND);
+        }
+
+        PersistentEventQueue queue{ directory.Path, spec };
+        MKT_TEST_CHECK(IsSequence(queue.Recover(), 0, EVENTS_PER_ROUND));
+    }
+}
+
+int main() {
+    // First, forks before any thread exists
+    CheckUncleanExit();
+    CheckTornConsumerSlot();
+    CheckSegmentRecycling();
+
+    return MKT_TEST_EXIT_CODE();
+}
@@ -0,0 +1,99 @@
+/**
+ * RegistryStressTest.cc
+ *
+ * Writer threads subscribe and unsubscribe by type, category and window while
+ * the main thread dispatches. Meant to be run under ThreadSanitizer
+ * as well, see EVENT_SYSTEM_SANITIZER in CMakeLists.txt.
+ * */
+
+// C++ Standard Library
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+#include <CoreEvents.hh>
+#include <EventManager.hh>
+#include <TestCheck.hh>
+
+namespace {
+    constexpr Mikoto::UInt32_T WRITER_COUNT{ 4 };
+    constexpr Mikoto::UInt32_T WRITES_PER_WRITER{ 2000 };
+
+    // Subscribed for the whole test, sees every event
+    constexpr Mikoto::UInt64_T PERMANENT_SUBSCRIBER{ 1 };
+
+    constexpr Mikoto::UInt64_T WRITER_SUBSCRIBER_BASE{ 1'000 };
+    constexpr Mikoto::UInt64_T WRITER_SUBSCRIBER_STRIDE{ 1'000'000 };
+    constexpr Mikoto::WindowId_T WRITER_WINDOW{ 3 };
+}
+
+int main() {
+    using namespace Mikoto;
+
+    // Handlers only run on this thread, plain counters are enough
+    UInt64_T permanentRuns{};
+    UInt64_T writerRuns{};
+
+    EventManager::Subscribe(PERMANENT_SUBSCRIBER, EventType::KEY_CHAR_EVENT, [&](Event&) -> bool { ++permanentRuns; return false; });
+
+    std::atomic<UInt32_T> finishedWriters{};
+    std::vector<std::thread> writers{};
+
+    for (UInt32_T writer{}; writer < WRITER_COUNT; ++writer) {
+        writers.emplace_back([&, writer]() -> void {
+            for (UInt64_T index{}; index < WRITES_PER_WRITER; ++index) {
+                const UInt64_T subId{ WRITER_SUBSCRIBER_BASE + writer * WRITER_SUBSCRIBER_STRIDE + index };
+
+                // Every subscriber ends with one type handler left for odd indices, none for even ones
+                EventManager::Subscribe(subId, EventType::KEY_CHAR_EVENT, [&](Event&) -> bool { ++writerRuns; return false; });
+                EventManager::Subscribe(subId, INPUT_EVENT_CATEGORY, [&](Event&) -> bool { return false; });
+                EventManager::SubscribeWindow(subId, WRITER_WINDOW, EventType::KEY_CHAR_EVENT, [&](Event&) -> bool { return false; });
+
+                EventManager::Unsubscribe(subId, INPUT_EVENT_CATEGORY);
+                EventManager::UnsubscribeWindow(subId, WRITER_WINDOW);
+
+                if (index % 2 == 0) {
+                    EventManager::Unsubscribe(subId, EventType::KEY_CHAR_EVENT);
+                }
+
+                if (index % 64 == 0) {
+                    std::this_thread::yield();
+                }
+            }
+
+            finishedWriters.fetch_add(1);
+        });
+    }
+
+    UInt64_T triggered{};
+
+    while (finishedWriters.load() < WRITER_COUNT) {
+        for (UInt32_T index{}; index < 8; ++index) {
+            EventManager::Trigger<KeyCharEvent>(65u);
+            ++triggered;
+        }
+
+        EventManager::ProcessEvents();
+    }
+
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    MKT_TEST_CHECK(permanentRuns == triggered);
+
+    // Only the odd subscribers of every writer are left, with a single handler each
+    writerRuns = 0;
+    EventManager::Trigger<KeyCharEvent>(65u);
+    EventManager::ProcessEvents();
+
+    MKT_TEST_CHECK(writerRuns == WRITER_COUNT * WRITES_PER_WRITER / 2);
+    MKT_TEST_CHECK(permanentRuns == triggered + 1);
+
+    EventManager::Shutdown();
+
+    return MKT_TEST_EXIT_CODE();
+}
@@ -0,0 +1,136 @@
+/**
+ * SharedMemoryBridgeTest.cc
+ *
+ * Events dispatched to a SharedMemoryBridge are polled by a reader in the order they were
+ * triggered. A reader falling more than a ring behind gets the newest SlotCount events and
+ * counts the rest as lost, and a second producer for the same object is refused.
+ * */
+
+// C++ Standard Library
+#include <array>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+// POSIX
+#include <unistd.h>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+#include <CoreEvents.hh>
+#include <EventCodec.hh>
+#include <EventManager.hh>
+#include <SharedMemoryBridge.hh>
+#include <TestCheck.hh>
+
+namespace {
+    using namespace Mikoto;
+
+    constexpr UInt64_T BRIDGE_SUBSCRIBER{ 1 };
+    constexpr UInt32_T SLOT_COUNT{ 16 };
+
+    constexpr std::array BRIDGED_TYPES{ EventType::KEY_CHAR_EVENT };
+
+    /**
+     * Triggers key chars numbered from first on and dispatches them to the bridge
+     * */
+    auto TriggerSequence(UInt32_T first, UInt32_T count) -> void {
+        for (UInt32_T index{}; index < count; ++index) {
+            EventManager::Trigger<KeyCharEvent>(first + index);
+        }
+
+        EventManager::ProcessEvents();
+    }
+
+    /**
+     * Returns the key chars polled from the reader, records that do not decode are left out
+     * */
+    auto PollChars(SharedMemoryReader& reader) -> std::vector<UInt32_T> {
+        std::vector<UInt32_T> result{};
+
+        (void)reader.Poll([&result](std::span<const std::byte> record) -> void {
+            const auto event{ EventCodec::Decode(record) };
+
+            if (event && event->GetType() == EventType::KEY_CHAR_EVENT) {
+                result.push_back(static_cast<const KeyCharEvent&>(*event).GetChar());
+            }
+        });
+
+        return result;
+    }
+
+    auto IsSequence(const std::vector<UInt32_T>& chars, UInt32_T first, UInt32_T count) -> bool {
+        if (chars.size() != count) {
+            return false;
+        }
+
+        for (UInt32_T index{}; index < count; ++index) {
+            if (chars[index] != first + index) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main() {
+    const std::string name{ fmt::format("/mikoto-bridge-test-{}", getpid()) };
+
+    {
+        SharedMemoryBridge bridge{ name, BRIDGE_SUBSCRIBER, BRIDGED_TYPES, SLOT_COUNT };
+        SharedMemoryReader reader{ name };
+
+        // In order, and nothing twice
+        TriggerSequence(0, SLOT_COUNT / 2);
+        MKT_TEST_CHECK(IsSequence(PollChars(reader), 0, SLOT_COUNT / 2));
+        MKT_TEST_CHECK(PollChars(reader).empty());
+        MKT_TEST_CHECK(reader.GetLostCount() == 0);
+
+        // Events of other types are not bridged
+        EventManager::Trigger<MouseMovedEvent>(1.0, 2.0);
+        EventManager::ProcessEvents();
+        MKT_TEST_CHECK(PollChars(reader).empty());
+
+        // More than a ring behind, only the newest ring is left
+        constexpr UInt32_T OVERRUN_COUNT{ SLOT_COUNT * 3 + 5 };
+        TriggerSequence(SLOT_COUNT, OVERRUN_COUNT);
+
+        MKT_TEST_CHECK(IsSequence(PollChars(reader), OVERRUN_COUNT, SLOT_COUNT));
+        MKT_TEST_CHECK(reader.GetLostCount() == OVERRUN_COUNT - SLOT_COUNT);
+        MKT_TEST_CHECK(bridge.GetWrittenCount() == SLOT_COUNT / 2 + OVERRUN_COUNT);
+
+        // Caught up, reading goes on normally
+        TriggerSequence(1'000, 3);
+        MKT_TEST_CHECK(IsSequence(PollChars(reader), 1'000, 3));
+        MKT_TEST_CHECK(reader.GetLostCount() == OVERRUN_COUNT - SLOT_COUNT);
+
+        // One producer per ring
+        bool refused{};
+
+        try {
+            SharedMemoryBridge second{ name, BRIDGE_SUBSCRIBER + 1, BRIDGED_TYPES, SLOT_COUNT };
+        }
+        catch (const std::runtime_error&) {
+            refused = true;
+        }
+
+        MKT_TEST_CHECK(refused);
+
+        // The refused producer did not touch the ring
+        TriggerSequence(2'000, 2);
+        MKT_TEST_CHECK(IsSequence(PollChars(reader), 2'000, 2));
+    }
+
+    // Removed with its producer, the name can be used again
+    {
+        SharedMemoryBridge bridge{ name, BRIDGE_SUBSCRIBER, BRIDGED_TYPES, SLOT_COUNT };
+        SharedMemoryReader reader{ name };
+
+        TriggerSequence(0, 1);
+        MKT_TEST_CHECK(IsSequence(PollChars(reader), 0, 1));
+    }
+
+    return MKT_TEST_EXIT_CODE();
+}
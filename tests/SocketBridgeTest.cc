@@ -0,0 +1,257 @@
+/**
+ * SocketBridgeTest.cc
+ *
+ * A client connected to a SocketBridge gets the events of an Update() pass as whole
+ * length-prefixed frames, and the frames it sends are queued as events. A client which
+ * never reads has whole passes dropped and counted, and one sending a frame with a
+ * length out of the protocol is disconnected.
+ * */
+
+// C++ Standard Library
+#include <array>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+// POSIX
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/socket.h>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+#include <CoreEvents.hh>
+#include <EventCodec.hh>
+#include <EventManager.hh>
+#include <SocketBridge.hh>
+#include <TestCheck.hh>
+
+namespace {
+    using namespace Mikoto;
+
+    constexpr UInt64_T BRIDGE_SUBSCRIBER{ 1 };
+    constexpr UInt64_T INJECTED_SUBSCRIBER{ 2 };
+
+    constexpr std::array BRIDGED_TYPES{ EventType::KEY_CHAR_EVENT };
+
+    constexpr UInt32_T PASS_SIZE{ 32 };
+    constexpr Size_T MAX_CLIENT_BUFFER{ 4096 };
+
+    auto Connect(const std::string& path) -> Int32_T {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::copy(path.begin(), path.end(), address.sun_path);
+
+        const Int32_T descriptor{ socket(AF_UNIX, SOCK_STREAM, 0) };
+        MKT_TEST_CHECK(descriptor != -1);
+        MKT_TEST_CHECK(connect(descriptor, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+
+        return descriptor;
+    }
+
+    /**
+     * Reads whatever the bridge sent so far without waiting
+     * @returns false if the bridge closed the connection
+     * */
+    auto ReadAvailable(Int32_T descriptor, std::vector<std::byte>& input) -> bool {
+        std::array<std::byte, 4096> buffer{};
+
+        while (true) {
+            const ssize_t count{ recv(descriptor, buffer.data(), buffer.size(), MSG_DONTWAIT) };
+
+            if (count == 0) {
+                return false;
+            }
+
+            if (count == -1) {
+                return true;
+            }
+
+            input.insert(input.end(), buffer.begin(), buffer.begin() + count);
+        }
+    }
+
+    /**
+     * Splits the bytes in frames and decodes the key chars they hold
+     * @returns false if the bytes do not end with a whole frame, or a frame is not a key char
+     * */
+    auto ParseFrames(const std::vector<std::byte>& input, std::vector<UInt32_T>& chars) -> bool {
+        Size_T offset{};
+
+        while (input.size() - offset >= SocketBridge::FRAME_LENGTH_SIZE) {
+            EventCodec::LittleEndian<UInt32_T> encodedLength{};
+            std::memcpy(&encodedLength, input.data() + offset, SocketBridge::FRAME_LENGTH_SIZE);
+
+            const Size_T length{ encodedLength.Get() };
+            offset += SocketBridge::FRAME_LENGTH_SIZE;
+
+            if (input.size() - offset < length) {
+                return false;
+            }
+
+            alignas(EventCodec::RECORD_ALIGNMENT) std::array<std::byte, EventCodec::MAX_WIRE_SIZE> record{};
+            std::memcpy(record.data(), input.data() + offset, std::min(length, record.size()));
+
+            const auto event{ EventCodec::Decode(std::span{ record }.first(std::min(length, record.size()))) };
+
+            if (!event || event->GetType() != EventType::KEY_CHAR_EVENT) {
+                return false;
+            }
+
+            chars.push_back(static_cast<const KeyCharEvent&>(*event).GetChar());
+            offset += length;
+        }
+
+        return offset == input.size();
+    }
+
+    /**
+     * Triggers key chars numbered from first on, dispatches them and runs a bridge pass
+     * */
+    auto RunPass(SocketBridge& bridge, UInt32_T first, UInt32_T count) -> void {
+        for (UInt32_T index{}; index < count; ++index) {
+            EventManager::Trigger<KeyCharEvent>(first + index);
+        }
+
+        EventManager::ProcessEvents();
+        bridge.Update();
+    }
+
+    auto SendFrame(Int32_T descriptor, std::span<const std::byte> bytes) -> void {
+        MKT_TEST_CHECK(send(descriptor, bytes.data(), bytes.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(bytes.size()));
+    }
+
+    auto CheckClient(SocketBridge& bridge, const std::string& path) -> void {
+        const Int32_T client{ Connect(path) };
+
+        bridge.Update();
+        MKT_TEST_CHECK(bridge.GetClientCount() == 1);
+
+        // One pass, whole frames in order
+        RunPass(bridge, 0, PASS_SIZE);
+
+        std::vector<std::byte> input{};
+        std::vector<UInt32_T> chars{};
+
+        MKT_TEST_CHECK(ReadAvailable(client, input));
+        MKT_TEST_CHECK(ParseFrames(input, chars));
+        MKT_TEST_CHECK(chars.size() == PASS_SIZE);
+
+        for (UInt32_T index{}; index < chars.size(); ++index) {
+            MKT_TEST_CHECK(chars[index] == index);
+        }
+
+        MKT_TEST_CHECK(bridge.GetClientStats().front().SentFrames == PASS_SIZE);
+
+        // A frame sent by the client, split over two passes, is queued once whole
+        std::vector<Int32_T> injected{};
+        EventManager::Subscribe(INJECTED_SUBSCRIBER, EventType::KEY_PRESSED_EVENT, [&injected](Event& event) -> bool {
+            injected.push_back(static_cast<KeyPressedEvent&>(event).GetKeyCode());
+            return false;
+        });
+
+        alignas(EventCodec::RECORD_ALIGNMENT) std::array<std::byte, SocketBridge::FRAME_LENGTH_SIZE + EventCodec::MAX_WIRE_SIZE> frame{};
+        KeyPressedEvent pressed{ 65, false };
+
+        alignas(EventCodec::RECORD_ALIGNMENT) std::array<std::byte, EventCodec::MAX_WIRE_SIZE> record{};
+        const auto size{ EventCodec::Encode(pressed, record) };
+        MKT_TEST_CHECK(size > 0);
+
+        EventCodec::LittleEndian<UInt32_T> length{};
+        length.Set(static_cast<UInt32_T>(size));
+        std::memcpy(frame.data(), &length, SocketBridge::FRAME_LENGTH_SIZE);
+        std::memcpy(frame.data() + SocketBridge::FRAME_LENGTH_SIZE, record.data(), size);
+
+        const auto whole{ std::span{ frame }.first(SocketBridge::FRAME_LENGTH_SIZE + size) };
+
+        SendFrame(client, whole.first(SocketBridge::FRAME_LENGTH_SIZE + 2));
+        bridge.Update();
+        EventManager::ProcessEvents();
+        MKT_TEST_CHECK(injected.empty());
+
+        SendFrame(client, whole.subspan(SocketBridge::FRAME_LENGTH_SIZE + 2));
+        bridge.Update();
+        EventManager::ProcessEvents();
+
+        MKT_TEST_CHECK(injected == std::vector<Int32_T>{ 65 });
+        MKT_TEST_CHECK(bridge.GetClientStats().front().InjectedEvents == 1);
+
+        EventManager::Unsubscribe(INJECTED_SUBSCRIBER, EventType::KEY_PRESSED_EVENT);
+
+        // A length no event has, the client is not speaking the protocol
+        length.Set(1);
+        SendFrame(client, { reinterpret_cast<const std::byte*>(&length), SocketBridge::FRAME_LENGTH_SIZE });
+        bridge.Update();
+
+        MKT_TEST_CHECK(bridge.GetClientCount() == 0);
+
+        input.clear();
+        MKT_TEST_CHECK(!ReadAvailable(client, input));
+
+        close(client);
+    }
+
+    auto CheckSlowClient(SocketBridge& bridge, const std::string& path) -> void {
+        const Int32_T client{ Connect(path) };
+
+        bridge.Update();
+        MKT_TEST_CHECK(bridge.GetClientCount() == 1);
+
+        // Passes until the socket and the bridge buffer are both full
+        constexpr UInt32_T MAX_PASSES{ 100'000 };
+        UInt32_T passes{};
+
+        while (passes < MAX_PASSES && bridge.GetClientStats().front().DroppedFrames < PASS_SIZE * 4) {
+            RunPass(bridge, passes * PASS_SIZE, PASS_SIZE);
+            ++passes;
+        }
+
+        const auto stats{ bridge.GetClientStats().front() };
+
+        MKT_TEST_CHECK(stats.DroppedFrames >= PASS_SIZE * 4);
+        MKT_TEST_CHECK(stats.DroppedFrames % PASS_SIZE == 0);
+        MKT_TEST_CHECK(stats.SentFrames + stats.DroppedFrames == UInt64_T{ passes } * PASS_SIZE);
+        MKT_TEST_CHECK(stats.BufferedBytes <= MAX_CLIENT_BUFFER);
+
+        // Once the client reads, it gets every frame sent and only whole passes
+        std::vector<std::byte> input{};
+
+        do {
+            MKT_TEST_CHECK(ReadAvailable(client, input));
+            bridge.Update();
+        } while (bridge.GetClientStats().front().BufferedBytes > 0);
+
+        MKT_TEST_CHECK(ReadAvailable(client, input));
+
+        std::vector<UInt32_T> chars{};
+        MKT_TEST_CHECK(ParseFrames(input, chars));
+        MKT_TEST_CHECK(chars.size() == stats.SentFrames);
+
+        for (Size_T index{}; index < chars.size(); ++index) {
+            const bool passStart{ index % PASS_SIZE == 0 };
+
+            MKT_TEST_CHECK(passStart ? chars[index] % PASS_SIZE == 0 : chars[index] == chars[index - 1] + 1);
+            MKT_TEST_CHECK(index == 0 || chars[index] > chars[index - 1]);
+        }
+
+        close(client);
+    }
+}
+
+int main() {
+    const auto path{ (std::filesystem::temp_directory_path() / fmt::format("SocketBridgeTest-{}.sock", getpid())).string() };
+
+    {
+        SocketBridge bridge{ path, BRIDGE_SUBSCRIBER, BRIDGED_TYPES, MAX_CLIENT_BUFFER };
+
+        CheckClient(bridge, path);
+        CheckSlowClient(bridge, path);
+    }
+
+    MKT_TEST_CHECK(!std::filesystem::exists(path));
+
+    return MKT_TEST_EXIT_CODE();
+}
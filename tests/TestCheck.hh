@@ -0,0 +1,30 @@
+/**
+ * TestCheck.hh
+ * */
+
+#ifndef EVENT_SYSTEM_TEST_CHECK_HH
+#define EVENT_SYSTEM_TEST_CHECK_HH
+
+// C++ Standard Library
+#include <atomic>
+#include <cstdio>
+
+/**
+ * Reports the condition when it does not hold, the test keeps going
+ * and exits with a failure code, see MKT_TEST_EXIT_CODE()
+ * */
+#define MKT_TEST_CHECK(condition)                                                                  \
+    do {                                                                                           \
+        if (!(condition)) {                                                                        \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);    \
+            Mikoto::Test::s_Failures.fetch_add(1, std::memory_order_relaxed);                      \
+        }                                                                                          \
+    } while (false)
+
+#define MKT_TEST_EXIT_CODE() (Mikoto::Test::s_Failures.load() == 0 ? 0 : 1)
+
+namespace Mikoto::Test {
+    inline std::atomic<int> s_Failures{};
+}
+
+#endif // EVENT_SYSTEM_TEST_CHECK_HH
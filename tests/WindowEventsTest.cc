@@ -0,0 +1,154 @@
+/**
+ * WindowEventsTest.cc
+ *
+ * Window ids end to end: sticky events kept per window and replayed to the matching
+ * handlers, a released window leaving no handler nor sticky event behind for the next
+ * owner of its id, and the id surviving EventCodec records and EventLog files, with
+ * records of the previous codec version still read.
+ * */
+
+// C++ Standard Library
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+#include <CoreEvents.hh>
+#include <EventCodec.hh>
+#include <EventLog.hh>
+#include <EventManager.hh>
+#include <TestCheck.hh>
+
+namespace {
+    using namespace Mikoto;
+    using namespace Mikoto::EventManager;
+
+    constexpr UInt64_T WINDOW_SUBSCRIBER{ 1 };
+    constexpr UInt64_T ANY_SUBSCRIBER{ 2 };
+
+    constexpr WindowId_T FIRST_WINDOW{ 1 };
+    constexpr WindowId_T SECOND_WINDOW{ 2 };
+
+    auto CheckStickyWindows() -> void {
+        EventBus bus{};
+        bus.SetSticky<WindowResizedEvent>();
+
+        bus.SeedStickyWindow<WindowResizedEvent>(FIRST_WINDOW, 100, 10);
+        bus.SeedStickyWindow<WindowResizedEvent>(SECOND_WINDOW, 200, 20);
+
+        // Seeding the second window keeps the state of the first
+        MKT_TEST_CHECK(bus.LatestWindow<WindowResizedEvent>(FIRST_WINDOW) && bus.LatestWindow<WindowResizedEvent>(FIRST_WINDOW)->GetWidth() == 100);
+        MKT_TEST_CHECK(bus.LatestWindow<WindowResizedEvent>(SECOND_WINDOW) && bus.LatestWindow<WindowResizedEvent>(SECOND_WINDOW)->GetWidth() == 200);
+        MKT_TEST_CHECK(bus.Latest<WindowResizedEvent>() && bus.Latest<WindowResizedEvent>()->GetWidth() == 200);
+
+        std::vector<Int32_T> windowWidths{};
+        std::vector<Int32_T> anyWidths{};
+
+        bus.SubscribeWindow(WINDOW_SUBSCRIBER, FIRST_WINDOW, EventType::WINDOW_RESIZE_EVENT, [&windowWidths](Event& event) -> bool {
+            windowWidths.push_back(static_cast<WindowResizedEvent&>(event).GetWidth());
+            return false;
+        });
+
+        bus.Subscribe(ANY_SUBSCRIBER, EventType::WINDOW_RESIZE_EVENT, [&anyWidths](Event& event) -> bool {
+            anyWidths.push_back(static_cast<WindowResizedEvent&>(event).GetWidth());
+            return false;
+        });
+
+        // The window handler gets its own window, the other one the state of each window
+        MKT_TEST_CHECK(windowWidths == std::vector<Int32_T>{ 100 });
+        MKT_TEST_CHECK((anyWidths == std::vector<Int32_T>{ 100, 200 }));
+
+        bus.ReleaseWindow(FIRST_WINDOW);
+
+        MKT_TEST_CHECK(bus.LatestWindow<WindowResizedEvent>(FIRST_WINDOW) == nullptr);
+        MKT_TEST_CHECK(bus.LatestWindow<WindowResizedEvent>(SECOND_WINDOW) != nullptr);
+
+        // The next window given the id sees neither the old handler nor the old size
+        windowWidths.clear();
+        anyWidths.clear();
+
+        bus.TriggerWindow<WindowResizedEvent>(FIRST_WINDOW, 300, 30);
+        bus.ProcessEvents();
+
+        MKT_TEST_CHECK(windowWidths.empty());
+        MKT_TEST_CHECK(anyWidths == std::vector<Int32_T>{ 300 });
+
+        std::vector<Int32_T> reusedWidths{};
+        bus.ReleaseWindow(FIRST_WINDOW);
+
+        bus.SubscribeWindow(WINDOW_SUBSCRIBER, FIRST_WINDOW, EventType::WINDOW_RESIZE_EVENT, [&reusedWidths](Event& event) -> bool {
+            reusedWidths.push_back(static_cast<WindowResizedEvent&>(event).GetWidth());
+            return false;
+        });
+
+        MKT_TEST_CHECK(reusedWidths.empty());
+
+        // Releasing no window keeps the handlers of every window
+        bus.ReleaseWindow(ANY_WINDOW_ID);
+        bus.TriggerWindow<WindowResizedEvent>(SECOND_WINDOW, 400, 40);
+        bus.ProcessEvents();
+
+        MKT_TEST_CHECK((anyWidths == std::vector<Int32_T>{ 300, 400 }));
+    }
+
+    auto CheckCodecWindow() -> void {
+        alignas(EventCodec::RECORD_ALIGNMENT) std::array<std::byte, EventCodec::MAX_WIRE_SIZE> record{};
+
+        KeyPressedEvent event{ 65, 0, 1 };
+        event.SetWindowId(SECOND_WINDOW);
+        event.SetHandled(true);
+
+        const auto size{ EventCodec::Encode(event, record) };
+        MKT_TEST_CHECK(size > 0);
+
+        const auto decoded{ EventCodec::Decode(std::span{ record }.first(size)) };
+        MKT_TEST_CHECK(decoded && decoded->GetWindowId() == SECOND_WINDOW && decoded->IsHandled());
+
+        const auto* header{ EventCodec::PeekHeader(std::span{ record }.first(size)) };
+        MKT_TEST_CHECK(header && header->GetWindowId() == SECOND_WINDOW);
+
+        // A version 1 record, no window id in its flags, reads as coming from no window
+        auto* writable{ reinterpret_cast<EventCodec::WireHeader*>(record.data()) };
+        writable->Version = 1;
+        writable->Flags = EventCodec::WIRE_HANDLED_FLAG;
+
+        const auto old{ EventCodec::Decode(std::span{ record }.first(size)) };
+        MKT_TEST_CHECK(old && old->GetWindowId() == ANY_WINDOW_ID && old->IsHandled());
+    }
+
+    auto CheckLogWindow() -> void {
+        const auto path{ std::filesystem::temp_directory_path() / "WindowEventsTest.mktlog" };
+
+        {
+            EventLogWriter writer{ path };
+
+            MouseMovedEvent moved{ 10.0, 20.0 };
+            moved.SetWindowId(SECOND_WINDOW);
+            MKT_TEST_CHECK(writer.Append(moved));
+
+            KeyCharEvent typed{ 65u };
+            MKT_TEST_CHECK(writer.Append(typed));
+        }
+
+        EventLogReader reader{ path };
+
+        const auto moved{ reader.Next() };
+        MKT_TEST_CHECK(moved && moved->GetWindowId() == SECOND_WINDOW);
+
+        const auto typed{ reader.Next() };
+        MKT_TEST_CHECK(typed && typed->GetWindowId() == ANY_WINDOW_ID);
+
+        std::filesystem::remove(path);
+    }
+}
+
+int main() {
+    CheckStickyWindows();
+    CheckCodecWindow();
+    CheckLogWindow();
+
+    return MKT_TEST_EXIT_CODE();
+}
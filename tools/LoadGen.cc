@@ -0,0 +1,932 @@
+/**
+ * LoadGen.cc
+ * Created by kate on 10/19/26.
+ *
+ * Synthetic load generator for the event system. Drives EventManager with a configurable
+ * workload and reports throughput, dispatch latency percentiles, allocations and peak RSS.
+ *
+ * Usage: Event_System_LoadGen [--option=value]...
+ *   --workload=dispatch|codec|registry|layout|replay|queue  what to measure (dispatch). The registry workload has
+ *                                 writer threads changing subscriptions while the main thread dispatches,
+ *                                 the layout one compares the subscriber map with the node based one,
+ *                                 the replay one runs a ReplaySession and compares it with a baseline,
+ *                                 the queue one appends to a PersistentEventQueue committed every frame
+ *   --writers=N                   registry workload, threads changing subscriptions (4)
+ *   --writes=N                    registry workload, subscribe/unsubscribe pairs per writer (100000)
+ *   --population=N                layout workload, subscribers with one to three handlers each (100000)
+ *   --frames=N                    ProcessEvents() calls (1000)
+ *   --events=N                    events per frame (1000)
+ *   --mix=TYPE:WEIGHT,...         event type mix, types as printed by GetEventFormattedStr()
+ *                                 (MOUSE_MOVED_EVENT:6,KEY_PRESSED_EVENT:1,KEY_RELEASED_EVENT:1,
+ *                                  MOUSE_BUTTON_PRESSED_EVENT:1,MOUSE_SCROLLED_EVENT:1)
+ *   --producers=N                 threads producing the events, 0 produces on the main thread (0).
+ *                                 Producers are not paced, latency then includes queueing
+ *   --queue=mutex|batched         how producers hand events over: a shared mutex guarded queue,
+ *                                 or EventManager::QueueEventAsync() batches flushed every frame (batched)
+ *   --subscribers=N               distinct subscriber ids (8)
+ *   --fanout=N                    handlers per event type (2)
+ *   --dispatch=type|category|batch  how handlers subscribe (type)
+ *   --handler-ns=N                busy time spent in every handler call (0)
+ *   --churn=N                     subscribe/unsubscribe pairs per frame (0)
+ *   --burst-every=N               every Nth frame is a burst (0, no bursts)
+ *   --burst-factor=N              events of a burst frame relative to a normal one (10)
+ *   --seed=N                      seed of the event generator (1)
+ *   --baseline=PATH               replay workload, baseline to compare with. Exits with 2 when the
+ *                                 dispatch trace differs or the median frame time regressed
+ *   --save-baseline=PATH          replay workload, writes the result of the run as a baseline
+ *   --tolerance=PERCENT           replay workload, slowdown allowed over the baseline (20)
+ *
+ * Replay regression check, record once and compare on every change:
+ *   Event_System_LoadGen --workload=replay --frames=2000 --events=200 --save-baseline=replay.base
+ *   Event_System_LoadGen --workload=replay --frames=2000 --events=200 --baseline=replay.base
+ * */
+
+// C++ Standard Library
+#include <span>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <utility>
+#include <charconv>
+#include <algorithm>
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
+
+// POSIX
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sys/resource.h>
+#endif
+
+// Project Headers
+#include <Common.hh>
+#include <Event.hh>
+#include <CoreEvents.hh>
+#include <EventCodec.hh>
+#include <EventLog.hh>
+#include <EventManager.hh>
+#include <EventReplay.hh>
+#include <PersistentEventQueue.hh>
+
+namespace {
+    // Allocations are counted per thread so producers do not share a counter,
+    // producer counts are added to the totals when their thread ends
+    struct AllocationCounts {
+        std::uint64_t Count{};
+        std::uint64_t Bytes{};
+
+        // Bytes allocated minus bytes freed by this thread
+        std::int64_t Live{};
+    };
+
+    thread_local AllocationCounts t_Allocations{};
+    std::atomic<std::uint64_t> s_FinishedThreadAllocations{};
+    std::atomic<std::uint64_t> s_FinishedThreadAllocatedBytes{};
+
+    // Every block starts with its size so frees can be counted as well
+    constexpr std::size_t ALLOCATION_HEADER_SIZE{ alignof(std::max_align_t) };
+
+    auto FreeCounted(void* memory) noexcept -> void {
+        if (!memory) {
+            return;
+        }
+
+        auto* block{ static_cast<std::byte*>(memory) - ALLOCATION_HEADER_SIZE };
+
+        std::size_t size{};
+        std::memcpy(&size, block, sizeof(size));
+        t_Allocations.Live -= static_cast<std::int64_t>(size);
+
+        std::free(block);
+    }
+}
+
+auto operator new(std::size_t size) -> void* {
+    ++t_Allocations.Count;
+    t_Allocations.Bytes += size;
+    t_Allocations.Live += static_cast<std::int64_t>(size);
+
+    if (auto* block{ static_cast<std::byte*>(std::malloc(size + ALLOCATION_HEADER_SIZE)) }) {
+        std::memcpy(block, &size, sizeof(size));
+        return block + ALLOCATION_HEADER_SIZE;
+    }
+
+    throw std::bad_alloc{};
+}
+
+auto operator delete(void* memory) noexcept -> void { FreeCounted(memory); }
+auto operator delete(void* memory, std::size_t) noexcept -> void { FreeCounted(memory); }
+
+namespace Mikoto {
+    enum class Workload { DISPATCH, CODEC, REGISTRY, LAYOUT, REPLAY, QUEUE };
+    enum class DispatchMode { TYPE, CATEGORY, BATCH };
+    enum class ProducerQueue { MUTEX, BATCHED };
+
+    struct LoadSpec {
+        Workload Mode{ Workload::DISPATCH };
+        UInt64_T Frames{ 1000 };
+        UInt32_T EventsPerFrame{ 1000 };
+        std::vector<std::pair<EventType, UInt32_T>> Mix{};
+        UInt32_T Producers{ 0 };
+        ProducerQueue Queue{ ProducerQueue::BATCHED };
+        UInt32_T Subscribers{ 8 };
+        UInt32_T FanOut{ 2 };
+        DispatchMode Dispatch{ DispatchMode::TYPE };
+        std::chrono::nanoseconds HandlerCost{ 0 };
+        UInt32_T Churn{ 0 };
+        UInt32_T BurstEvery{ 0 };
+        UInt32_T BurstFactor{ 10 };
+        UInt64_T Seed{ 1 };
+        UInt32_T Writers{ 4 };
+        UInt64_T Writes{ 100'000 };
+        UInt64_T Population{ 100'000 };
+        Path_T Baseline{};
+        Path_T SaveBaseline{};
+        UInt32_T Tolerance{ 20 };
+    };
+
+    // Types the generator knows how to create
+    static constexpr std::array GENERATED_TYPES{
+        EventType::KEY_PRESSED_EVENT, EventType::KEY_RELEASED_EVENT, EventType::KEY_CHAR_EVENT,
+        EventType::MOUSE_BUTTON_PRESSED_EVENT, EventType::MOUSE_BUTTON_RELEASED_EVENT,
+        EventType::MOUSE_MOVED_EVENT, EventType::MOUSE_SCROLLED_EVENT,
+    };
+
+    static auto ParseType(std::string_view name) -> EventType {
+        for (const auto type : GENERATED_TYPES) {
+            if (GetEventFormattedStr(type) == name) {
+                return type;
+            }
+        }
+
+        MKT_THROW_RUNTIME_ERROR(fmt::format("Unknown or unsupported event type {}", name));
+    }
+
+    static auto ParseNumber(std::string_view option, std::string_view value) -> UInt64_T {
+        UInt64_T result{};
+
+        if (auto [last, error]{ std::from_chars(value.data(), value.data() + value.size(), result) }; error != std::errc{} || last != value.data() + value.size()) {
+            MKT_THROW_RUNTIME_ERROR(fmt::format("Option {} expects a number, got {}", option, value));
+        }
+
+        return result;
+    }
+
+    /**
+     * Returns the choice named by the value, throws for names not in the list
+     * */
+    template<typename ValueType, Size_T COUNT>
+    static auto ParseChoice(std::string_view option, std::string_view value, const std::array<std::pair<std::string_view, ValueType>, COUNT>& choices) -> ValueType {
+        for (const auto& [name, choice] : choices) {
+            if (name == value) {
+                return choice;
+            }
+        }
+
+        MKT_THROW_RUNTIME_ERROR(fmt::format("Unknown value {} for {}", value, option));
+    }
+
+    static auto ParseMix(std::string_view value) -> std::vector<std::pair<EventType, UInt32_T>> {
+        std::vector<std::pair<EventType, UInt32_T>> mix{};
+
+        while (!value.empty()) {
+            const auto end{ std::min(value.find(','), value.size()) };
+            const auto entry{ value.substr(0, end) };
+            const auto separator{ entry.find(':') };
+
+            if (separator == std::string_view::npos) {
+                MKT_THROW_RUNTIME_ERROR(fmt::format("Mix entry {} is not TYPE:WEIGHT", entry));
+            }
+
+            mix.emplace_back(ParseType(entry.substr(0, separator)), static_cast<UInt32_T>(ParseNumber("--mix", entry.substr(separator + 1))));
+            value.remove_prefix(std::min(end + 1, value.size()));
+        }
+
+        return mix;
+    }
+
+    static auto ParseArguments(std::span<char*> arguments) -> LoadSpec {
+        LoadSpec spec{};
+        spec.Mix = {
+            { EventType::MOUSE_MOVED_EVENT, 6 }, { EventType::KEY_PRESSED_EVENT, 1 }, { EventType::KEY_RELEASED_EVENT, 1 },
+            { EventType::MOUSE_BUTTON_PRESSED_EVENT, 1 }, { EventType::MOUSE_SCROLLED_EVENT, 1 },
+        };
+
+        for (std::string_view argument : arguments) {
+            const auto separator{ argument.find('=') };
+
+            if (!argument.starts_with("--") || separator == std::string_view::npos) {
+                MKT_THROW_RUNTIME_ERROR(fmt::format("Expected --option=value, got {}", argument));
+            }
+
+            const auto option{ argument.substr(0, separator) };
+            const auto value{ argument.substr(separator + 1) };
+
+            if (option == "--workload") {
+                spec.Mode = ParseChoice(option, value, std::array<std::pair<std::string_view, Workload>, 6>{ {
+                    { "dispatch", Workload::DISPATCH }, { "codec", Workload::CODEC }, { "registry", Workload::REGISTRY },
+                    { "layout", Workload::LAYOUT }, { "replay", Workload::REPLAY }, { "queue", Workload::QUEUE },
+                } });
+            }
+            else if (option == "--dispatch") {
+                spec.Dispatch = ParseChoice(option, value, std::array<std::pair<std::string_view, DispatchMode>, 3>{ {
+                    { "type", DispatchMode::TYPE }, { "batch", DispatchMode::BATCH }, { "category", DispatchMode::CATEGORY },
+                } });
+            }
+            else if (option == "--queue") {
+                spec.Queue = ParseChoice(option, value, std::array<std::pair<std::string_view, ProducerQueue>, 2>{ {
+                    { "batched", ProducerQueue::BATCHED }, { "mutex", ProducerQueue::MUTEX },
+                } });
+            }
+            else if (option == "--mix") {
+                spec.Mix = ParseMix(value);
+            }
+            else if (option == "--frames") { spec.Frames = ParseNumber(option, value); }
+            else if (option == "--events") { spec.EventsPerFrame = static_cast<UInt32_T>(ParseNumber(option, value)); }
+            else if (option == "--producers") { spec.Producers = static_cast<UInt32_T>(ParseNumber(option, value)); }
+            else if (option == "--subscribers") { spec.Subscribers = std::max<UInt32_T>(1, static_cast<UInt32_T>(ParseNumber(option, value))); }
+            else if (option == "--fanout") { spec.FanOut = static_cast<UInt32_T>(ParseNumber(option, value)); }
+            else if (option == "--handler-ns") { spec.HandlerCost = std::chrono::nanoseconds{ ParseNumber(option, value) }; }
+            else if (option == "--churn") { spec.Churn = static_cast<UInt32_T>(ParseNumber(option, value)); }
+            else if (option == "--burst-every") { spec.BurstEvery = static_cast<UInt32_T>(ParseNumber(option, value)); }
+            else if (option == "--burst-factor") { spec.BurstFactor = static_cast<UInt32_T>(ParseNumber(option, value)); }
+            else if (option == "--seed") { spec.Seed = ParseNumber(option, value); }
+            else if (option == "--writers") { spec.Writers = static_cast<UInt32_T>(ParseNumber(option, value)); }
+            else if (option == "--writes") { spec.Writes = ParseNumber(option, value); }
+            else if (option == "--population") { spec.Population = ParseNumber(option, value); }
+            else if (option == "--baseline") { spec.Baseline = value; }
+            else if (option == "--save-baseline") { spec.SaveBaseline = value; }
+            else if (option == "--tolerance") { spec.Tolerance = static_cast<UInt32_T>(ParseNumber(option, value)); }
+            else {
+                MKT_THROW_RUNTIME_ERROR(fmt::format("Unknown option {}", option));
+            }
+        }
+
+        if (std::accumulate(spec.Mix.begin(), spec.Mix.end(), UInt64_T{}, [](UInt64_T sum, const auto& entry) -> UInt64_T { return sum + entry.second; }) == 0) {
+            MKT_THROW_RUNTIME_ERROR("The event mix has no weight");
+        }
+
+        return spec;
+    }
+
+    /**
+     * Picks event types following the mix weights and creates events of them
+     * */
+    class EventGenerator {
+    public:
+        explicit EventGenerator(const LoadSpec& spec, UInt64_T stream)
+            :   m_Engine{ spec.Seed * 0x9E3779B97F4A7C15 + stream }
+        {
+            for (const auto& [type, weight] : spec.Mix) {
+                m_Types.insert(m_Types.end(), weight, type);
+            }
+        }
+
+        auto Next() -> std::unique_ptr<Event> {
+            using namespace EventManager;
+
+            const auto value{ m_Engine() };
+            const auto field{ static_cast<Int32_T>((value >> 32) % 128) };
+
+            switch (m_Types[value % m_Types.size()]) {
+                case EventType::KEY_PRESSED_EVENT:           return MakeEvent<KeyPressedEvent>(field, false);
+                case EventType::KEY_RELEASED_EVENT:          return MakeEvent<KeyReleasedEvent>(field);
+                case EventType::KEY_CHAR_EVENT:              return MakeEvent<KeyCharEvent>(static_cast<UInt32_T>(field));
+                case EventType::MOUSE_BUTTON_PRESSED_EVENT:  return MakeEvent<MouseButtonPressedEvent>(field % 3);
+                case EventType::MOUSE_BUTTON_RELEASED_EVENT: return MakeEvent<MouseButtonReleasedEvent>(field % 3);
+                case EventType::MOUSE_SCROLLED_EVENT:        return MakeEvent<MouseScrollEvent>(0.0, field % 2 == 0 ? -1.0 : 1.0);
+                default:                                     return MakeEvent<MouseMovedEvent>(static_cast<double>(field), static_cast<double>(value >> 48));
+            }
+        }
+
+    private:
+        std::mt19937_64 m_Engine{};
+        std::vector<EventType> m_Types{};
+    };
+
+    static auto GetFrameEventCount(const LoadSpec& spec, UInt64_T frame) -> UInt64_T {
+        const bool burst{ spec.BurstEvery != 0 && frame % spec.BurstEvery == 0 };
+        return static_cast<UInt64_T>(spec.EventsPerFrame) * (burst ? spec.BurstFactor : 1);
+    }
+
+    static auto GetPeakResidentBytes() -> UInt64_T {
+#if defined(__unix__) || defined(__APPLE__)
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+
+    #if defined(__APPLE__)
+        return static_cast<UInt64_T>(usage.ru_maxrss);
+    #else
+        return static_cast<UInt64_T>(usage.ru_maxrss) * 1024;
+    #endif
+#else
+        return 0;
+#endif
+    }
+
+    static auto GetAllocationCounts() -> AllocationCounts {
+        return { t_Allocations.Count + s_FinishedThreadAllocations.load(), t_Allocations.Bytes + s_FinishedThreadAllocatedBytes.load() };
+    }
+
+    static auto SpinFor(std::chrono::nanoseconds cost) -> void {
+        if (cost.count() == 0) {
+            return;
+        }
+
+        const auto end{ std::chrono::steady_clock::now() + cost };
+        while (std::chrono::steady_clock::now() < end) {}
+    }
+
+    /**
+     * Collects what the handlers see. Latency is the time between an event being
+     * stamped and its first handler running, in event clock microseconds
+     * */
+    struct DispatchStats {
+        UInt64_T Dispatches{};
+        UInt64_T Events{};
+        std::vector<UInt32_T> Latencies{};
+
+        auto Record(const Event& event, bool first) -> void {
+            ++Dispatches;
+
+            if (first) {
+                ++Events;
+                Latencies.push_back(GetEventTimeStamp() - event.GetTimeStamp());
+            }
+        }
+    };
+
+    static constexpr UInt64_T CHURN_SUBSCRIBER_BASE{ 1'000'000 };
+
+    static auto SubscribeHandlers(const LoadSpec& spec, DispatchStats& stats) -> void {
+        using namespace EventManager;
+
+        const auto cost{ spec.HandlerCost };
+
+        for (UInt32_T index{}; index < spec.FanOut; ++index) {
+            const UInt64_T subId{ index % spec.Subscribers };
+            const bool first{ index == 0 };
+
+            if (spec.Dispatch == DispatchMode::CATEGORY) {
+                Subscribe(subId, INPUT_EVENT_CATEGORY, [&stats, cost, first](Event& event) -> bool { stats.Record(event, first); SpinFor(cost); return false; });
+                continue;
+            }
+
+            if (spec.Dispatch == DispatchMode::TYPE) {
+                for (const auto type : GENERATED_TYPES) {
+                    Subscribe(subId, type, [&stats, cost, first](Event& event) -> bool { stats.Record(event, first); SpinFor(cost); return false; });
+                }
+
+                continue;
+            }
+
+            // One call per type and frame, the handler cost is paid once per batch
+            const auto subscribeBatch{ [&]<typename EventClassType>(EventClassType*) -> void {
+                SubscribeBatch<EventClassType>(subId, [&stats, cost, first](std::span<const EventClassType> events) -> void {
+                    for (const auto& event : events) {
+                        stats.Record(event, first);
+                    }
+
+                    SpinFor(cost);
+                });
+            } };
+
+            subscribeBatch(static_cast<KeyPressedEvent*>(nullptr));
+            subscribeBatch(static_cast<KeyReleasedEvent*>(nullptr));
+            subscribeBatch(static_cast<KeyCharEvent*>(nullptr));
+            subscribeBatch(static_cast<MouseButtonPressedEvent*>(nullptr));
+            subscribeBatch(static_cast<MouseButtonReleasedEvent*>(nullptr));
+            subscribeBatch(static_cast<MouseMovedEvent*>(nullptr));
+            subscribeBatch(static_cast<MouseScrollEvent*>(nullptr));
+        }
+    }
+
+    /**
+     * Events handed over by producer threads, drained by the main thread every frame
+     * */
+    struct StagingQueue {
+        std::mutex Mutex{};
+        std::vector<std::unique_ptr<Event>> Events{};
+    };
+
+    static auto PrintPercentiles(std::vector<UInt32_T>& latencies) -> void {
+        if (latencies.empty()) {
+            return;
+        }
+
+        std::ranges::sort(latencies);
+
+        const auto at{ [&](double percentile) -> UInt32_T {
+            return latencies[std::min(latencies.size() - 1, static_cast<Size_T>(percentile * static_cast<double>(latencies.size())))];
+        } };
+
+        fmt::print("latency us    p50 {}  p90 {}  p99 {}  p99.9 {}  max {}\n", at(0.5), at(0.9), at(0.99), at(0.999), latencies.back());
+    }
+
+    static auto RunDispatch(const LoadSpec& spec) -> void {
+        using namespace EventManager;
+
+        DispatchStats stats{};
+        UInt64_T totalEvents{};
+
+        for (UInt64_T frame{}; frame < spec.Frames; ++frame) {
+            totalEvents += GetFrameEventCount(spec, frame);
+        }
+
+        stats.Latencies.reserve(totalEvents);
+        SubscribeHandlers(spec, stats);
+
+        StagingQueue staging{};
+        std::vector<std::thread> producers{};
+
+        // Events published by the producers, updated once by each producer when it is done
+        std::atomic<UInt64_T> publishedEvents{};
+        std::atomic<Int64_T> producerNanoseconds{};
+
+        std::mt19937_64 churnEngine{ spec.Seed };
+        UInt64_T nextChurnId{ CHURN_SUBSCRIBER_BASE };
+
+        const auto allocationsBefore{ GetAllocationCounts() };
+        const auto start{ std::chrono::steady_clock::now() };
+
+        // Every producer runs through all the frames with its share of each
+        for (UInt32_T producer{}; producer < spec.Producers; ++producer) {
+            producers.emplace_back([&, producer]() -> void {
+                EventGenerator generator{ spec, producer + 1 };
+                UInt64_T produced{};
+
+                const auto producerStart{ std::chrono::steady_clock::now() };
+
+                for (UInt64_T frame{}; frame < spec.Frames; ++frame) {
+                    const UInt64_T count{ GetFrameEventCount(spec, frame) };
+                    const UInt64_T share{ count / spec.Producers + (producer < count % spec.Producers) };
+
+                    for (UInt64_T index{}; index < share; ++index) {
+                        if (spec.Queue == ProducerQueue::BATCHED) {
+                            QueueEventAsync(generator.Next());
+                            continue;
+                        }
+
+                        auto event{ generator.Next() };
+
+                        std::scoped_lock lock{ staging.Mutex };
+                        staging.Events.push_back(std::move(event));
+                    }
+
+                    if (spec.Queue == ProducerQueue::BATCHED) {
+                        FlushAsyncEvents();
+                    }
+
+                    produced += share;
+                }
+
+                // Slowest producer wins, another one may be storing its time at once
+                const Int64_T elapsed{ std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - producerStart).count() };
+                for (auto slowest{ producerNanoseconds.load() }; slowest < elapsed && !producerNanoseconds.compare_exchange_weak(slowest, elapsed);) {}
+
+                publishedEvents += produced;
+
+                s_FinishedThreadAllocations += t_Allocations.Count;
+                s_FinishedThreadAllocatedBytes += t_Allocations.Bytes;
+            });
+        }
+
+        EventGenerator generator{ spec, 0 };
+        std::vector<std::unique_ptr<Event>> drained{};
+
+        // Events queued are all processed by the next ProcessEvents(), the loop ends once every event was queued
+        UInt64_T queued{};
+        UInt64_T frame{};
+
+        while (true) {
+            if (spec.Producers != 0 && spec.Queue == ProducerQueue::BATCHED) {
+                // Published batches are taken by ProcessEvents() itself
+                queued = publishedEvents.load();
+            }
+            else if (spec.Producers == 0) {
+                for (UInt64_T index{}, count{ GetFrameEventCount(spec, frame) }; index < count; ++index) {
+                    QueueEvent(generator.Next());
+                    ++queued;
+                }
+            }
+            else {
+                {
+                    std::scoped_lock lock{ staging.Mutex };
+                    drained.swap(staging.Events);
+                }
+
+                for (auto& event : drained) {
+                    QueueEvent(std::move(event));
+                }
+
+                queued += drained.size();
+                drained.clear();
+            }
+
+            // Subscriptions come and go while the system runs
+            for (UInt32_T index{}; index < spec.Churn; ++index) {
+                Subscribe(nextChurnId, GENERATED_TYPES[churnEngine() % GENERATED_TYPES.size()], [](Event&) -> bool { return false; });
+
+                if (nextChurnId - CHURN_SUBSCRIBER_BASE >= spec.Churn) {
+                    for (const auto type : GENERATED_TYPES) {
+                        Unsubscribe(nextChurnId - spec.Churn, type);
+                    }
+                }
+
+                ++nextChurnId;
+            }
+
+            const bool lastFrame{ queued >= totalEvents };
+
+            ProcessEvents();
+            ++frame;
+
+            if (lastFrame) {
+                break;
+            }
+        }
+
+        const auto elapsed{ std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() };
+
+        for (auto& producer : producers) {
+            producer.join();
+        }
+
+        const auto allocationsAfter{ GetAllocationCounts() };
+        const auto allocations{ allocationsAfter.Count - allocationsBefore.Count };
+
+        fmt::print("frames        {}\n", frame);
+        fmt::print("events        {} ({:.2f} M/s)\n", totalEvents, static_cast<double>(totalEvents) / elapsed / 1e6);
+        fmt::print("dispatches    {} ({:.2f} M/s)\n", stats.Dispatches, static_cast<double>(stats.Dispatches) / elapsed / 1e6);
+        fmt::print("time          {:.3f} s\n", elapsed);
+
+        if (spec.Producers != 0) {
+            fmt::print("producers     {} ({}), slowest done in {:.3f} s\n", spec.Producers, spec.Queue == ProducerQueue::BATCHED ? "batched" : "mutex",
+                       static_cast<double>(producerNanoseconds.load()) / 1e9);
+        }
+
+        PrintPercentiles(stats.Latencies);
+        fmt::print("allocations   {} ({:.2f} per event, {} bytes)\n", allocations, static_cast<double>(allocations) / static_cast<double>(std::max<UInt64_T>(totalEvents, 1)),
+                   allocationsAfter.Bytes - allocationsBefore.Bytes);
+        fmt::print("peak RSS      {:.1f} MiB\n", static_cast<double>(GetPeakResidentBytes()) / (1024.0 * 1024.0));
+
+        Shutdown();
+    }
+
+    /**
+     * Writer threads subscribe and unsubscribe their own ids while the main thread keeps
+     * dispatching. Checks every subscription survived and nothing else did
+     * */
+    static auto RunRegistry(const LoadSpec& spec) -> void {
+        using namespace EventManager;
+
+        DispatchStats stats{};
+        SubscribeHandlers(spec, stats);
+
+        std::atomic<UInt32_T> finishedWriters{};
+        std::vector<std::thread> writers{};
+
+        const auto start{ std::chrono::steady_clock::now() };
+
+        for (UInt32_T writer{}; writer < spec.Writers; ++writer) {
+            writers.emplace_back([&, writer]() -> void {
+                std::mt19937_64 engine{ spec.Seed + writer };
+                const UInt64_T firstId{ CHURN_SUBSCRIBER_BASE + writer * spec.Writes };
+
+                for (UInt64_T index{}; index < spec.Writes; ++index) {
+                    const auto type{ GENERATED_TYPES[engine() % GENERATED_TYPES.size()] };
+                    Subscribe(firstId + index, type, [](Event&) -> bool { return false; });
+
+                    // Every other subscription is kept, so the end state can be checked
+                    if (index % 2 == 1) {
+                        Unsubscribe(firstId + index, type);
+                    }
+                }
+
+                ++finishedWriters;
+            });
+        }
+
+        EventGenerator generator{ spec, 0 };
+        UInt64_T frames{};
+
+        while (finishedWriters.load() < spec.Writers) {
+            for (UInt32_T index{}; index < spec.EventsPerFrame; ++index) {
+                QueueEvent(generator.Next());
+            }
+
+            ProcessEvents();
+            ++frames;
+        }
+
+        const auto elapsed{ std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() };
+
+        for (auto& writer : writers) {
+            writer.join();
+        }
+
+        UInt64_T subscribers{};
+        UInt64_T handlers{};
+        GetSubscribers().ForEach([&](UInt64_T subId, const Handlers_T& list) -> void {
+            subscribers += subId >= CHURN_SUBSCRIBER_BASE;
+            handlers += subId >= CHURN_SUBSCRIBER_BASE ? list.size() : 0;
+        });
+
+        // The dispatch table has to agree with the registry
+        UInt64_T entries{};
+        {
+            const DispatchReadGuard guard{};
+
+            for (const auto type : GENERATED_TYPES) {
+                entries += static_cast<UInt64_T>(std::ranges::count_if(GetDispatchTable().GetHandlers(type), [](const DispatchEntry& entry) -> bool { return entry.SubscriberId >= CHURN_SUBSCRIBER_BASE; }));
+            }
+        }
+
+        const UInt64_T expected{ spec.Writers * ((spec.Writes + 1) / 2) };
+        const UInt64_T operations{ spec.Writers * (spec.Writes + spec.Writes / 2) };
+
+        fmt::print("writers       {} ({:.2f} M subscription changes/s)\n", spec.Writers, static_cast<double>(operations) / elapsed / 1e6);
+        fmt::print("dispatch      {} frames, {:.2f} M dispatches/s meanwhile\n", frames, static_cast<double>(stats.Dispatches) / elapsed / 1e6);
+        fmt::print("time          {:.3f} s\n", elapsed);
+        fmt::print("registry      {} subscribers, {} handlers, {} table entries, expected {} ({})\n", subscribers, handlers, entries, expected,
+                   subscribers == expected && handlers == expected && entries == expected ? "ok" : "MISMATCH");
+
+        Shutdown();
+    }
+
+    /**
+     * Stores the same subscribers, one to three handlers each, in the subscriber map and in
+     * the node based map with a vector per subscriber it replaced. Compares the memory each
+     * holds once filled (allocator overhead not included), and the best time out of a few rounds
+     * to visit every handler and to look every subscriber up in random order
+     * */
+    static auto RunLayout(const LoadSpec& spec) -> void {
+        using namespace EventManager;
+        using NodeSubscribers_T = std::unordered_map<UInt64_T, std::vector<HandlerPtr_T>>;
+
+        constexpr UInt32_T ROUNDS{ 5 };
+
+        std::mt19937_64 engine{ spec.Seed };
+        std::vector<UInt64_T> ids(spec.Population);
+        std::vector<UInt64_T> counts(spec.Population);
+        std::vector<HandlerPtr_T> handlers{};
+
+        for (Size_T index{}; index < ids.size(); ++index) {
+            ids[index] = engine();
+            counts[index] = 1 + engine() % 3;
+
+            for (UInt64_T count{}; count < counts[index]; ++count) {
+                handlers.push_back(std::make_shared<EventHandlerWrapper>(GENERATED_TYPES[engine() % GENERATED_TYPES.size()], [](Event&) -> bool { return false; }));
+            }
+        }
+
+        auto lookupOrder{ ids };
+        std::ranges::shuffle(lookupOrder, engine);
+
+        const auto milliseconds{ [](auto start) -> double { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(); } };
+
+        const auto measure{ [&](std::string_view name, auto& subscribers) -> void {
+            const AllocationCounts before{ t_Allocations };
+            auto start{ std::chrono::steady_clock::now() };
+
+            auto handler{ handlers.begin() };
+            for (Size_T index{}; index < ids.size(); ++index) {
+                for (UInt64_T count{}; count < counts[index]; ++count) {
+                    subscribers[ids[index]].push_back(*handler++);
+                }
+            }
+
+            const double build{ milliseconds(start) };
+            const AllocationCounts after{ t_Allocations };
+
+            double iterate{ std::numeric_limits<double>::max() };
+            double lookup{ std::numeric_limits<double>::max() };
+            UInt64_T checksum{};
+
+            for (UInt32_T round{}; round < ROUNDS; ++round) {
+                start = std::chrono::steady_clock::now();
+                for (const auto& [subId, list] : subscribers) {
+                    for (const auto& handler : list) {
+                        checksum += subId ^ reinterpret_cast<std::uintptr_t>(handler.get());
+                    }
+                }
+                iterate = std::min(iterate, milliseconds(start));
+
+                start = std::chrono::steady_clock::now();
+                for (const auto id : lookupOrder) {
+                    checksum += subscribers.find(id)->second.size();
+                }
+                lookup = std::min(lookup, milliseconds(start));
+            }
+
+            const auto population{ static_cast<double>(std::max<UInt64_T>(spec.Population, 1)) };
+
+            fmt::print("{:<14}{:>10.1f}{:>12.2f}{:>10.2f}{:>12.3f}{:>11.3f}   ({:x})\n", name,
+                       static_cast<double>(after.Live - before.Live) / population, static_cast<double>(after.Count - before.Count) / population,
+                       build, iterate, lookup, checksum);
+        } };
+
+        fmt::print("layout        {} subscribers, {} handlers\n", spec.Population, handlers.size());
+        fmt::print("{:<14}{:>10}{:>12}{:>10}{:>12}{:>11}\n", "", "bytes/sub", "allocs/sub", "build ms", "iterate ms", "lookup ms");
+
+        {
+            NodeSubscribers_T subscribers{};
+            measure("unordered_map", subscribers);
+        }
+
+        {
+            Subscribers_T subscribers{};
+            measure("flat", subscribers);
+        }
+    }
+
+    static auto RunCodec(const LoadSpec& spec) -> void {
+        EventGenerator generator{ spec, 0 };
+
+        const UInt64_T count{ spec.Frames * spec.EventsPerFrame };
+        std::vector<std::unique_ptr<Event>> events{};
+        events.reserve(count);
+
+        for (UInt64_T index{}; index < count; ++index) {
+            events.push_back(generator.Next());
+        }
+
+        const auto rate{ [&](auto start) -> double {
+            return static_cast<double>(count) / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / 1e6;
+        } };
+
+        // Fixed layout records
+        std::vector<std::byte> buffer(count * EventCodec::MAX_WIRE_SIZE);
+        Size_T size{};
+
+        auto start{ std::chrono::steady_clock::now() };
+        for (const auto& event : events) {
+            size += EventCodec::Encode(*event, std::span{ buffer }.subspan(size));
+        }
+        const double encodeRate{ rate(start) };
+
+        UInt64_T decoded{};
+        start = std::chrono::steady_clock::now();
+        for (Size_T offset{}; offset < size;) {
+            const auto* header{ EventCodec::PeekHeader(std::span{ buffer }.subspan(offset)) };
+            decoded += EventCodec::Decode(std::span{ buffer }.subspan(offset, header->GetSize())) != nullptr;
+            offset += header->GetSize();
+        }
+        const double decodeRate{ rate(start) };
+
+        fmt::print("codec         encode {:.2f} M/s  decode {:.2f} M/s  {:.2f} bytes/event ({} decoded)\n",
+                   encodeRate, decodeRate, static_cast<double>(size) / static_cast<double>(count), decoded);
+
+        // Compressed log
+        const auto path{ std::filesystem::temp_directory_path() / "Event_System_LoadGen.mktl" };
+
+        start = std::chrono::steady_clock::now();
+        {
+            EventLogWriter writer{ path };
+
+            for (const auto& event : events) {
+                (void)writer.Append(*event);
+            }
+        }
+        const double writeRate{ rate(start) };
+
+        start = std::chrono::steady_clock::now();
+        {
+            EventLogReader reader{ path };
+            while (reader.Next()) {}
+        }
+        const double readRate{ rate(start) };
+
+        fmt::print("event log     write {:.2f} M/s  read {:.2f} M/s  {:.2f} bytes/event\n",
+                   writeRate, readRate, static_cast<double>(std::filesystem::file_size(path)) / static_cast<double>(count));
+
+        std::filesystem::remove(path);
+    }
+
+    /**
+     * Appends the events of every frame to a persistent queue and commits them, as the event
+     * manager journal does once per ProcessEvents(). Flushes follow the default sync interval
+     * */
+    static auto RunQueue(const LoadSpec& spec) -> void {
+        EventGenerator generator{ spec, 0 };
+
+        std::vector<std::unique_ptr<Event>> events{};
+        events.reserve(spec.EventsPerFrame);
+
+        for (UInt32_T index{}; index < spec.EventsPerFrame; ++index) {
+            events.push_back(generator.Next());
+        }
+
+        const auto directory{ std::filesystem::temp_directory_path() / "Event_System_LoadGen.mkq" };
+        std::filesystem::remove_all(directory);
+
+        UInt64_T appended{};
+        std::chrono::steady_clock::duration appending{};
+        std::chrono::steady_clock::duration committing{};
+
+        {
+            PersistentEventQueue queue{ directory };
+
+            for (UInt64_T frame{}; frame < spec.Frames; ++frame) {
+                auto start{ std::chrono::steady_clock::now() };
+
+                for (const auto& event : events) {
+                    appended += queue.Append(*event);
+                }
+
+                auto end{ std::chrono::steady_clock::now() };
+                appending += end - start;
+
+                start = end;
+                queue.Commit(queue.GetWritePosition());
+                committing += std::chrono::steady_clock::now() - start;
+            }
+
+            fmt::print("queue         append {:.2f} M/s  with commits {:.2f} M/s  {} segments  {} recycled\n",
+                       static_cast<double>(appended) / std::chrono::duration<double>(appending).count() / 1e6,
+                       static_cast<double>(appended) / std::chrono::duration<double>(appending + committing).count() / 1e6,
+                       queue.GetSegmentCount(), queue.GetRecycledCount());
+        }
+
+        std::filesystem::remove_all(directory);
+    }
+
+    /**
+     * Runs the deterministic source through a replay session with the dispatch handlers
+     * @returns false if the run regressed against the baseline
+     * */
+    static auto RunReplay(const LoadSpec& spec) -> bool {
+        DispatchStats stats{};
+        SubscribeHandlers(spec, stats);
+
+        DeterministicEventSource source{ EventSourceSpec{ .Seed = spec.Seed, .MinEventsPerFrame = spec.EventsPerFrame, .MaxEventsPerFrame = spec.EventsPerFrame } };
+        ReplaySession session{ ReplaySpec{ .KeepRecords = false } };
+        session.Run(source, spec.Frames);
+
+        const auto result{ session.MakeBaseline() };
+        fmt::print("replay        digest {:016x}  dispatches {}  median frame {} ns\n", result.Digest, result.DispatchCount, result.MedianFrameTime.count());
+
+        if (!spec.SaveBaseline.empty()) {
+            result.Save(spec.SaveBaseline);
+        }
+
+        if (spec.Baseline.empty()) {
+            return true;
+        }
+
+        const auto baseline{ ReplayBaseline::Load(spec.Baseline) };
+        const auto comparison{ session.Compare(baseline, static_cast<double>(spec.Tolerance) / 100.0) };
+
+        fmt::print("baseline      digest {:016x}  dispatches {}  median frame {} ns\n", baseline.Digest, baseline.DispatchCount, baseline.MedianFrameTime.count());
+        fmt::print("comparison    {}  slowdown {:.3f}x  tolerance {}%  {}\n",
+                   comparison.SameTrace ? "same trace" : "trace differs", comparison.Slowdown, spec.Tolerance, comparison.Regressed ? "REGRESSED" : "ok");
+
+        return !comparison.Regressed;
+    }
+}
+
+int main(int argc, char** argv) {
+    using namespace Mikoto;
+
+    try {
+        const auto spec{ ParseArguments({ argv + 1, static_cast<Size_T>(argc - 1) }) };
+
+        if (spec.Mode == Workload::CODEC) {
+            RunCodec(spec);
+        }
+        else if (spec.Mode == Workload::REGISTRY) {
+            RunRegistry(spec);
+        }
+        else if (spec.Mode == Workload::LAYOUT) {
+            RunLayout(spec);
+        }
+        else if (spec.Mode == Workload::QUEUE) {
+            RunQueue(spec);
+        }
+        else if (spec.Mode == Workload::REPLAY) {
+            if (!RunReplay(spec)) {
+                return 2;
+            }
+        }
+        else {
+            RunDispatch(spec);
+        }
+    }
+    catch (const std::exception& exception) {
+        fmt::print(stderr, "{}\n", exception.what());
+        return 1;
+    }
+
+    return 0;
+}